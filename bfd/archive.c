@@ -884,6 +884,207 @@ bfd_generic_openr_next_archived_file (bfd *archive, bfd *last_file)
   return _bfd_get_elt_at_filepos (archive, filestart, NULL);
 }
 
+/*
+FUNCTION
+	bfd_archive_member_count
+
+SYNOPSIS
+	size_t bfd_archive_member_count (bfd *archive);
+
+DESCRIPTION
+	Return the number of elements of @var{archive}.  The first call
+	walks the element headers, without opening the elements, and
+	records where each element is, so that
+	bfd_map_over_archive_members can go straight to any of them.
+	Return <<(size_t) -1>> and set the error if the elements of
+	@var{archive} cannot be indexed this way, in which case they
+	can still be stepped through with bfd_openr_next_archived_file.
+*/
+
+size_t
+bfd_archive_member_count (bfd *archive)
+{
+  struct artdata *ardata;
+  struct ar_member *members, *n;
+  size_t count, alloc;
+  ufile_ptr filestart;
+
+  if (bfd_get_format (archive) != bfd_archive
+      || archive->direction == write_direction
+      || (archive->xvec->openr_next_archived_file
+	  != bfd_generic_openr_next_archived_file))
+    {
+      bfd_set_error (bfd_error_invalid_operation);
+      return (size_t) -1;
+    }
+
+  ardata = bfd_ardata (archive);
+  if (ardata->members_error != bfd_error_no_error)
+    return ardata->member_count;
+
+  /* Step from header to header just as
+     bfd_generic_openr_next_archived_file does.  */
+  members = NULL;
+  count = alloc = 0;
+  filestart = ardata->first_file_filepos;
+  for (;;)
+    {
+      struct areltdata *ared;
+      ufile_ptr origin, next;
+
+      if (bfd_seek (archive, filestart, SEEK_SET) != 0)
+	break;
+      ared = (struct areltdata *) _bfd_read_ar_hdr (archive);
+      if (ared == NULL)
+	break;
+      origin = next = bfd_tell (archive);
+      if (!bfd_is_thin_archive (archive))
+	{
+	  next += ared->parsed_size;
+	  next += next % 2;
+	}
+
+      if (count == alloc)
+	{
+	  alloc = alloc * 2 + 64;
+	  n = (struct ar_member *) bfd_realloc (members,
+						alloc * sizeof (*members));
+	  if (n == NULL)
+	    {
+	      free (ared);
+	      free (members);
+	      return (size_t) -1;
+	    }
+	  members = n;
+	}
+      members[count].filepos = filestart;
+      members[count].size = ared->parsed_size;
+      count++;
+      free (ared);
+
+      if (next < origin)
+	{
+	  /* Prevent looping.  See PR19256.  */
+	  bfd_set_error (bfd_error_malformed_archive);
+	  break;
+	}
+      filestart = next;
+    }
+
+  ardata->members = NULL;
+  if (count != 0)
+    {
+      ardata->members = (struct ar_member *)
+	bfd_alloc (archive, count * sizeof (*members));
+      if (ardata->members == NULL)
+	{
+	  free (members);
+	  return (size_t) -1;
+	}
+      memcpy (ardata->members, members, count * sizeof (*members));
+    }
+  free (members);
+  ardata->member_count = count;
+  ardata->members_error = bfd_get_error ();
+  if (ardata->members_error == bfd_error_no_error)
+    ardata->members_error = bfd_error_no_more_archived_files;
+  return count;
+}
+
+/*
+FUNCTION
+	bfd_archive_member_size
+
+SYNOPSIS
+	bfd_size_type bfd_archive_member_size (bfd *archive, size_t idx);
+
+DESCRIPTION
+	Return the size in octets of element @var{idx} of @var{archive},
+	as given by its header, which for a thin archive is the size of
+	the file the element refers to.  @var{archive} must have been
+	indexed by bfd_archive_member_count.
+*/
+
+bfd_size_type
+bfd_archive_member_size (bfd *archive, size_t idx)
+{
+  BFD_ASSERT (idx < bfd_ardata (archive)->member_count);
+  return bfd_ardata (archive)->members[idx].size;
+}
+
+/*
+FUNCTION
+	bfd_map_over_archive_members
+
+SYNOPSIS
+	bool bfd_map_over_archive_members
+	  (bfd *archive, size_t first, size_t end,
+	   bool (*func) (bfd *archive, bfd *member, void *data),
+	   void *data);
+
+DESCRIPTION
+	Open elements @var{first} up to but not including @var{end} of
+	@var{archive}, which must have been indexed by
+	bfd_archive_member_count, and call @var{func} on each of them
+	in turn, closing it again afterwards.  @var{func} should call
+	bfd_check_format before doing anything else with the element,
+	and must not close it.
+
+	Nothing is read from the elements before @var{first}, so
+	separate processes can visit disjoint runs of the elements at
+	once, provided that each calls bfd_cache_close_all first so
+	that they do not share the file position of @var{archive}.
+
+	Return FALSE if @var{func} returns FALSE, or with the error set
+	if an element cannot be opened.  If @var{end} is the number of
+	elements and the walk of the element headers stopped on an
+	error rather than at the end of @var{archive}, return FALSE
+	with that error set after the last element, at the same point
+	as bfd_openr_next_archived_file would.
+*/
+
+bool
+bfd_map_over_archive_members (bfd *archive, size_t first, size_t end,
+			      bool (*func) (bfd *, bfd *, void *),
+			      void *data)
+{
+  struct artdata *ardata;
+  size_t i;
+
+  if (bfd_get_format (archive) != bfd_archive
+      || bfd_ardata (archive)->members_error == bfd_error_no_error
+      || first > end
+      || end > bfd_ardata (archive)->member_count)
+    {
+      bfd_set_error (bfd_error_invalid_operation);
+      return false;
+    }
+
+  ardata = bfd_ardata (archive);
+  for (i = first; i < end; i++)
+    {
+      bfd *member;
+      bool ok;
+
+      member = _bfd_get_elt_at_filepos (archive, ardata->members[i].filepos,
+					NULL);
+      if (member == NULL)
+	return false;
+      ok = func (archive, member, data);
+      bfd_close (member);
+      if (!ok)
+	return false;
+    }
+
+  if (end == ardata->member_count
+      && ardata->members_error != bfd_error_no_more_archived_files)
+    {
+      bfd_set_error (ardata->members_error);
+      return false;
+    }
+  return true;
+}
+
 bfd *
 _bfd_noarchive_openr_next_archived_file (bfd *archive,
 					 bfd *last_file ATTRIBUTE_UNUSED)
@@ -1879,7 +2080,8 @@ hpux_uid_gid_encode (char str[6], long int id)
 /* Takes a filename, returns an arelt_data for it, or NULL if it can't
    make one.  The filename must refer to a filename in the filesystem.
    The filename field of the ar_hdr will NOT be initialized.  If member
-   is set, and it's an in-memory bfd, we fake it.  */
+   is set, and it's an in-memory bfd, we fake it, keeping its
+   modification time and mode if they were set.  */
 
 static struct areltdata *
 bfd_ar_hdr_from_filesystem (bfd *abfd, const char *filename, bfd *member)
@@ -1893,10 +2095,16 @@ bfd_ar_hdr_from_filesystem (bfd *abfd, const char *filename, bfd *member)
     {
       /* Assume we just "made" the member, and fake it.  */
       struct bfd_in_memory *bim = (struct bfd_in_memory *) member->iostream;
-      time (&status.st_mtime);
+      if (member->mtime_set)
+	status.st_mtime = member->mtime;
+      else
+	time (&status.st_mtime);
       status.st_uid = getuid ();
       status.st_gid = getgid ();
-      status.st_mode = 0644;
+      if (member->mode_set)
+	status.st_mode = member->mode;
+      else
+	status.st_mode = 0644;
       status.st_size = bim->size;
     }
   else if (stat (filename, &status) != 0)
@@ -2127,6 +2335,46 @@ _bfd_noarchive_truncate_arname (bfd *abfd ATTRIBUTE_UNUSED,
 {
 }
 
+#define AR_WRITE_BUFFERSIZE (8 * 1024 * 1024)
+
+/* Write the header and contents of CURRENT to ARCH, using BUFFER of
+   AR_WRITE_BUFFERSIZE bytes for the copy.  */
+
+static bool
+write_archive_element (bfd *arch, bfd *current, char *buffer)
+{
+  bfd_size_type remaining = arelt_size (current);
+
+  /* Write ar header.  */
+  if (!_bfd_write_ar_hdr (arch, current))
+    return false;
+  if (bfd_is_thin_archive (arch))
+    return true;
+  if (bfd_seek (current, 0, SEEK_SET) != 0)
+    return false;
+
+  while (remaining)
+    {
+      size_t amt = AR_WRITE_BUFFERSIZE;
+
+      if (amt > remaining)
+	amt = remaining;
+      errno = 0;
+      if (bfd_read (buffer, amt, current) != amt)
+	return false;
+      if (bfd_write (buffer, amt, arch) != amt)
+	return false;
+      remaining -= amt;
+    }
+
+  if ((arelt_size (current) % 2) == 1)
+    {
+      if (bfd_write (&ARFMAG[1], 1, arch) != 1)
+	return false;
+    }
+  return true;
+}
+
 /* The BFD is open for write and has its format set to bfd_archive.  */
 
 bool
@@ -2223,8 +2471,6 @@ _bfd_write_archive_contents (bfd *arch)
 	}
     }
 
-#define AR_WRITE_BUFFERSIZE (8 * 1024 * 1024)
-
   /* FIXME: Find a way to test link_info.reduce_memory_overheads
      and change the buffer size.  */
   buffer = bfd_malloc (AR_WRITE_BUFFERSIZE);
@@ -2234,37 +2480,8 @@ _bfd_write_archive_contents (bfd *arch)
   for (current = arch->archive_head;
        current != NULL;
        current = current->archive_next)
-    {
-      bfd_size_type remaining = arelt_size (current);
-
-      /* Write ar header.  */
-      if (!_bfd_write_ar_hdr (arch, current))
-	goto input_err;
-      if (bfd_is_thin_archive (arch))
-	continue;
-      if (bfd_seek (current, 0, SEEK_SET) != 0)
-	goto input_err;
-
-      while (remaining)
-	{
-	  size_t amt = AR_WRITE_BUFFERSIZE;
-
-	  if (amt > remaining)
-	    amt = remaining;
-	  errno = 0;
-	  if (bfd_read (buffer, amt, current) != amt)
-	    goto input_err;
-	  if (bfd_write (buffer, amt, arch) != amt)
-	    goto input_err;
-	  remaining -= amt;
-	}
-
-      if ((arelt_size (current) % 2) == 1)
-	{
-	  if (bfd_write (&ARFMAG[1], 1, arch) != 1)
-	    goto input_err;
-	}
-    }
+    if (!write_archive_element (arch, current, buffer))
+      goto input_err;
 
   free (buffer);
 
@@ -2294,7 +2511,320 @@ _bfd_write_archive_contents (bfd *arch)
   free (buffer);
   return false;
 }
+
+#ifdef HAVE_FTRUNCATE
+/* Cut the file NAME back to SIZE bytes, after a failed attempt to
+   append to it, keeping the error and errno that attempt set.  */
+
+static void
+archive_truncate (const char *name, ufile_ptr size)
+{
+  bfd_error_type err = bfd_get_error ();
+  int saved_errno = errno;
+  FILE *f = _bfd_real_fopen (name, FOPEN_RUB);
+
+  if (f != NULL)
+    {
+      if (ftruncate (fileno (f), size) != 0)
+	_bfd_error_handler (_("%s: cannot remove partly appended members"),
+			    name);
+      fclose (f);
+    }
+  bfd_set_error (err);
+  errno = saved_errno;
+}
+#endif
+
+/*
+FUNCTION
+	bfd_archive_append_in_place
+
+SYNOPSIS
+	bool bfd_archive_append_in_place (bfd *arch, bfd *new_members);
+
+DESCRIPTION
+	Add @var{new_members}, a chain of BFDs open for input linked by
+	their <<archive_next>> fields, to the end of @var{arch}, an
+	archive open for input, by writing their headers and contents
+	after the elements already in the file rather than writing the
+	whole archive out again.  The headers are made as they would be
+	for an archive open for output with the flags of @var{arch}.
+
+	This can only be done if @var{arch} has no symbol map, is not a
+	thin archive, ends just after its last element, and the names
+	of the new members fit in their headers, so that the result is
+	the same as writing out the whole archive without a symbol map.
+	Otherwise return FALSE with the error set to
+	<<bfd_error_invalid_operation>>, leaving the file as it was.
+	Return FALSE with some other error set if writing fails, after
+	cutting the file back to the elements it had where the host
+	can do that.
+	@var{arch} should be closed afterwards without reading more
+	from it.
+*/
+
+bool
+bfd_archive_append_in_place (bfd *arch, bfd *new_members)
+{
+  bfd *current, *obfd, *head;
+  size_t count;
+  ufile_ptr end;
+  char *etable = NULL;
+  bfd_size_type elength = 0;
+  const char *ename = NULL;
+  char *buffer;
+  bool ok;
+
+  if (bfd_get_format (arch) != bfd_archive
+      || arch->direction != read_direction
+      || (arch->flags & BFD_IN_MEMORY) != 0
+      || bfd_has_map (arch)
+      || bfd_is_thin_archive (arch)
+      || (arch->xvec->_bfd_write_contents[bfd_archive]
+	  != _bfd_write_archive_contents))
+    goto cannot_append;
+
+  /* Find where the last element ends.  */
+  count = bfd_archive_member_count (arch);
+  if (count == (size_t) -1
+      || bfd_ardata (arch)->members_error != bfd_error_no_more_archived_files)
+    goto cannot_append;
+  end = bfd_ardata (arch)->first_file_filepos;
+  if (count != 0)
+    {
+      struct areltdata *ared;
+
+      if (bfd_seek (arch, bfd_ardata (arch)->members[count - 1].filepos,
+		    SEEK_SET) != 0)
+	return false;
+      ared = (struct areltdata *) _bfd_read_ar_hdr (arch);
+      if (ared == NULL)
+	return false;
+      end = bfd_tell (arch) + ared->parsed_size;
+      end += end % 2;
+      free (ared);
+    }
+  if (end != bfd_get_file_size (arch))
+    goto cannot_append;
+
+  for (current = new_members; current != NULL; current = current->archive_next)
+    if (bfd_write_p (current) || current->arelt_data != NULL)
+      goto cannot_append;
+
+  for (current = new_members; current != NULL; current = current->archive_next)
+    {
+      current->arelt_data =
+	bfd_ar_hdr_from_filesystem (arch, bfd_get_filename (current),
+				    current);
+      if (current->arelt_data == NULL)
+	goto reset;
+      BFD_SEND (arch, _bfd_truncate_arname,
+		(arch, bfd_get_filename (current),
+		 (char *) arch_hdr (current)));
+    }
+
+  /* A name too long for the header would need a new extended name
+     table before the existing elements.  */
+  head = arch->archive_head;
+  arch->archive_head = new_members;
+  ok = BFD_SEND (arch, _bfd_construct_extended_name_table,
+		 (arch, &etable, &elength, &ename));
+  arch->archive_head = head;
+  if (!ok)
+    goto reset;
+  if (elength != 0)
+    {
+      bfd_set_error (bfd_error_invalid_operation);
+      goto reset;
+    }
+
+  obfd = bfd_fopen (bfd_get_filename (arch), arch->xvec->name, FOPEN_RUB, -1);
+  if (obfd == NULL)
+    return false;
+  buffer = bfd_malloc (AR_WRITE_BUFFERSIZE);
+  ok = (buffer != NULL
+	&& bfd_seek (obfd, end, SEEK_SET) == 0);
+  for (current = new_members;
+       ok && current != NULL;
+       current = current->archive_next)
+    ok = write_archive_element (obfd, current, buffer);
+  free (buffer);
+  if (!bfd_close_all_done (obfd))
+    ok = false;
+#ifdef HAVE_FTRUNCATE
+  if (!ok)
+    archive_truncate (bfd_get_filename (arch), end);
+#endif
+  return ok;
+
+ cannot_append:
+  bfd_set_error (bfd_error_invalid_operation);
+  return false;
+
+ reset:
+  for (current = new_members; current != NULL; current = current->archive_next)
+    {
+      free (current->arelt_data);
+      current->arelt_data = NULL;
+    }
+  return false;
+}
 
+/* Add NAME, a symbol defined by element ABFD, to the *ORL_COUNT
+   entries of the symbol map *MAP being built for ARCH, which has room
+   for *ORL_MAX of them.  */
+
+static bool
+add_armap_symbol (bfd *arch, bfd *abfd, const char *name,
+		  struct orl **map, unsigned int *orl_max,
+		  unsigned int *orl_count, int *stridx)
+{
+  bfd_size_type namelen;
+  struct orl *new_map;
+  size_t amt;
+
+  if (*orl_count == *orl_max)
+    {
+      *orl_max *= 2;
+      amt = *orl_max * sizeof (struct orl);
+      new_map = (struct orl *) bfd_realloc (*map, amt);
+      if (new_map == NULL)
+	return false;
+
+      *map = new_map;
+    }
+
+  namelen = strlen (name);
+  amt = sizeof (char *);
+  (*map)[*orl_count].name = (char **) bfd_alloc (arch, amt);
+  if ((*map)[*orl_count].name == NULL)
+    return false;
+  *((*map)[*orl_count].name) = (char *) bfd_alloc (arch, namelen + 1);
+  if (*((*map)[*orl_count].name) == NULL)
+    return false;
+  strcpy (*((*map)[*orl_count].name), name);
+  (*map)[*orl_count].u.abfd = abfd;
+  (*map)[*orl_count].namidx = *stridx;
+
+  *stridx += namelen + 1;
+  ++*orl_count;
+  return true;
+}
+
+/* The symbols in the symbol map of an archive open for input, ordered
+   by the file position of the element each belongs to, and then by
+   their order in the map.  */
+
+struct armap_index
+{
+  bfd *arch;
+  struct armap_index_entry
+  {
+    file_ptr file_offset;
+    symindex sym;
+  } *entries;
+  symindex count;
+};
+
+static int
+armap_index_compare (const void *a, const void *b)
+{
+  const struct armap_index_entry *ea = (const struct armap_index_entry *) a;
+  const struct armap_index_entry *eb = (const struct armap_index_entry *) b;
+
+  if (ea->file_offset != eb->file_offset)
+    return ea->file_offset < eb->file_offset ? -1 : 1;
+  if (ea->sym != eb->sym)
+    return ea->sym < eb->sym ? -1 : 1;
+  return 0;
+}
+
+/* Add to MAP the symbols that the symbol map of the archive ABFD was
+   read from lists for it, setting up INDEX for that archive first if
+   need be.  Return FALSE with *FAILED clear if there is no such symbol
+   map to take them from, or with *FAILED set on running out of
+   memory.  */
+
+static bool
+reuse_armap_symbols (bfd *arch, bfd *abfd, struct armap_index *index,
+		     struct orl **map, unsigned int *orl_max,
+		     unsigned int *orl_count, int *stridx, bool *failed)
+{
+  bfd *src = abfd->my_archive;
+  struct artdata *ardata;
+  file_ptr key;
+  symindex lo, hi;
+
+  *failed = false;
+  if (src == NULL
+      || bfd_is_thin_archive (src)
+      || !bfd_has_map (src)
+      || abfd->arelt_data == NULL
+      || (key = arch_eltdata (abfd)->key) == 0)
+    return false;
+
+  ardata = bfd_ardata (src);
+  if (index->arch != src)
+    {
+      symindex i;
+
+      free (index->entries);
+      index->arch = NULL;
+      index->count = 0;
+      index->entries = NULL;
+      if (ardata->symdef_count != 0)
+	{
+	  size_t amt;
+
+	  if (_bfd_mul_overflow (ardata->symdef_count,
+				 sizeof (*index->entries), &amt))
+	    {
+	      bfd_set_error (bfd_error_no_memory);
+	      *failed = true;
+	      return false;
+	    }
+	  index->entries = (struct armap_index_entry *) bfd_malloc (amt);
+	  if (index->entries == NULL)
+	    {
+	      *failed = true;
+	      return false;
+	    }
+	  for (i = 0; i < ardata->symdef_count; i++)
+	    {
+	      index->entries[i].file_offset = ardata->symdefs[i].file_offset;
+	      index->entries[i].sym = i;
+	    }
+	  qsort (index->entries, ardata->symdef_count,
+		 sizeof (*index->entries), armap_index_compare);
+	}
+      index->arch = src;
+      index->count = ardata->symdef_count;
+    }
+
+  /* Find the first symbol of ABFD.  */
+  lo = 0;
+  hi = index->count;
+  while (lo < hi)
+    {
+      symindex mid = lo + (hi - lo) / 2;
+
+      if (index->entries[mid].file_offset < key)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  for (; lo < index->count && index->entries[lo].file_offset == key; lo++)
+    if (!add_armap_symbol (arch, abfd,
+			   ardata->symdefs[index->entries[lo].sym].name,
+			   map, orl_max, orl_count, stridx))
+      {
+	*failed = true;
+	return false;
+      }
+  return true;
+}
+
 /* Note that the namidx for the first symbol is 0.  */
 
 bool
@@ -2309,6 +2839,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   int stridx = 0;
   asymbol **syms = NULL;
   long syms_max = 0;
+  struct armap_index index = { NULL, NULL, 0 };
   bool ret;
   size_t amt;
   static bool report_plugin_err = true;
@@ -2339,6 +2870,20 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
        current != NULL;
        current = current->archive_next, elt_no++)
     {
+      /* If asked to, take the symbols of an element copied from another
+	 archive from that archive's symbol map, rather than reading
+	 the element's own symbols.  */
+      if ((arch->flags & BFD_ARCHIVE_REUSE_ARMAP) != 0)
+	{
+	  bool failed;
+
+	  if (reuse_armap_symbols (arch, current, &index, &map, &orl_max,
+				   &orl_count, &stridx, &failed))
+	    continue;
+	  if (failed)
+	    goto error_return;
+	}
+
       if (bfd_check_format (current, bfd_object)
 	  && (bfd_get_file_flags (current) & HAS_SYMS) != 0)
 	{
@@ -2386,21 +2931,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
 		       || bfd_is_com_section (sec))
 		      && ! bfd_is_und_section (sec))
 		    {
-		      bfd_size_type namelen;
-		      struct orl *new_map;
-
 		      /* This symbol will go into the archive header.  */
-		      if (orl_count == orl_max)
-			{
-			  orl_max *= 2;
-			  amt = orl_max * sizeof (struct orl);
-			  new_map = (struct orl *) bfd_realloc (map, amt);
-			  if (new_map == NULL)
-			    goto error_return;
-
-			  map = new_map;
-			}
-
 		      if (syms[src_count]->name != NULL
 			  && syms[src_count]->name[0] == '_'
 			  && syms[src_count]->name[1] == '_'
@@ -2414,21 +2945,11 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
 			    (_("%pB: plugin needed to handle lto object"),
 			     current);
 			}
-		      namelen = strlen (syms[src_count]->name);
-		      amt = sizeof (char *);
-		      map[orl_count].name = (char **) bfd_alloc (arch, amt);
-		      if (map[orl_count].name == NULL)
-			goto error_return;
-		      *(map[orl_count].name) = (char *) bfd_alloc (arch,
-								   namelen + 1);
-		      if (*(map[orl_count].name) == NULL)
+		      if (!add_armap_symbol (arch, current,
+					     syms[src_count]->name,
+					     &map, &orl_max, &orl_count,
+					     &stridx))
 			goto error_return;
-		      strcpy (*(map[orl_count].name), syms[src_count]->name);
-		      map[orl_count].u.abfd = current;
-		      map[orl_count].namidx = stridx;
-
-		      stridx += namelen + 1;
-		      ++orl_count;
 		    }
 		}
 	    }
@@ -2444,6 +2965,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   ret = BFD_SEND (arch, write_armap,
 		  (arch, elength, map, orl_count, stridx));
 
+  free (index.entries);
   free (syms);
   free (map);
   if (first_name != NULL)
@@ -2452,6 +2974,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   return ret;
 
  error_return:
+  free (index.entries);
   free (syms);
   free (map);
   if (first_name != NULL)
@@ -134,6 +134,7 @@ typedef uint8_t bfd_byte;
 typedef struct bfd bfd;
 struct bfd_link_info;
 struct bfd_link_hash_entry;
+struct bfd_parallel_work;
 typedef struct bfd_section *sec_ptr;
 typedef struct reloc_cache_entry arelent;
 struct orl;
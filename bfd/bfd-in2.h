@@ -142,6 +142,7 @@ typedef uint8_t bfd_byte;
 typedef struct bfd bfd;
 struct bfd_link_info;
 struct bfd_link_hash_entry;
+struct bfd_parallel_work;
 typedef struct bfd_section *sec_ptr;
 typedef struct reloc_cache_entry arelent;
 struct orl;
@@ -322,6 +323,12 @@ void bfd_putl16 (bfd_vma, void *);
 uint64_t bfd_get_bits (const void *, int, bool);
 void bfd_put_bits (uint64_t, void *, int, bool);
 
+struct bfd_parallel_work *bfd_parallel_start
+   (unsigned int /*threads*/, size_t /*count*/,
+    void (*/*fn*/) (void *, size_t), void */*data*/);
+
+void bfd_parallel_finish (struct bfd_parallel_work */*work*/);
+
 /* Extracted from hash.c.  */
 /* An element in the hash table.  Most uses will actually use a larger
    structure, and an instance of this will be the first field.  */
@@ -363,6 +370,11 @@ struct bfd_hash_table
   unsigned int entsize;
   /* If non-zero, don't grow the hash table.  */
   unsigned int frozen:1;
+  /* For a table created by bfd_hash_table_init_open, the keys of the
+     slots in TABLE: zero for an empty slot, otherwise derived from
+     the hash code of the entry in the slot.  NULL for a table which
+     chains entries from TABLE.  */
+  unsigned int *keys;
 };
 
 bool bfd_hash_table_init_n
@@ -371,6 +383,12 @@ bool bfd_hash_table_init_n
        (struct bfd_hash_entry *, struct bfd_hash_table *, const char *),
     unsigned int /*entsize*/, unsigned int /*size*/);
 
+bool bfd_hash_table_init_open
+   (struct bfd_hash_table *,
+    struct bfd_hash_entry *(* /*newfunc*/)
+       (struct bfd_hash_entry *, struct bfd_hash_table *, const char *),
+    unsigned int /*entsize*/);
+
 bool bfd_hash_table_init
    (struct bfd_hash_table *,
     struct bfd_hash_entry *(* /*newfunc*/)
@@ -1076,6 +1094,12 @@ bool bfd_get_section_contents
 bool bfd_malloc_and_get_section
    (bfd *abfd, asection *section, bfd_byte **buf);
 
+bool bfd_get_section_view
+   (bfd *abfd, asection *section, const bfd_byte **view,
+    bfd_size_type *size);
+
+bool bfd_release_section_view (bfd *abfd, const void *view);
+
 bool bfd_copy_private_section_data
    (bfd *ibfd, asection *isec, bfd *obfd, asection *osec);
 
@@ -1320,6 +1344,17 @@ bool bfd_set_archive_head (bfd *output, bfd *new_head);
 
 bfd *bfd_openr_next_archived_file (bfd *archive, bfd *previous);
 
+size_t bfd_archive_member_count (bfd *archive);
+
+bfd_size_type bfd_archive_member_size (bfd *archive, size_t idx);
+
+bool bfd_map_over_archive_members
+   (bfd *archive, size_t first, size_t end,
+    bool (*func) (bfd *archive, bfd *member, void *data),
+    void *data);
+
+bool bfd_archive_append_in_place (bfd *arch, bfd *new_members);
+
 /* Extracted from archures.c.  */
 enum bfd_architecture
 {
@@ -1973,6 +2008,9 @@ struct bfd
   /* File modified time, if mtime_set is TRUE.  */
   long mtime;
 
+  /* File mode, if mode_set is TRUE.  */
+  unsigned int mode;
+
   /* A unique identifier of the BFD  */
   unsigned int id;
 
@@ -2074,6 +2112,10 @@ struct bfd
   /* Don't generate ELF section header.  */
 #define BFD_NO_SECTION_HEADER  0x800000
 
+  /* Take the archive symbol map entries of elements copied from
+     another archive from the symbol map of that archive.  */
+#define BFD_ARCHIVE_REUSE_ARMAP 0x1000000
+
   /* Flags bits which are for BFD use only.  */
 #define BFD_FLAGS_FOR_BFD_USE_MASK \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
@@ -2117,6 +2159,10 @@ struct bfd
      getting it from the file each time.  */
   unsigned int mtime_set : 1;
 
+  /* Set if the mode to give an in-memory BFD as an archive element
+     has been set in mode.  */
+  unsigned int mode_set : 1;
+
   /* Flag set if symbols from this BFD should not be exported.  */
   unsigned int no_export : 1;
 
@@ -2277,6 +2323,10 @@ struct bfd
 
   /* For input BFDs, the build ID, if the object has one. */
   const struct bfd_build_id *build_id;
+
+  /* Section contents handed out by bfd_get_section_view and not yet
+     released.  */
+  struct bfd_section_view *section_views;
 };
 
 static inline const char *
@@ -2732,6 +2782,8 @@ bfd_vma bfd_emul_get_commonpagesize (const char *);
 
 char *bfd_demangle (bfd *, const char *, int);
 
+void bfd_set_dwarf2_index_cache (const char *);
+
 /* Extracted from bfdio.c.  */
 bfd_size_type bfd_read (void *, bfd_size_type, bfd *)
 ATTRIBUTE_WARN_UNUSED_RESULT;
@@ -2845,6 +2897,8 @@ bfd_get_compression_algorithm (const char *name);
 const char *bfd_get_compression_algorithm_name
    (enum compressed_debug_section_type type);
 
+void bfd_set_compression_threads (unsigned int threads);
+
 void bfd_update_compression_header
    (bfd *abfd, bfd_byte *contents, asection *sec);
 
@@ -3001,6 +3055,8 @@ bfd *bfd_openr_iovec (const char *filename, const char *target,
 
 bfd *bfd_openw (const char *filename, const char *target);
 
+bfd *bfd_openw_memory (const char *filename, const char *target);
+
 bfd *bfd_elf_bfd_from_remote_memory
    (bfd *templ, bfd_vma ehdr_vma, bfd_size_type size, bfd_vma *loadbasep,
     int (*target_read_memory)
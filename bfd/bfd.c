@@ -101,6 +101,9 @@ CODE_FRAGMENT
 .  {* File modified time, if mtime_set is TRUE.  *}
 .  long mtime;
 .
+.  {* File mode, if mode_set is TRUE.  *}
+.  unsigned int mode;
+.
 .  {* A unique identifier of the BFD  *}
 .  unsigned int id;
 .
@@ -203,6 +206,10 @@ CODE_FRAGMENT
 .  {* Don't generate ELF section header.  *}
 .#define BFD_NO_SECTION_HEADER	0x800000
 .
+.  {* Take the archive symbol map entries of elements copied from
+.     another archive from the symbol map of that archive.  *}
+.#define BFD_ARCHIVE_REUSE_ARMAP 0x1000000
+.
 .  {* Flags bits which are for BFD use only.  *}
 .#define BFD_FLAGS_FOR_BFD_USE_MASK \
 .  (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
@@ -246,6 +253,10 @@ CODE_FRAGMENT
 .     getting it from the file each time.  *}
 .  unsigned int mtime_set : 1;
 .
+.  {* Set if the mode to give an in-memory BFD as an archive element
+.     has been set in mode.  *}
+.  unsigned int mode_set : 1;
+.
 .  {* Flag set if symbols from this BFD should not be exported.  *}
 .  unsigned int no_export : 1;
 .
@@ -406,6 +417,10 @@ CODE_FRAGMENT
 .
 .  {* For input BFDs, the build ID, if the object has one. *}
 .  const struct bfd_build_id *build_id;
+.
+.  {* Section contents handed out by bfd_get_section_view and not yet
+.     released.  *}
+.  struct bfd_section_view *section_views;
 .};
 .
 
@@ -1835,6 +1850,8 @@ SYNOPSIS
 
 DESCRIPTION
 	Set the flag word in the BFD @var{abfd} to the value @var{flags}.
+	<<BFD_IN_MEMORY>> is kept as it was, since it describes where
+	the BFD is written rather than the file.
 
 	Possible errors are:
 	o <<bfd_error_wrong_format>> - The target bfd was not of object format.
@@ -1861,7 +1878,7 @@ bfd_set_file_flags (bfd *abfd, flagword flags)
       return false;
     }
 
-  abfd->flags = flags;
+  abfd->flags = flags | (abfd->flags & BFD_IN_MEMORY);
   if ((flags & bfd_applicable_file_flags (abfd)) != flags)
     {
       bfd_set_error (bfd_error_invalid_operation);
@@ -2728,6 +2745,33 @@ bfd_demangle (bfd *abfd, const char *name, int options)
   return res;
 }
 
+/*
+FUNCTION
+	bfd_set_dwarf2_index_cache
+
+SYNOPSIS
+	void bfd_set_dwarf2_index_cache (const char *);
+
+DESCRIPTION
+	Set the directory in which to keep indexes from addresses to
+	DWARF compilation units, for line number lookups in executables
+	and shared libraries with a build ID, or NULL, the default, not
+	to keep them.  The first lookup in a file without an index in
+	the directory reads all the file's debug information and saves
+	an index, named after the build ID; the first lookup in a file
+	with one reads the index, and from then on only the compilation
+	units that lookups need.  The string must not be changed after
+	it is passed to this function.
+*/
+
+const char *_bfd_dwarf2_index_cache_dir;
+
+void
+bfd_set_dwarf2_index_cache (const char *dir)
+{
+  _bfd_dwarf2_index_cache_dir = dir;
+}
+
 /* Get the linker information.  */
 
 struct bfd_link_info *
@@ -661,3 +661,52 @@ bfd_open_file (bfd *abfd)
 
   return (FILE *) abfd->iostream;
 }
+
+/*
+INTERNAL_FUNCTION
+	_bfd_cache_dup_fd
+
+SYNOPSIS
+	int _bfd_cache_dup_fd (bfd *abfd, ufile_ptr *origin);
+
+DESCRIPTION
+	Return a new file descriptor for the file holding @var{abfd},
+	which may be an archive element, and set @var{origin} to the
+	offset of @var{abfd} within that file.  The descriptor stays
+	valid when the cache closes the file, so it may be used to read
+	from the file with pread in other threads.  The caller must
+	close it.  Return -1 if @var{abfd} is not read from a file
+	managed by the cache, or if the system does not provide pread.
+*/
+
+int
+_bfd_cache_dup_fd (bfd *abfd, ufile_ptr *origin)
+{
+#if defined (HAVE_PREAD) && defined (HAVE_FILENO)
+  ufile_ptr offset = 0;
+  FILE *f;
+
+  while (abfd->my_archive != NULL
+	 && !bfd_is_thin_archive (abfd->my_archive))
+    {
+      offset += abfd->origin;
+      abfd = abfd->my_archive;
+    }
+  offset += abfd->origin;
+
+  if (abfd->iovec != &cache_iovec
+      || (abfd->flags & BFD_IN_MEMORY) != 0)
+    return -1;
+
+  f = bfd_cache_lookup (abfd, CACHE_NO_SEEK_ERROR);
+  if (f == NULL)
+    return -1;
+
+  *origin = offset;
+  return dup (fileno (f));
+#else
+  (void) abfd;
+  (void) origin;
+  return -1;
+#endif
+}
@@ -133,6 +133,265 @@ bfd_get_compression_algorithm_name (enum compressed_debug_section_type type)
   return NULL;
 }
 
+/* The number of threads to use for sections compressed with zstd, or
+   0 for one per online processor.  */
+static unsigned int compression_threads = 1;
+
+/*
+FUNCTION
+	bfd_set_compression_threads
+
+SYNOPSIS
+	void bfd_set_compression_threads (unsigned int threads);
+
+DESCRIPTION
+	Use up to @var{threads} threads to compress and decompress
+	sections with zstd.  Zero means one thread per online
+	processor.  The default is one thread, so programs have to
+	ask for more.  Sections larger than a few megabytes are
+	compressed with zstd as independent frames followed by a seek
+	table, in the zstd seekable format, so that the frames can be
+	compressed and decompressed in parallel.  Any zstd decoder
+	can read such a section, as the seek table is a skippable
+	frame.  The same threads compress the debugging sections of
+	a file, with zlib or zstd, several at a time.
+*/
+
+void
+bfd_set_compression_threads (unsigned int threads)
+{
+  compression_threads = threads;
+}
+
+/* The number of threads set by bfd_set_compression_threads.  */
+
+static unsigned int
+get_compression_threads (void)
+{
+  long count = compression_threads;
+
+#ifdef _SC_NPROCESSORS_ONLN
+  if (count == 0)
+    count = sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+  return count > 1 ? count : 1;
+}
+
+#ifdef HAVE_ZSTD
+
+/* Sections compressed with zstd are split into frames of this many
+   uncompressed bytes.  zstd's default window at the default level is
+   this size, so little is lost by starting each frame afresh.  */
+#define ZSTD_FRAME_SIZE (2 * 1024 * 1024)
+
+/* The zstd seekable format: a skippable frame, with its magic number
+   and size, holding a compressed and a decompressed size for each
+   frame, optionally followed by a checksum, then the number of frames,
+   a descriptor byte and another magic number.  All little endian.  */
+#define ZSTD_SKIPPABLE_MAGIC 0x184d2a5e
+#define ZSTD_SEEKABLE_MAGIC 0x8f92eab1
+#define ZSTD_SEEK_FOOTER_SIZE 9
+#define ZSTD_SEEK_CHECKSUM_FLAG 0x80
+#define ZSTD_SEEK_RESERVED_BITS 0x7c
+
+/* Frames of zstd data being compressed or decompressed in parallel.
+   Frame I is at IN + IN_OFF[I] and OUT + OUT_OFF[I], and ends where
+   frame I + 1 starts.  RESULT[I] is the size of the output of frame I,
+   or an error code.  */
+
+struct zstd_frames
+{
+  const bfd_byte *in;
+  bfd_byte *out;
+  size_t *in_off;
+  size_t *out_off;
+  size_t *result;
+};
+
+/* The space needed by zstd_compress_frames for SIZE bytes.  */
+
+static size_t
+zstd_frames_bound (size_t size)
+{
+  size_t count;
+
+  if (size <= ZSTD_FRAME_SIZE)
+    return ZSTD_compressBound (size);
+  count = (size + ZSTD_FRAME_SIZE - 1) / ZSTD_FRAME_SIZE;
+  return (count * (ZSTD_compressBound (ZSTD_FRAME_SIZE) + 8)
+	  + 8 + ZSTD_SEEK_FOOTER_SIZE);
+}
+
+static void
+zstd_compress_frame (void *data, size_t i)
+{
+  struct zstd_frames *f = (struct zstd_frames *) data;
+
+  f->result[i] = ZSTD_compress (f->out + f->out_off[i],
+				f->out_off[i + 1] - f->out_off[i],
+				f->in + f->in_off[i],
+				f->in_off[i + 1] - f->in_off[i],
+				ZSTD_CLEVEL_DEFAULT);
+}
+
+static void
+zstd_decompress_frame (void *data, size_t i)
+{
+  struct zstd_frames *f = (struct zstd_frames *) data;
+
+  f->result[i] = ZSTD_decompress (f->out + f->out_off[i],
+				  f->out_off[i + 1] - f->out_off[i],
+				  f->in + f->in_off[i],
+				  f->in_off[i + 1] - f->in_off[i]);
+}
+
+/* Allocate the offset and result arrays of F for COUNT frames.  */
+
+static bool
+zstd_frames_alloc (struct zstd_frames *f, size_t count)
+{
+  f->in_off = (size_t *) bfd_malloc ((3 * count + 2) * sizeof (size_t));
+  if (f->in_off == NULL)
+    return false;
+  f->out_off = f->in_off + count + 1;
+  f->result = f->out_off + count + 1;
+  return true;
+}
+
+/* Compress IN_SIZE bytes at IN with zstd into OUT, which has room for
+   zstd_frames_bound (IN_SIZE) bytes.  Return the compressed size, or
+   zero on failure.  */
+
+static size_t
+zstd_compress_frames (bfd_byte *out, size_t out_size,
+		      const bfd_byte *in, size_t in_size)
+{
+  struct zstd_frames f;
+  size_t count, bound, i, pos;
+  bfd_byte *p;
+
+  if (in_size <= ZSTD_FRAME_SIZE)
+    {
+      pos = ZSTD_compress (out, out_size, in, in_size, ZSTD_CLEVEL_DEFAULT);
+      return ZSTD_isError (pos) ? 0 : pos;
+    }
+
+  count = (in_size + ZSTD_FRAME_SIZE - 1) / ZSTD_FRAME_SIZE;
+  if (count > 0xffffffff || !zstd_frames_alloc (&f, count))
+    return 0;
+
+  /* Compress each frame into a slot big enough for any outcome, then
+     close up the gaps.  */
+  bound = ZSTD_compressBound (ZSTD_FRAME_SIZE);
+  for (i = 0; i <= count; i++)
+    {
+      f.in_off[i] = i < count ? i * ZSTD_FRAME_SIZE : in_size;
+      f.out_off[i] = i * bound;
+    }
+  f.in = in;
+  f.out = out;
+  _bfd_parallel_for (get_compression_threads (), count,
+		     zstd_compress_frame, &f);
+
+  pos = 0;
+  for (i = 0; i < count; i++)
+    {
+      if (ZSTD_isError (f.result[i]))
+	{
+	  free (f.in_off);
+	  return 0;
+	}
+      memmove (out + pos, out + f.out_off[i], f.result[i]);
+      pos += f.result[i];
+    }
+
+  p = out + pos;
+  bfd_putl32 (ZSTD_SKIPPABLE_MAGIC, p);
+  bfd_putl32 (count * 8 + ZSTD_SEEK_FOOTER_SIZE, p + 4);
+  p += 8;
+  for (i = 0; i < count; i++)
+    {
+      bfd_putl32 (f.result[i], p);
+      bfd_putl32 (f.in_off[i + 1] - f.in_off[i], p + 4);
+      p += 8;
+    }
+  bfd_putl32 (count, p);
+  p[4] = 0;
+  bfd_putl32 (ZSTD_SEEKABLE_MAGIC, p + 5);
+  p += ZSTD_SEEK_FOOTER_SIZE;
+
+  free (f.in_off);
+  return p - out;
+}
+
+/* Decompress IN_SIZE bytes of zstd data at IN into OUT_SIZE bytes at
+   OUT in parallel, if the data ends with a seek table which describes
+   it exactly.  Return 1 on success, 0 on failure, or -1 if the data
+   has no such seek table or is a single frame.  */
+
+static int
+zstd_decompress_frames (const bfd_byte *in, size_t in_size,
+			bfd_byte *out, size_t out_size)
+{
+  struct zstd_frames f;
+  const bfd_byte *p;
+  size_t count, entsize, table_size, i;
+  unsigned int threads = get_compression_threads ();
+
+  if (threads <= 1
+      || in_size < 8 + ZSTD_SEEK_FOOTER_SIZE
+      || bfd_getl32 (in + in_size - 4) != ZSTD_SEEKABLE_MAGIC)
+    return -1;
+
+  p = in + in_size - ZSTD_SEEK_FOOTER_SIZE;
+  count = bfd_getl32 (p);
+  if ((p[4] & ZSTD_SEEK_RESERVED_BITS) != 0 || count <= 1)
+    return -1;
+  entsize = (p[4] & ZSTD_SEEK_CHECKSUM_FLAG) != 0 ? 12 : 8;
+  table_size = count * entsize + ZSTD_SEEK_FOOTER_SIZE;
+  if (table_size / entsize < count
+      || table_size > in_size - 8
+      || bfd_getl32 (in + in_size - table_size - 8) != ZSTD_SKIPPABLE_MAGIC
+      || bfd_getl32 (in + in_size - table_size - 4) != table_size)
+    return -1;
+
+  if (!zstd_frames_alloc (&f, count))
+    return 0;
+
+  /* The frames must add up to the data before the seek table, and
+     to the size of the output.  */
+  p = in + in_size - table_size;
+  f.in_off[0] = 0;
+  f.out_off[0] = 0;
+  for (i = 0; i < count; i++, p += entsize)
+    {
+      f.in_off[i + 1] = f.in_off[i] + bfd_getl32 (p);
+      f.out_off[i + 1] = f.out_off[i] + bfd_getl32 (p + 4);
+      if (f.in_off[i + 1] > in_size - table_size - 8
+	  || f.out_off[i + 1] > out_size)
+	break;
+    }
+  if (i < count
+      || f.in_off[count] != in_size - table_size - 8
+      || f.out_off[count] != out_size)
+    {
+      free (f.in_off);
+      return -1;
+    }
+
+  f.in = in;
+  f.out = out;
+  _bfd_parallel_for (threads, count, zstd_decompress_frame, &f);
+
+  for (i = 0; i < count; i++)
+    if (ZSTD_isError (f.result[i])
+	|| f.result[i] != f.out_off[i + 1] - f.out_off[i])
+      break;
+  free (f.in_off);
+  return i == count;
+}
+#endif /* HAVE_ZSTD */
+
 /*
 FUNCTION
 	bfd_update_compression_header
@@ -511,6 +770,12 @@ decompress_contents (bool is_zstd, bfd_byte *compressed_buffer,
   if (is_zstd)
     {
 #ifdef HAVE_ZSTD
+      int res = zstd_decompress_frames (compressed_buffer, compressed_size,
+					uncompressed_buffer,
+					uncompressed_size);
+      if (res >= 0)
+	return res;
+
       size_t ret = ZSTD_decompress (uncompressed_buffer, uncompressed_size,
 				    compressed_buffer, compressed_size);
       return !ZSTD_isError (ret);
@@ -553,15 +818,32 @@ decompress_contents (bool is_zstd, bfd_byte *compressed_buffer,
   return inflateEnd (&strm) == Z_OK && rc == Z_OK && strm.avail_out == 0;
 }
 
-/* Compress section contents using zlib/zstd and store
-   as the contents field.  This function assumes the contents
-   field was allocated using bfd_malloc() or equivalent.
+/* A section being compressed.  INPUT holds UNCOMPRESSED_SIZE bytes to
+   be compressed into BUFFER after a header of HEADER_SIZE bytes.
+   COMPRESSED_SIZE is the room in BUFFER, and then the size of the
+   compressed section including its header, or zero if compressing
+   failed.  When UPDATE is set, the contents were already compressed
+   and have just been moved into BUFFER.  */
 
-   Return the uncompressed size if the full section contents is
-   compressed successfully.  Otherwise return 0.  */
+struct compress_job
+{
+  asection *sec;
+  bfd_byte *input;
+  bfd_byte *buffer;
+  bfd_size_type uncompressed_size;
+  bfd_size_type compressed_size;
+  int header_size;
+  bool zstd;
+  bool update;
+};
 
-static bfd_size_type
-bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
+/* Set up JOB to compress the contents of SEC, uncompressing them first
+   if they are already compressed in another way.  This function
+   assumes the contents field was allocated using bfd_malloc() or
+   equivalent.  Return false on failure.  */
+
+static bool
+compress_section_start (bfd *abfd, sec_ptr sec, struct compress_job *job)
 {
   bfd_byte *input_buffer;
   uLong compressed_size;
@@ -610,7 +892,7 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
 	  buffer_size = uncompressed_size;
 	  buffer = bfd_malloc (buffer_size);
 	  if (buffer == NULL)
-	    return 0;
+	    return false;
 
 	  if (!decompress_contents (ch_type == ch_compress_zstd,
 				    input_buffer + orig_header_size,
@@ -618,7 +900,7 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
 	    {
 	      bfd_set_error (bfd_error_bad_value);
 	      free (buffer);
-	      return 0;
+	      return false;
 	    }
 	  free (input_buffer);
 	  bfd_set_section_alignment (sec, uncompressed_alignment_pow);
@@ -631,12 +913,20 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
     }
 
   if (!update)
-    compressed_size = compressBound (uncompressed_size) + new_header_size;
+    {
+#if HAVE_ZSTD
+      if (abfd->flags & BFD_COMPRESS_ZSTD)
+	compressed_size = zstd_frames_bound (uncompressed_size);
+      else
+#endif
+	compressed_size = compressBound (uncompressed_size);
+      compressed_size += new_header_size;
+    }
 
   buffer_size = compressed_size;
   buffer = bfd_alloc (abfd, buffer_size);
   if (buffer == NULL)
-    return 0;
+    return false;
 
   if (update)
     {
@@ -645,40 +935,69 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
 		input_buffer + orig_header_size,
 		zlib_size);
     }
-  else
+
+  job->sec = sec;
+  job->input = input_buffer;
+  job->buffer = buffer;
+  job->uncompressed_size = uncompressed_size;
+  job->compressed_size = compressed_size;
+  job->header_size = new_header_size;
+  job->zstd = (abfd->flags & BFD_COMPRESS_ZSTD) != 0;
+  job->update = update;
+  return true;
+}
+
+/* Compress the input of JOB into its buffer.  This doesn't call any
+   BFD function, so that sections can be compressed in parallel.  */
+
+static void
+compress_section_data (struct compress_job *job)
+{
+  uLong compressed_size = job->compressed_size - job->header_size;
+
+  if (job->update)
+    return;
+
+  if (job->zstd)
     {
-      if (abfd->flags & BFD_COMPRESS_ZSTD)
-	{
 #if HAVE_ZSTD
-	  compressed_size = ZSTD_compress (buffer + new_header_size,
-					   compressed_size,
-					   input_buffer,
-					   uncompressed_size,
-					   ZSTD_CLEVEL_DEFAULT);
-	  if (ZSTD_isError (compressed_size))
-	    {
-	      bfd_release (abfd, buffer);
-	      bfd_set_error (bfd_error_bad_value);
-	      return 0;
-	    }
+      compressed_size = zstd_compress_frames (job->buffer + job->header_size,
+					      compressed_size, job->input,
+					      job->uncompressed_size);
+      job->compressed_size = (compressed_size == 0
+			      ? 0 : compressed_size + job->header_size);
 #endif
-	}
-      else if (compress ((Bytef *) buffer + new_header_size, &compressed_size,
-			 (const Bytef *) input_buffer, uncompressed_size)
-	       != Z_OK)
-	{
-	  bfd_release (abfd, buffer);
-	  bfd_set_error (bfd_error_bad_value);
-	  return 0;
-	}
+    }
+  else if (compress ((Bytef *) job->buffer + job->header_size,
+		     &compressed_size, (const Bytef *) job->input,
+		     job->uncompressed_size) != Z_OK)
+    job->compressed_size = 0;
+  else
+    job->compressed_size = compressed_size + job->header_size;
+}
 
-      compressed_size += new_header_size;
+/* Finish the section compressed by JOB, storing the compressed data as
+   its contents.  Return the uncompressed size if the full section
+   contents is compressed successfully.  Otherwise return 0.  */
+
+static bfd_size_type
+compress_section_finish (bfd *abfd, struct compress_job *job)
+{
+  asection *sec = job->sec;
+  bfd_size_type compressed_size = job->compressed_size;
+  bfd_size_type uncompressed_size = job->uncompressed_size;
+
+  if (compressed_size == 0)
+    {
+      bfd_release (abfd, job->buffer);
+      bfd_set_error (bfd_error_bad_value);
+      return 0;
     }
 
   /* If compression didn't make the section smaller, keep it uncompressed.  */
   if (compressed_size >= uncompressed_size)
     {
-      memcpy (buffer, input_buffer, uncompressed_size);
+      memcpy (job->buffer, job->input, uncompressed_size);
       if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
 	elf_section_flags (sec) &= ~SHF_COMPRESSED;
       sec->compress_status = COMPRESS_SECTION_NONE;
@@ -686,16 +1005,34 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
   else
     {
       sec->size = uncompressed_size;
-      bfd_update_compression_header (abfd, buffer, sec);
+      bfd_update_compression_header (abfd, job->buffer, sec);
       sec->size = compressed_size;
       sec->compress_status = COMPRESS_SECTION_DONE;
     }
-  sec->contents = buffer;
+  sec->contents = job->buffer;
   sec->flags |= SEC_IN_MEMORY;
-  free (input_buffer);
+  free (job->input);
   return uncompressed_size;
 }
 
+/* Compress section contents using zlib/zstd and store
+   as the contents field.  This function assumes the contents
+   field was allocated using bfd_malloc() or equivalent.
+
+   Return the uncompressed size if the full section contents is
+   compressed successfully.  Otherwise return 0.  */
+
+static bfd_size_type
+bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
+{
+  struct compress_job job;
+
+  if (!compress_section_start (abfd, sec, &job))
+    return 0;
+  compress_section_data (&job);
+  return compress_section_finish (abfd, &job);
+}
+
 /*
 FUNCTION
 	bfd_get_full_section_contents
@@ -1038,24 +1375,11 @@ bfd_init_section_decompress_status (bfd *abfd, sec_ptr sec)
   return true;
 }
 
-/*
-FUNCTION
-	bfd_init_section_compress_status
-
-SYNOPSIS
-	bool bfd_init_section_compress_status
-	  (bfd *abfd, asection *section);
-
-DESCRIPTION
-	If open for read, compress section, update section size with
-	compressed size and set compress_status to COMPRESS_SECTION_DONE.
-
-	Return @code{FALSE} if the section is not a valid compressed
-	section.  Otherwise, return @code{TRUE}.
-*/
+/* Read the contents of SEC of ABFD, which is open for read, into
+   *BUFFER to be compressed.  */
 
-bool
-bfd_init_section_compress_status (bfd *abfd, sec_ptr sec)
+static bool
+read_section_to_compress (bfd *abfd, sec_ptr sec, bfd_byte **buffer)
 {
   bfd_size_type uncompressed_size;
   bfd_byte *uncompressed_buffer;
@@ -1072,7 +1396,7 @@ bfd_init_section_compress_status (bfd *abfd, sec_ptr sec)
       return false;
     }
 
-  /* Read in the full section contents and compress it.  */
+  /* Read in the full section contents.  */
   uncompressed_size = sec->size;
   uncompressed_buffer = (bfd_byte *) bfd_malloc (uncompressed_size);
   /* PR 21431 */
@@ -1086,6 +1410,35 @@ bfd_init_section_compress_status (bfd *abfd, sec_ptr sec)
       return false;
     }
 
+  *buffer = uncompressed_buffer;
+  return true;
+}
+
+/*
+FUNCTION
+	bfd_init_section_compress_status
+
+SYNOPSIS
+	bool bfd_init_section_compress_status
+	  (bfd *abfd, asection *section);
+
+DESCRIPTION
+	If open for read, compress section, update section size with
+	compressed size and set compress_status to COMPRESS_SECTION_DONE.
+
+	Return @code{FALSE} if the section is not a valid compressed
+	section.  Otherwise, return @code{TRUE}.
+*/
+
+bool
+bfd_init_section_compress_status (bfd *abfd, sec_ptr sec)
+{
+  bfd_byte *uncompressed_buffer;
+
+  /* Read in the full section contents and compress it.  */
+  if (!read_section_to_compress (abfd, sec, &uncompressed_buffer))
+    return false;
+
   sec->contents = uncompressed_buffer;
   if (bfd_compress_section_contents (abfd, sec) == 0)
     {
@@ -1112,14 +1465,15 @@ DESCRIPTION
 	@code{TRUE}.  UNCOMPRESSED_BUFFER is freed in both cases.
 */
 
-bool
-bfd_compress_section (bfd *abfd, sec_ptr sec, bfd_byte *uncompressed_buffer)
-{
-  bfd_size_type uncompressed_size = sec->size;
+/* Check that SEC of ABFD can be compressed by bfd_compress_section
+   from UNCOMPRESSED_BUFFER.  */
 
+static bool
+compress_section_ok (bfd *abfd, sec_ptr sec, bfd_byte *uncompressed_buffer)
+{
   /* Error if not opened for write.  */
   if (abfd->direction != write_direction
-      || uncompressed_size == 0
+      || sec->size == 0
       || uncompressed_buffer == NULL
       || sec->contents != NULL
       || sec->compressed_size != 0
@@ -1128,6 +1482,14 @@ bfd_compress_section (bfd *abfd, sec_ptr sec, bfd_byte *uncompressed_buffer)
       bfd_set_error (bfd_error_invalid_operation);
       return false;
     }
+  return true;
+}
+
+bool
+bfd_compress_section (bfd *abfd, sec_ptr sec, bfd_byte *uncompressed_buffer)
+{
+  if (!compress_section_ok (abfd, sec, uncompressed_buffer))
+    return false;
 
   sec->contents = uncompressed_buffer;
   if (bfd_compress_section_contents (abfd, sec) == 0)
@@ -1138,3 +1500,161 @@ bfd_compress_section (bfd *abfd, sec_ptr sec, bfd_byte *uncompressed_buffer)
     }
   return true;
 }
+
+/* Whether JOB compresses its input with zstd as several frames, which
+   are compressed in parallel themselves.  */
+
+static bool
+compress_job_in_frames (const struct compress_job *job ATTRIBUTE_UNUSED)
+{
+#ifdef HAVE_ZSTD
+  return job->zstd && !job->update && job->uncompressed_size > ZSTD_FRAME_SIZE;
+#else
+  return false;
+#endif
+}
+
+/* The sections being compressed by compress_sections.  */
+
+struct compress_jobs
+{
+  struct compress_job *jobs;
+  size_t *index;
+};
+
+static void
+compress_one_job (void *data, size_t i)
+{
+  struct compress_jobs *cj = (struct compress_jobs *) data;
+
+  compress_section_data (&cj->jobs[cj->index[i]]);
+}
+
+/* Compress the COUNT SECTIONS of ABFD, whose contents are in the
+   malloc'd BUFFERS, as bfd_compress_section_contents would.
+   Compressing each section is independent of the others, so that is
+   shared out among the threads set by bfd_set_compression_threads,
+   leaving sections compressed as zstd frames, which use all the
+   threads themselves, to be done one at a time.  Return the index of
+   the first section which could not be compressed, or COUNT if all of
+   them were.  The BUFFERS of the sections not compressed are freed.  */
+
+static size_t
+compress_sections (bfd *abfd, size_t count, asection **sections,
+		   bfd_byte **buffers)
+{
+  struct compress_jobs cj;
+  size_t i, started, nparallel;
+
+  cj.jobs = (struct compress_job *) bfd_malloc (count * (sizeof (*cj.jobs)
+							 + sizeof (size_t)));
+  if (cj.jobs == NULL)
+    {
+      for (i = 0; i < count; i++)
+	free (buffers[i]);
+      return 0;
+    }
+  cj.index = (size_t *) (cj.jobs + count);
+
+  /* Everything but the compression itself calls BFD functions, so must
+     be done in this thread.  */
+  for (started = 0; started < count; started++)
+    {
+      asection *sec = sections[started];
+
+      sec->contents = buffers[started];
+      if (!compress_section_start (abfd, sec, &cj.jobs[started]))
+	{
+	  free (sec->contents);
+	  sec->contents = NULL;
+	  for (i = 0; i < started; i++)
+	    {
+	      free (cj.jobs[i].input);
+	      cj.jobs[i].sec->contents = NULL;
+	    }
+	  for (i = started + 1; i < count; i++)
+	    free (buffers[i]);
+	  free (cj.jobs);
+	  return started;
+	}
+    }
+
+  nparallel = 0;
+  for (i = 0; i < count; i++)
+    if (compress_job_in_frames (&cj.jobs[i]))
+      compress_section_data (&cj.jobs[i]);
+    else
+      cj.index[nparallel++] = i;
+  _bfd_parallel_for (nparallel > 1 ? get_compression_threads () : 1,
+		     nparallel, compress_one_job, &cj);
+
+  for (started = 0; started < count; started++)
+    if (compress_section_finish (abfd, &cj.jobs[started]) == 0)
+      {
+	for (i = started; i < count; i++)
+	  {
+	    free (cj.jobs[i].input);
+	    cj.jobs[i].sec->contents = NULL;
+	  }
+	break;
+      }
+
+  free (cj.jobs);
+  return started;
+}
+
+/* Compress the COUNT SECTIONS of ABFD, which is open for write, with
+   their contents in BUFFERS, as bfd_compress_section would, but in
+   parallel.  Return false if any section fails to compress, in which
+   case the BUFFERS of the sections not compressed are freed.  */
+
+bool
+_bfd_compress_sections (bfd *abfd, size_t count, asection **sections,
+			bfd_byte **buffers)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    if (!compress_section_ok (abfd, sections[i], buffers[i]))
+      {
+	for (i = 0; i < count; i++)
+	  free (buffers[i]);
+	return false;
+      }
+
+  return compress_sections (abfd, count, sections, buffers) == count;
+}
+
+/* Compress the COUNT SECTIONS of ABFD, which is open for read, as
+   bfd_init_section_compress_status would, but in parallel.  Return
+   the index of the first section which could not be compressed, or
+   COUNT if all of them were.  */
+
+size_t
+_bfd_init_sections_compress_status (bfd *abfd, size_t count,
+				    asection **sections)
+{
+  bfd_byte **buffers;
+  size_t i, done;
+
+  if (count == 1)
+    return bfd_init_section_compress_status (abfd, sections[0]) ? 1 : 0;
+
+  buffers = (bfd_byte **) bfd_malloc (count * sizeof (*buffers));
+  if (buffers == NULL)
+    return 0;
+
+  for (i = 0; i < count; i++)
+    if (!read_section_to_compress (abfd, sections[i], &buffers[i]))
+      {
+	done = i;
+	while (i-- > 0)
+	  free (buffers[i]);
+	free (buffers);
+	return done;
+      }
+
+  done = compress_sections (abfd, count, sections, buffers);
+  free (buffers);
+  return done;
+}
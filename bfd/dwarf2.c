@@ -85,78 +85,61 @@ struct adjusted_section
   bfd_vma orig_vma;
 };
 
-/* A trie to map quickly from address range to compilation unit.
-
-   This is a fairly standard radix-256 trie, used to quickly locate which
-   compilation unit any given address belongs to.  Given that each compilation
-   unit may register hundreds of very small and unaligned ranges (which may
-   potentially overlap, due to inlining and other concerns), and a large
-   program may end up containing hundreds of thousands of such ranges, we cannot
-   scan through them linearly without undue slowdown.
-
-   We use a hybrid trie to avoid memory explosion: There are two types of trie
-   nodes, leaves and interior nodes.  (Almost all nodes are leaves, so they
-   take up the bulk of the memory usage.) Leaves contain a simple array of
-   ranges (high/low address) and which compilation unit contains those ranges,
-   and when we get to a leaf, we scan through it linearly.  Interior nodes
-   contain pointers to 256 other nodes, keyed by the next byte of the address.
-   So for a 64-bit address like 0x1234567abcd, we would start at the root and go
-   down child[0x00]->child[0x00]->child[0x01]->child[0x23]->child[0x45] etc.,
-   until we hit a leaf.  (Nodes are, in general, leaves until they exceed the
-   default allocation of 16 elements, at which point they are converted to
-   interior node if possible.) This gives us near-constant lookup times;
-   the only thing that can be costly is if there are lots of overlapping ranges
-   within a single 256-byte segment of the binary, in which case we have to
-   scan through them all to find the best match.
-
-   For a binary with few ranges, we will in practice only have a single leaf
-   node at the root, containing a simple array.  Thus, the scheme is efficient
-   for both small and large binaries.
- */
-
-/* Experiments have shown 16 to be a memory-efficient default leaf size.
-   The only case where a leaf will hold more memory than this, is at the
-   bottomost level (covering 256 bytes in the binary), where we'll expand
-   the leaf to be able to hold more ranges if needed.
- */
-#define TRIE_LEAF_SIZE 16
-
-/* All trie_node pointers will really be trie_leaf or trie_interior,
-   but they have this common head.  */
-struct trie_node
-{
-  /* If zero, we are an interior node.
-     Otherwise, how many ranges we have room for in this leaf.  */
-  unsigned int num_room_in_leaf;
-};
-
-struct trie_leaf
+/* An index to map quickly from address range to compilation unit.
+
+   Each compilation unit may register hundreds of very small and
+   unaligned ranges (which may potentially overlap, due to inlining and
+   other concerns), and a large program may end up containing hundreds
+   of thousands of such ranges, so we cannot scan through them linearly
+   without undue slowdown.  Instead the ranges are kept in an array
+   sorted by start address, with touching or overlapping ranges of one
+   unit merged, which takes a binary search to look up and little more
+   memory than the ranges themselves.
+
+   A range which overlaps lots of the ranges after it (a unit covering
+   the whole text section, say) would make every lookup scan a long way
+   back from the range it finds, so such ranges are moved to a short
+   list of their own which is scanned in full.  Every other range ends
+   before the start of the UNIT_INDEX_SPAN'th range after it, so a
+   lookup only has to look at that many ranges.
+
+   Ranges are added as compilation units are read and their line tables
+   decoded, mostly in the middle of lookups, so new ranges are put on an
+   unsorted pending list, and merged into the sorted array only once the
+   pending list gets long compared to the array.  */
+
+#define UNIT_INDEX_SPAN 16
+
+struct unit_range
 {
-  struct trie_node head;
-  unsigned int num_stored_in_leaf;
-  struct {
-    struct comp_unit *unit;
-    bfd_vma low_pc, high_pc;
-  } ranges[];
+  bfd_vma low_pc;
+  bfd_vma high_pc;
+  /* The compilation unit, or in an index read from a file saved by
+     save_unit_index, the start of the unit in .debug_info.  */
+  void *unit;
 };
 
-struct trie_interior
+struct unit_index
 {
-  struct trie_node head;
-  struct trie_node *children[256];
+  /* Ranges sorted by LOW_PC.  */
+  struct unit_range *sorted;
+  size_t num_sorted;
+
+  /* Ranges which overlap UNIT_INDEX_SPAN or more ranges after them,
+     sorted by LOW_PC.  */
+  struct unit_range *wide;
+  size_t num_wide;
+
+  /* Ranges added since SORTED was built, in no particular order.  */
+  struct unit_range *pending;
+  size_t num_pending;
+  size_t pending_alloc;
+
+  /* The units found by the last unit_index_find.  */
+  void **found;
+  size_t found_alloc;
 };
 
-static struct trie_node *alloc_trie_leaf (bfd *abfd)
-{
-  struct trie_leaf *leaf;
-  size_t amt = sizeof (*leaf) + TRIE_LEAF_SIZE * sizeof (leaf->ranges[0]);
-  leaf = bfd_zalloc (abfd, amt);
-  if (leaf == NULL)
-    return NULL;
-  leaf->head.num_room_in_leaf = TRIE_LEAF_SIZE;
-  return &leaf->head;
-}
-
 struct addr_range
 {
   bfd_byte *start;
@@ -277,8 +260,22 @@ struct dwarf2_debug_file
   /* Hash table to map offsets to decoded abbrevs.  */
   htab_t abbrev_offsets;
 
-  /* Root of a trie to map addresses to compilation units.  */
-  struct trie_node *trie_root;
+  /* Index to map addresses to compilation units.  */
+  struct unit_index unit_index;
+
+  /* An index of all the compilation units read from the file saved by
+     save_unit_index, if SAVED_INDEX_LOADED.  */
+  struct unit_index saved_index;
+  bool saved_index_loaded;
+
+  /* True once we have looked for a saved index.  */
+  bool saved_index_checked;
+
+  /* True if stash_comp_unit_at has read units beyond INFO_PTR.  */
+  bool read_out_of_order;
+
+  /* True if reading the unit at INFO_PTR failed.  */
+  bool read_failed;
 
   /* Splay tree to map info_ptr address to compilation units.  */
   splay_tree comp_unit_tree;
@@ -356,7 +353,7 @@ struct comp_unit
   struct comp_unit *next_unit;
 
   /* Chain the previously read compilation units that have no ranges yet.
-     We scan these separately when we have a trie over the ranges.
+     We scan these separately when we have an index over the ranges.
      Unused if arange.high != 0. */
   struct comp_unit *next_unit_without_ranges;
 
@@ -437,10 +434,6 @@ struct comp_unit
   /* TRUE if symbols are cached in hash table for faster lookup by name.  */
   bool cached;
 
-  /* Used when iterating over trie leaves to know which units we have
-     already seen in this iteration.  */
-  bool mark;
-
  /* Base address of debug_addr section.  */
   size_t dwarf_addr_offset;
 
@@ -674,8 +667,11 @@ lookup_info_hash_table (struct info_hash_table *hash_table, const char *key)
 /* Read a section into its appropriate place in the dwarf2_debug
    struct (indicated by SECTION_BUFFER and SECTION_SIZE).  If SYMS is
    not NULL, use bfd_simple_get_relocated_section_contents to read the
-   section contents, otherwise use bfd_get_section_contents.  Fail if
-   the located section does not contain at least OFFSET bytes.  */
+   section contents, otherwise use bfd_get_section_contents.  A
+   section which needs no relocation is not copied: SECTION_BUFFER is
+   set to a view of it from bfd_get_section_view, unless it is a string
+   section whose last byte is not a NUL.  Fail if the located section
+   does not contain at least OFFSET bytes.  */
 
 static bool
 read_section (bfd *abfd,
@@ -725,6 +721,32 @@ read_section (bfd *abfd,
 	}
       amt = bfd_get_section_limit_octets (abfd, msec);
       *section_size = amt;
+
+      if (amt != 0
+	  && (syms == NULL
+	      || (abfd->flags & (HAS_RELOC | EXEC_P | DYNAMIC)) != HAS_RELOC
+	      || (msec->flags & SEC_RELOC) == 0))
+	{
+	  const bfd_byte *view;
+	  bfd_size_type view_size;
+
+	  if (!bfd_get_section_view (abfd, msec, &view, &view_size))
+	    return false;
+	  /* Strings are read up to their NUL, so a string section
+	     must end with one.  */
+	  if (view != NULL
+	      && view_size == amt
+	      && (view[amt - 1] == 0
+		  || (strcmp (sec->uncompressed_name, ".debug_str") != 0
+		      && strcmp (sec->uncompressed_name,
+				 ".debug_line_str") != 0)))
+	    {
+	      *section_buffer = (bfd_byte *) view;
+	      goto check_offset;
+	    }
+	  bfd_release_section_view (abfd, view);
+	}
+
       /* Paranoia - alloc one extra so that we can make sure a string
 	 section is NUL terminated.  */
       amt += 1;
@@ -749,6 +771,8 @@ read_section (bfd *abfd,
       *section_buffer = contents;
     }
 
+ check_offset:
+
   /* It is possible to get a bad value for the offset into the section
      that the client wants.  Validate it here to avoid trouble later.  */
   if (offset != 0 && offset >= *section_size)
@@ -2100,9 +2124,6 @@ concat_filename (struct line_info_table *table, unsigned int file)
   return strdup (filename);
 }
 
-/* Number of bits in a bfd_vma.  */
-#define VMA_BITS (8 * sizeof (bfd_vma))
-
 /* Check whether [low1, high1) can be combined with [low2, high2),
    i.e., they touch or overlap.  */
 
@@ -2134,157 +2155,312 @@ ranges_overlap (bfd_vma low1,
   return low2 <= high1;
 }
 
-/* Insert an address range in the trie mapping addresses to compilation units.
-   Will return the new trie node (usually the same as is being sent in, but
-   in case of a leaf-to-interior conversion, or expansion of a leaf, it may be
-   different), or NULL on failure.  */
-
-static struct trie_node *
-insert_arange_in_trie (bfd *abfd,
-		       struct trie_node *trie,
-		       bfd_vma trie_pc,
-		       unsigned int trie_pc_bits,
-		       struct comp_unit *unit,
-		       bfd_vma low_pc,
-		       bfd_vma high_pc)
-{
-  bfd_vma clamped_low_pc, clamped_high_pc;
-  int ch, from_ch, to_ch;
-  bool is_full_leaf = false;
-
-  /* See if we can extend any of the existing ranges.  This merging
-     isn't perfect (if merging opens up the possibility of merging two existing
-     ranges, we won't find them), but it takes the majority of the cases.  */
-  if (trie->num_room_in_leaf > 0)
-    {
-      struct trie_leaf *leaf = (struct trie_leaf *) trie;
-      unsigned int i;
-
-      for (i = 0; i < leaf->num_stored_in_leaf; ++i)
+/* Return the number of the N ranges at R, sorted by LOW_PC, which start
+   at or below ADDR.  */
+
+static size_t
+unit_ranges_upto (const struct unit_range *r, size_t n, bfd_vma addr)
+{
+  size_t lo = 0, hi = n;
+
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if (r[mid].low_pc <= addr)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return lo;
+}
+
+/* Add the range [LOW_PC, HIGH_PC) of UNIT to IDX.  Return FALSE if
+   we run out of memory.  */
+
+static bool
+unit_index_add (struct unit_index *idx, void *unit,
+		bfd_vma low_pc, bfd_vma high_pc)
+{
+  struct unit_range *r;
+  size_t i, n;
+
+  /* See if we can extend the range added last.  This merging isn't
+     perfect, but it takes the majority of the cases, since the ranges
+     of a unit tend to be added in address order.  */
+  if (idx->num_pending != 0)
+    {
+      r = &idx->pending[idx->num_pending - 1];
+      if (r->unit == unit
+	  && ranges_overlap (low_pc, high_pc, r->low_pc, r->high_pc))
 	{
-	  if (leaf->ranges[i].unit == unit
-	      && ranges_overlap (low_pc, high_pc,
-				 leaf->ranges[i].low_pc,
-				 leaf->ranges[i].high_pc))
-	    {
-	      if (low_pc < leaf->ranges[i].low_pc)
-		leaf->ranges[i].low_pc = low_pc;
-	      if (high_pc > leaf->ranges[i].high_pc)
-		leaf->ranges[i].high_pc = high_pc;
-	      return trie;
-	    }
+	  if (low_pc < r->low_pc)
+	    r->low_pc = low_pc;
+	  if (high_pc > r->high_pc)
+	    r->high_pc = high_pc;
+	  return true;
 	}
+    }
 
-      is_full_leaf = leaf->num_stored_in_leaf == trie->num_room_in_leaf;
+  /* Don't bother with a range the sorted ranges already cover, as they
+     do for most functions and line sequences once their unit's ranges
+     are in.  */
+  n = unit_ranges_upto (idx->sorted, idx->num_sorted, low_pc);
+  for (i = n; i > 0 && i + UNIT_INDEX_SPAN > n; i--)
+    {
+      r = &idx->sorted[i - 1];
+      if (r->unit == unit && r->high_pc >= high_pc)
+	return true;
     }
 
-  /* If we're a leaf with no more room and we're _not_ at the bottom,
-     convert to an interior node.  */
-  if (is_full_leaf && trie_pc_bits < VMA_BITS)
+  if (idx->num_pending == idx->pending_alloc)
     {
-      const struct trie_leaf *leaf = (struct trie_leaf *) trie;
-      unsigned int i;
+      size_t alloc = idx->pending_alloc * 2 + 64;
 
-      trie = bfd_zalloc (abfd, sizeof (struct trie_interior));
-      if (!trie)
-	return NULL;
-      is_full_leaf = false;
+      r = bfd_realloc (idx->pending, alloc * sizeof (*r));
+      if (r == NULL)
+	return false;
+      idx->pending = r;
+      idx->pending_alloc = alloc;
+    }
 
-      /* TODO: If we wanted to save a little more memory at the cost of
-	 complexity, we could have reused the old leaf node as one of the
-	 children of the new interior node, instead of throwing it away.  */
-      for (i = 0; i < leaf->num_stored_in_leaf; ++i)
-        {
-	  if (!insert_arange_in_trie (abfd, trie, trie_pc, trie_pc_bits,
-				      leaf->ranges[i].unit, leaf->ranges[i].low_pc,
-				      leaf->ranges[i].high_pc))
-	    return NULL;
+  r = &idx->pending[idx->num_pending++];
+  r->low_pc = low_pc;
+  r->high_pc = high_pc;
+  r->unit = unit;
+  return true;
+}
+
+/* Merge the NA ranges at A and the NB ranges at B, each sorted by
+   LOW_PC, into OUT, putting ranges from A first where ranges start at
+   the same address.  */
+
+static void
+merge_unit_ranges (const struct unit_range *a, size_t na,
+		   const struct unit_range *b, size_t nb,
+		   struct unit_range *out)
+{
+  while (na != 0 && nb != 0)
+    {
+      if (b->low_pc < a->low_pc)
+	{
+	  *out++ = *b++;
+	  nb--;
+	}
+      else
+	{
+	  *out++ = *a++;
+	  na--;
 	}
     }
+  if (na != 0)
+    memcpy (out, a, na * sizeof (*a));
+  if (nb != 0)
+    memcpy (out + na, b, nb * sizeof (*b));
+}
+
+/* Sort the N ranges at R by LOW_PC, keeping ranges which start at the
+   same address in their original order.  TMP has room for N ranges.
+   Return whichever of R and TMP holds the result.  */
 
-  /* If we're a leaf with no more room and we _are_ at the bottom,
-     we have no choice but to just make it larger. */
-  if (is_full_leaf)
+static struct unit_range *
+sort_unit_ranges (struct unit_range *r, struct unit_range *tmp, size_t n)
+{
+  size_t width, i, j, k;
+
+  /* Insertion sort runs of eight ranges, then merge the runs.  */
+  for (i = 0; i < n; i += 8)
     {
-      const struct trie_leaf *leaf = (struct trie_leaf *) trie;
-      unsigned int new_room_in_leaf = trie->num_room_in_leaf * 2;
-      struct trie_leaf *new_leaf;
-      size_t amt = sizeof (*leaf) + new_room_in_leaf * sizeof (leaf->ranges[0]);
-      new_leaf = bfd_zalloc (abfd, amt);
-      new_leaf->head.num_room_in_leaf = new_room_in_leaf;
-      new_leaf->num_stored_in_leaf = leaf->num_stored_in_leaf;
+      size_t end = n - i < 8 ? n : i + 8;
 
-      memcpy (new_leaf->ranges,
-	      leaf->ranges,
-	      leaf->num_stored_in_leaf * sizeof (leaf->ranges[0]));
-      trie = &new_leaf->head;
-      is_full_leaf = false;
+      for (j = i + 1; j < end; j++)
+	{
+	  struct unit_range x = r[j];
 
-      /* Now the insert below will go through.  */
+	  for (k = j; k > i && r[k - 1].low_pc > x.low_pc; k--)
+	    r[k] = r[k - 1];
+	  r[k] = x;
+	}
     }
 
-  /* If we're a leaf (now with room), we can just insert at the end.  */
-  if (trie->num_room_in_leaf > 0)
+  for (width = 8; width < n; width *= 2)
     {
-      struct trie_leaf *leaf = (struct trie_leaf *) trie;
+      struct unit_range *t;
 
-      unsigned int i = leaf->num_stored_in_leaf++;
-      leaf->ranges[i].unit = unit;
-      leaf->ranges[i].low_pc = low_pc;
-      leaf->ranges[i].high_pc = high_pc;
-      return trie;
+      for (i = 0; i < n; i += 2 * width)
+	{
+	  size_t mid = n - i < width ? n : i + width;
+	  size_t end = n - mid < width ? n : mid + width;
+
+	  merge_unit_ranges (r + i, mid - i, r + mid, end - mid, tmp + i);
+	}
+      t = r;
+      r = tmp;
+      tmp = t;
     }
+  return r;
+}
+
+/* Merge the pending ranges of IDX into its sorted ranges.  Return
+   FALSE, leaving IDX as it was, if we run out of memory.  */
+
+static bool
+unit_index_flush (struct unit_index *idx)
+{
+  size_t num_old = idx->num_sorted + idx->num_wide;
+  size_t num_pending = idx->num_pending;
+  size_t n = num_old + num_pending;
+  struct unit_range *all, *tmp, *pending, *wide;
+  size_t i, j, k, num_wide;
+
+  if (num_pending == 0)
+    return true;
 
-  /* Now we are definitely an interior node, so recurse into all
-     the relevant buckets.  */
+  all = bfd_malloc (n * sizeof (*all));
+  tmp = bfd_malloc (num_pending * sizeof (*tmp));
+  if (all == NULL || tmp == NULL)
+    {
+      free (all);
+      free (tmp);
+      return false;
+    }
 
-  /* Clamp the range to the current trie bucket.  */
-  clamped_low_pc = low_pc;
-  clamped_high_pc = high_pc;
-  if (trie_pc_bits > 0)
+  /* Sort the pending ranges, and merge them in after the others,
+     working back from the end of ALL.  */
+  pending = sort_unit_ranges (idx->pending, tmp, num_pending);
+  merge_unit_ranges (idx->sorted, idx->num_sorted,
+		     idx->wide, idx->num_wide, all);
+  i = num_old;
+  j = num_pending;
+  k = n;
+  while (j != 0)
     {
-      bfd_vma bucket_high_pc =
-	trie_pc + ((bfd_vma) -1 >> trie_pc_bits);  /* Inclusive.  */
-      if (clamped_low_pc < trie_pc)
-	clamped_low_pc = trie_pc;
-      if (clamped_high_pc > bucket_high_pc)
-	clamped_high_pc = bucket_high_pc;
+      if (i != 0 && all[i - 1].low_pc > pending[j - 1].low_pc)
+	all[--k] = all[--i];
+      else
+	all[--k] = pending[--j];
     }
+  free (tmp);
 
-  /* Insert the ranges in all buckets that it spans.  */
-  from_ch = (clamped_low_pc >> (VMA_BITS - trie_pc_bits - 8)) & 0xff;
-  to_ch = ((clamped_high_pc - 1) >> (VMA_BITS - trie_pc_bits - 8)) & 0xff;
-  for (ch = from_ch; ch <= to_ch; ++ch)
+  /* Merge touching or overlapping ranges of one unit.  */
+  for (i = 0, k = 0; i < n; i++)
     {
-      struct trie_interior *interior = (struct trie_interior *) trie;
-      struct trie_node *child = interior->children[ch];
+      if (k != 0
+	  && all[k - 1].unit == all[i].unit
+	  && all[i].low_pc <= all[k - 1].high_pc)
+	{
+	  if (all[i].high_pc > all[k - 1].high_pc)
+	    all[k - 1].high_pc = all[i].high_pc;
+	}
+      else
+	all[k++] = all[i];
+    }
+  n = k;
 
-      if (child == NULL)
-        {
-	  child = alloc_trie_leaf (abfd);
-	  if (!child)
-	    return NULL;
+  /* Move out the wide ranges.  */
+  num_wide = 0;
+  for (i = 0; i + UNIT_INDEX_SPAN < n; i++)
+    if (all[i].high_pc > all[i + UNIT_INDEX_SPAN].low_pc)
+      num_wide++;
+  wide = NULL;
+  if (num_wide != 0)
+    {
+      wide = bfd_malloc (num_wide * sizeof (*wide));
+      if (wide == NULL)
+	{
+	  free (all);
+	  return false;
 	}
-      bfd_vma bucket = (bfd_vma) ch << (VMA_BITS - trie_pc_bits - 8);
-      child = insert_arange_in_trie (abfd,
-				     child,
-				     trie_pc + bucket,
-				     trie_pc_bits + 8,
-				     unit,
-				     low_pc,
-				     high_pc);
-      if (!child)
-	return NULL;
+      for (i = 0, j = 0, k = 0; i < n; i++)
+	if (i + UNIT_INDEX_SPAN < n
+	    && all[i].high_pc > all[i + UNIT_INDEX_SPAN].low_pc)
+	  wide[j++] = all[i];
+	else
+	  all[k++] = all[i];
+      n = k;
+    }
+
+  free (idx->sorted);
+  free (idx->wide);
+  idx->sorted = all;
+  idx->num_sorted = n;
+  idx->wide = wide;
+  idx->num_wide = num_wide;
+  idx->num_pending = 0;
+  return true;
+}
+
+/* Add UNIT to the NUM_FOUND units found so far by unit_index_find,
+   unless it is there already.  Return the new number found.  */
 
-      interior->children[ch] = child;
+static size_t
+unit_index_found (struct unit_index *idx, size_t num_found, void *unit)
+{
+  size_t i;
+
+  for (i = 0; i < num_found; i++)
+    if (idx->found[i] == unit)
+      return num_found;
+
+  if (num_found == idx->found_alloc)
+    {
+      size_t alloc = idx->found_alloc * 2 + 8;
+      void **found = bfd_realloc (idx->found, alloc * sizeof (*found));
+
+      if (found == NULL)
+	return num_found;
+      idx->found = found;
+      idx->found_alloc = alloc;
     }
+  idx->found[num_found] = unit;
+  return num_found + 1;
+}
+
+/* Set IDX->FOUND to the units with a range in IDX containing ADDR,
+   those with the highest start first, and return how many there are.  */
+
+static size_t
+unit_index_find (struct unit_index *idx, bfd_vma addr)
+{
+  size_t num_found = 0;
+  size_t i, n;
+
+  /* Sort the pending ranges once there are a fair number of them.  If
+     that fails we can still look through them.  */
+  if (idx->num_pending > 64 + (idx->num_sorted + idx->num_wide) / 16)
+    unit_index_flush (idx);
 
-    return trie;
+  n = unit_ranges_upto (idx->sorted, idx->num_sorted, addr);
+  for (i = n; i > 0 && i + UNIT_INDEX_SPAN > n; i--)
+    if (addr < idx->sorted[i - 1].high_pc)
+      num_found = unit_index_found (idx, num_found, idx->sorted[i - 1].unit);
+
+  for (i = 0; i < idx->num_wide && idx->wide[i].low_pc <= addr; i++)
+    if (addr < idx->wide[i].high_pc)
+      num_found = unit_index_found (idx, num_found, idx->wide[i].unit);
+
+  for (i = 0; i < idx->num_pending; i++)
+    if (addr >= idx->pending[i].low_pc && addr < idx->pending[i].high_pc)
+      num_found = unit_index_found (idx, num_found, idx->pending[i].unit);
+
+  return num_found;
+}
+
+/* Free the memory used by IDX.  */
+
+static void
+unit_index_free (struct unit_index *idx)
+{
+  free (idx->sorted);
+  free (idx->wide);
+  free (idx->pending);
+  free (idx->found);
+  memset (idx, 0, sizeof (*idx));
 }
 
 static bool
 arange_add (struct comp_unit *unit, struct arange *first_arange,
-	    struct trie_node **trie_root, bfd_vma low_pc, bfd_vma high_pc)
+	    struct unit_index *idx, bfd_vma low_pc, bfd_vma high_pc)
 {
   struct arange *arange;
 
@@ -2292,18 +2468,8 @@ arange_add (struct comp_unit *unit, struct arange *first_arange,
   if (low_pc == high_pc)
     return true;
 
-  if (trie_root != NULL)
-    {
-      *trie_root = insert_arange_in_trie (unit->file->bfd_ptr,
-					  *trie_root,
-					  0,
-					  0,
-					  unit,
-					  low_pc,
-					  high_pc);
-      if (*trie_root == NULL)
-	return false;
-    }
+  if (idx != NULL && !unit_index_add (idx, unit, low_pc, high_pc))
+    return false;
 
   /* If the first arange is empty, use it.  */
   if (first_arange->high == 0)
@@ -2952,7 +3118,7 @@ decode_line_info (struct comp_unit *unit)
 		    low_pc = address;
 		  if (address > high_pc)
 		    high_pc = address;
-		  if (!arange_add (unit, &unit->arange, &unit->file->trie_root,
+		  if (!arange_add (unit, &unit->arange, &unit->file->unit_index,
 				   low_pc, high_pc))
 		    goto line_fail;
 		  break;
@@ -3657,7 +3823,7 @@ find_abstract_instance (struct comp_unit *unit,
 
 static bool
 read_ranges (struct comp_unit *unit, struct arange *arange,
-	     struct trie_node **trie_root, uint64_t offset)
+	     struct unit_index *idx, uint64_t offset)
 {
   bfd_byte *ranges_ptr;
   bfd_byte *ranges_end;
@@ -3692,7 +3858,7 @@ read_ranges (struct comp_unit *unit, struct arange *arange,
 	base_address = high_pc;
       else
 	{
-	  if (!arange_add (unit, arange, trie_root,
+	  if (!arange_add (unit, arange, idx,
 			   base_address + low_pc, base_address + high_pc))
 	    return false;
 	}
@@ -3702,7 +3868,7 @@ read_ranges (struct comp_unit *unit, struct arange *arange,
 
 static bool
 read_rnglists (struct comp_unit *unit, struct arange *arange,
-	       struct trie_node **trie_root, uint64_t offset)
+	       struct unit_index *idx, uint64_t offset)
 {
   bfd_byte *rngs_ptr;
   bfd_byte *rngs_end;
@@ -3776,19 +3942,19 @@ read_rnglists (struct comp_unit *unit, struct arange *arange,
 	  return false;
 	}
 
-      if (!arange_add (unit, arange, trie_root, low_pc, high_pc))
+      if (!arange_add (unit, arange, idx, low_pc, high_pc))
 	return false;
     }
 }
 
 static bool
 read_rangelist (struct comp_unit *unit, struct arange *arange,
-		struct trie_node **trie_root, uint64_t offset)
+		struct unit_index *idx, uint64_t offset)
 {
   if (unit->version <= 4)
-    return read_ranges (unit, arange, trie_root, offset);
+    return read_ranges (unit, arange, idx, offset);
   else
-    return read_rnglists (unit, arange, trie_root, offset);
+    return read_rnglists (unit, arange, idx, offset);
 }
 
 static struct funcinfo *
@@ -4144,7 +4310,7 @@ scan_unit_for_symbols (struct comp_unit *unit)
 		case DW_AT_ranges:
 		  if (is_int_form (&attr)
 		      && !read_rangelist (unit, &func->arange,
-					  &unit->file->trie_root, attr.u.val))
+					  &unit->file->unit_index, attr.u.val))
 		    goto fail;
 		  break;
 
@@ -4258,7 +4424,7 @@ scan_unit_for_symbols (struct comp_unit *unit)
 
       if (func && high_pc != 0)
 	{
-	  if (!arange_add (unit, &func->arange, &unit->file->trie_root,
+	  if (!arange_add (unit, &func->arange, &unit->file->unit_index,
 			   low_pc, high_pc))
 	    goto fail;
 	}
@@ -4315,7 +4481,7 @@ reread_attribute (struct comp_unit *unit,
 
     case DW_AT_ranges:
       if (!read_rangelist (unit, &unit->arange,
-			   &unit->file->trie_root, attr->u.val))
+			   &unit->file->unit_index, attr->u.val))
 	return;
       break;
 
@@ -4568,7 +4734,7 @@ parse_comp_unit (struct dwarf2_debug *stash,
 	case DW_AT_ranges:
 	  if (is_int_form (&attr)
 	      && !read_rangelist (unit, &unit->arange,
-				  &unit->file->trie_root, attr.u.val))
+				  &unit->file->unit_index, attr.u.val))
 	    goto err_exit;
 	  break;
 
@@ -4623,7 +4789,7 @@ parse_comp_unit (struct dwarf2_debug *stash,
     high_pc += low_pc;
   if (high_pc != 0)
     {
-      if (!arange_add (unit, &unit->arange, &unit->file->trie_root,
+      if (!arange_add (unit, &unit->arange, &unit->file->unit_index,
 		       low_pc, high_pc))
 	goto err_exit;
     }
@@ -5420,14 +5586,6 @@ _bfd_dwarf2_slurp_debug_info (bfd *abfd, bfd *debug_bfd,
   if (!stash->alt.abbrev_offsets)
     return false;
 
-  stash->f.trie_root = alloc_trie_leaf (abfd);
-  if (!stash->f.trie_root)
-    return false;
-
-  stash->alt.trie_root = alloc_trie_leaf (abfd);
-  if (!stash->alt.trie_root)
-    return false;
-
   if (debug_bfd == NULL)
     debug_bfd = abfd;
 
@@ -5542,34 +5700,30 @@ _bfd_dwarf2_slurp_debug_info (bfd *abfd, bfd *debug_bfd,
   return false;
 }
 
-/* Parse the next DWARF2 compilation unit at FILE->INFO_PTR.  */
+/* Read the length of the unit at *INFO_PTR, and set *INFO_PTR past it
+   and *OFFSET_SIZE to the size of offsets in the unit.  */
 
-static struct comp_unit *
-stash_comp_unit (struct dwarf2_debug *stash, struct dwarf2_debug_file *file)
+static bfd_size_type
+read_unit_length (bfd *abfd, bfd_byte **info_ptr, bfd_byte *info_ptr_end,
+		  unsigned int *offset_size)
 {
   bfd_size_type length;
-  unsigned int offset_size;
-  bfd_byte *info_ptr_unit = file->info_ptr;
-  bfd_byte *info_ptr_end = file->dwarf_info_buffer + file->dwarf_info_size;
 
-  if (file->info_ptr >= info_ptr_end)
-    return NULL;
-
-  length = read_4_bytes (file->bfd_ptr, &file->info_ptr, info_ptr_end);
+  length = read_4_bytes (abfd, info_ptr, info_ptr_end);
   /* A 0xffffff length is the DWARF3 way of indicating
      we use 64-bit offsets, instead of 32-bit offsets.  */
   if (length == 0xffffffff)
     {
-      offset_size = 8;
-      length = read_8_bytes (file->bfd_ptr, &file->info_ptr, info_ptr_end);
+      *offset_size = 8;
+      length = read_8_bytes (abfd, info_ptr, info_ptr_end);
     }
   /* A zero length is the IRIX way of indicating 64-bit offsets,
      mostly because the 64-bit length will generally fit in 32
      bits, and the endianness helps.  */
   else if (length == 0)
     {
-      offset_size = 8;
-      length = read_4_bytes (file->bfd_ptr, &file->info_ptr, info_ptr_end);
+      *offset_size = 8;
+      length = read_4_bytes (abfd, info_ptr, info_ptr_end);
     }
   /* In the absence of the hints above, we assume 32-bit DWARF2
      offsets even for targets with 64-bit addresses, because:
@@ -5581,57 +5735,401 @@ stash_comp_unit (struct dwarf2_debug *stash, struct dwarf2_debug_file *file)
      the size hints that are tested for above then they are
      not conforming to the DWARF3 standard anyway.  */
   else
-    offset_size = 4;
+    *offset_size = 4;
+
+  return length;
+}
+
+/* Parse the DWARF2 compilation unit at INFO_PTR_UNIT in FILE, and set
+   *NEXT_PTR to the end of it.  */
+
+static struct comp_unit *
+read_comp_unit_at (struct dwarf2_debug *stash, struct dwarf2_debug_file *file,
+		   bfd_byte *info_ptr_unit, bfd_byte **next_ptr)
+{
+  bfd_size_type length;
+  unsigned int offset_size;
+  bfd_byte *info_ptr = info_ptr_unit;
+  bfd_byte *info_ptr_end = file->dwarf_info_buffer + file->dwarf_info_size;
+  struct comp_unit *each;
+
+  length = read_unit_length (file->bfd_ptr, &info_ptr, info_ptr_end,
+			     &offset_size);
+  if (length == 0
+      || length > (size_t) (info_ptr_end - info_ptr))
+    return NULL;
+
+  each = parse_comp_unit (stash, file, info_ptr, length, info_ptr_unit,
+			  offset_size);
+  if (each == NULL)
+    return NULL;
+
+  if (file->comp_unit_tree == NULL)
+    file->comp_unit_tree
+      = splay_tree_new (splay_tree_compare_addr_range,
+			splay_tree_free_addr_range, NULL);
+
+  struct addr_range *r
+    = (struct addr_range *)bfd_malloc (sizeof (struct addr_range));
+  r->start = each->info_ptr_unit;
+  r->end = each->end_ptr;
+  splay_tree_node v = splay_tree_lookup (file->comp_unit_tree,
+					 (splay_tree_key)r);
+  if (v != NULL || r->end <= r->start)
+    abort ();
+  splay_tree_insert (file->comp_unit_tree, (splay_tree_key)r,
+		     (splay_tree_value)each);
+
+  if (file->all_comp_units)
+    file->all_comp_units->prev_unit = each;
+  else
+    file->last_comp_unit = each;
+
+  each->next_unit = file->all_comp_units;
+  file->all_comp_units = each;
+
+  if (each->arange.high == 0)
+    {
+      each->next_unit_without_ranges = file->all_comp_units_without_ranges;
+      file->all_comp_units_without_ranges = each->next_unit_without_ranges;
+    }
+
+  *next_ptr = info_ptr + length;
+  return each;
+}
+
+/* Parse the next DWARF2 compilation unit at FILE->INFO_PTR.  */
 
-  if (length != 0
-      && length <= (size_t) (info_ptr_end - file->info_ptr))
+static struct comp_unit *
+stash_comp_unit (struct dwarf2_debug *stash, struct dwarf2_debug_file *file)
+{
+  bfd_byte *info_ptr_end = file->dwarf_info_buffer + file->dwarf_info_size;
+  struct comp_unit *each;
+
+  /* Skip the units which stash_comp_unit_at has read already.  */
+  while (file->read_out_of_order
+	 && file->comp_unit_tree != NULL
+	 && file->info_ptr < info_ptr_end)
     {
-      struct comp_unit *each = parse_comp_unit (stash, file,
-						file->info_ptr, length,
-						info_ptr_unit, offset_size);
-      if (each)
+      struct addr_range range = { file->info_ptr, file->info_ptr + 1 };
+      splay_tree_node v = splay_tree_lookup (file->comp_unit_tree,
+					     (splay_tree_key) &range);
+      if (v == NULL)
+	break;
+      file->info_ptr = ((struct comp_unit *) v->value)->end_ptr;
+    }
+
+  if (file->info_ptr >= info_ptr_end)
+    return NULL;
+
+  each = read_comp_unit_at (stash, file, file->info_ptr, &file->info_ptr);
+  if (each == NULL)
+    {
+      /* Don't trust any of the DWARF info after a corrupted length or
+	 parse error.  */
+      file->info_ptr = info_ptr_end;
+      file->read_failed = true;
+    }
+  return each;
+}
+
+/* Return the compilation unit starting at INFO_PTR_UNIT in FILE,
+   parsing it if it hasn't been read yet.  INFO_PTR_UNIT must be the
+   start of a unit.  */
+
+static struct comp_unit *
+stash_comp_unit_at (struct dwarf2_debug *stash, struct dwarf2_debug_file *file,
+		    bfd_byte *info_ptr_unit)
+{
+  bfd_byte *next_ptr;
+
+  if (file->comp_unit_tree != NULL)
+    {
+      struct addr_range range = { info_ptr_unit, info_ptr_unit + 1 };
+      splay_tree_node v = splay_tree_lookup (file->comp_unit_tree,
+					     (splay_tree_key) &range);
+      if (v != NULL)
+	return (struct comp_unit *) v->value;
+    }
+
+  /* A unit before FILE->INFO_PTR which isn't in the tree failed to
+     parse.  */
+  if (info_ptr_unit < file->info_ptr)
+    return NULL;
+  if (info_ptr_unit == file->info_ptr)
+    return stash_comp_unit (stash, file);
+
+  file->read_out_of_order = true;
+  return read_comp_unit_at (stash, file, info_ptr_unit, &next_ptr);
+}
+
+/* An index file saved by save_unit_index starts with these eight bytes,
+   followed by the size of .debug_info and the number of ranges, and
+   then the low and high address and the .debug_info offset of the unit
+   of each range, all as 64-bit little endian numbers.  */
+#define UNIT_INDEX_MAGIC "BFDDWIX1"
+
+/* Return the name of the file in which to keep the index of the units
+   of STASH, or NULL if we shouldn't keep one.  Only the units of files
+   with a build ID are kept, and only those of executables and shared
+   libraries, since other files are relocated before lookups.  */
+
+static char *
+unit_index_file_name (struct dwarf2_debug *stash)
+{
+  bfd *abfd = stash->orig_bfd;
+  const struct bfd_build_id *build_id = abfd->build_id;
+  const char *dir = _bfd_dwarf2_index_cache_dir;
+  size_t dirlen, i;
+  char *name, *p;
+
+  if (dir == NULL
+      || (abfd->flags & (EXEC_P | DYNAMIC)) == 0
+      || build_id == NULL
+      || build_id->size == 0)
+    return NULL;
+
+  dirlen = strlen (dir);
+  name = bfd_malloc (dirlen + build_id->size * 2 + sizeof ("/.dwidx"));
+  if (name == NULL)
+    return NULL;
+  memcpy (name, dir, dirlen);
+  p = name + dirlen;
+  *p++ = '/';
+  for (i = 0; i < build_id->size; i++)
+    p += sprintf (p, "%02x", build_id->data[i]);
+  strcpy (p, ".dwidx");
+  return name;
+}
+
+/* Read the index saved in file NAME for the units of FILE into
+   FILE->SAVED_INDEX.  Ignore the file if it is not for FILE.  */
+
+static void
+load_unit_index (struct dwarf2_debug_file *file, const char *name)
+{
+  bfd_byte *info_ptr_end = file->dwarf_info_buffer + file->dwarf_info_size;
+  bfd_byte *info_ptr, *next_ptr;
+  bfd_size_type length;
+  bfd_size_type *starts = NULL;
+  size_t num_starts = 0, starts_alloc = 0;
+  bfd_byte buf[24];
+  uint64_t count, i;
+  FILE *f;
+
+  f = _bfd_real_fopen (name, FOPEN_RB);
+  if (f == NULL)
+    return;
+
+  if (fread (buf, 1, 24, f) != 24
+      || memcmp (buf, UNIT_INDEX_MAGIC, 8) != 0
+      || bfd_getl64 (buf + 8) != file->dwarf_info_size)
+    goto fail;
+  count = bfd_getl64 (buf + 16);
+
+  /* Find where the units start, to check the offsets in the file.  */
+  for (info_ptr = file->dwarf_info_buffer;
+       info_ptr < info_ptr_end;
+       info_ptr = next_ptr + length)
+    {
+      unsigned int offset_size;
+
+      next_ptr = info_ptr;
+      length = read_unit_length (file->bfd_ptr, &next_ptr, info_ptr_end,
+				 &offset_size);
+      if (length == 0 || length > (size_t) (info_ptr_end - next_ptr))
+	break;
+      if (num_starts == starts_alloc)
 	{
-	  if (file->comp_unit_tree == NULL)
-	    file->comp_unit_tree
-	      = splay_tree_new (splay_tree_compare_addr_range,
-				splay_tree_free_addr_range, NULL);
-
-	  struct addr_range *r
-	    = (struct addr_range *)bfd_malloc (sizeof (struct addr_range));
-	  r->start = each->info_ptr_unit;
-	  r->end = each->end_ptr;
-	  splay_tree_node v = splay_tree_lookup (file->comp_unit_tree,
-						 (splay_tree_key)r);
-	  if (v != NULL || r->end <= r->start)
-	    abort ();
-	  splay_tree_insert (file->comp_unit_tree, (splay_tree_key)r,
-			     (splay_tree_value)each);
-
-	  if (file->all_comp_units)
-	    file->all_comp_units->prev_unit = each;
-	  else
-	    file->last_comp_unit = each;
+	  bfd_size_type *n;
+
+	  starts_alloc = starts_alloc * 2 + 64;
+	  n = bfd_realloc (starts, starts_alloc * sizeof (*starts));
+	  if (n == NULL)
+	    goto fail;
+	  starts = n;
+	}
+      starts[num_starts++] = info_ptr - file->dwarf_info_buffer;
+    }
 
-	  each->next_unit = file->all_comp_units;
-	  file->all_comp_units = each;
+  for (i = 0; i < count; i++)
+    {
+      uint64_t low, high, offset;
+      size_t lo, hi;
 
-	  if (each->arange.high == 0)
-	    {
-	      each->next_unit_without_ranges = file->all_comp_units_without_ranges;
-	      file->all_comp_units_without_ranges = each->next_unit_without_ranges;
-	    }
+      if (fread (buf, 1, 24, f) != 24)
+	goto fail;
+      low = bfd_getl64 (buf);
+      high = bfd_getl64 (buf + 8);
+      offset = bfd_getl64 (buf + 16);
+      if (low >= high || (bfd_vma) high != high)
+	goto fail;
+
+      lo = 0;
+      hi = num_starts;
+      while (lo < hi)
+	{
+	  size_t mid = lo + (hi - lo) / 2;
 
-	  file->info_ptr += length;
-	  return each;
+	  if (starts[mid] < offset)
+	    lo = mid + 1;
+	  else
+	    hi = mid;
 	}
+      if (lo == num_starts || starts[lo] != offset)
+	goto fail;
+
+      if (!unit_index_add (&file->saved_index,
+			   file->dwarf_info_buffer + offset, low, high))
+	goto fail;
+    }
+
+  if (getc (f) != EOF
+      || !unit_index_flush (&file->saved_index))
+    goto fail;
+
+  file->saved_index_loaded = true;
+  free (starts);
+  fclose (f);
+  return;
+
+ fail:
+  unit_index_free (&file->saved_index);
+  free (starts);
+  fclose (f);
+}
+
+/* Write the N ranges at R of the units of FILE to F.  */
+
+static bool
+write_unit_ranges (FILE *f, struct dwarf2_debug_file *file,
+		   const struct unit_range *r, size_t n)
+{
+  bfd_byte buf[24];
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      struct comp_unit *unit = (struct comp_unit *) r[i].unit;
+
+      bfd_putl64 (r[i].low_pc, buf);
+      bfd_putl64 (r[i].high_pc, buf + 8);
+      bfd_putl64 (unit->info_ptr_unit - file->dwarf_info_buffer, buf + 16);
+      if (fwrite (buf, 1, 24, f) != 24)
+	return false;
     }
+  return true;
+}
+
+/* Create a new file in the same directory as NAME, with a name no
+   other process or thread is using, in the way mkstemp does.  Return
+   the file opened for writing and set *TMPNAME to its name, or return
+   NULL.  */
 
-  /* Don't trust any of the DWARF info after a corrupted length or
-     parse error.  */
-  file->info_ptr = info_ptr_end;
+static FILE *
+open_unit_index_temp (const char *name, char **tmpname)
+{
+  static unsigned int counter;
+  unsigned long pid = (unsigned long) getpid ();
+  unsigned int tries;
+  char *tmp;
+  int fd = -1;
+
+  tmp = bfd_malloc (strlen (name) + 2 * sizeof (long) * 3 + sizeof (".."));
+  if (tmp == NULL)
+    return NULL;
+
+  /* O_EXCL makes the open fail if the name is taken, in which case
+     try the next one.  */
+  for (tries = 0; tries < 100; tries++)
+    {
+      sprintf (tmp, "%s.%lu.%u", name, pid, counter++);
+      fd = open (tmp, O_WRONLY | O_CREAT | O_EXCL | O_BINARY, 0644);
+      if (fd >= 0 || errno != EEXIST)
+	break;
+    }
+  if (fd >= 0)
+    {
+      FILE *f = fdopen (fd, FOPEN_WB);
+
+      if (f != NULL)
+	{
+	  *tmpname = tmp;
+	  return f;
+	}
+      close (fd);
+      remove (tmp);
+    }
+  free (tmp);
   return NULL;
 }
 
+/* Save the index of all the units of FILE in file NAME.  The index is
+   written to a new temporary file in the same directory first and then
+   renamed, so that readers never see part of one, and processes saving
+   the same index at the same time don't write to the same file.  */
+
+static void
+save_unit_index (struct dwarf2_debug_file *file, const char *name)
+{
+  struct unit_index *idx = &file->unit_index;
+  bfd_byte buf[24];
+  char *tmpname;
+  bool ok;
+  FILE *f;
+
+  unit_index_flush (idx);
+
+  f = open_unit_index_temp (name, &tmpname);
+  if (f == NULL)
+    return;
+
+  memcpy (buf, UNIT_INDEX_MAGIC, 8);
+  bfd_putl64 (file->dwarf_info_size, buf + 8);
+  bfd_putl64 (idx->num_sorted + idx->num_wide + idx->num_pending, buf + 16);
+  ok = (fwrite (buf, 1, 24, f) == 24
+	&& write_unit_ranges (f, file, idx->sorted, idx->num_sorted)
+	&& write_unit_ranges (f, file, idx->wide, idx->num_wide)
+	&& write_unit_ranges (f, file, idx->pending, idx->num_pending));
+  ok &= fclose (f) == 0;
+
+  if (!ok || rename (tmpname, name) != 0)
+    remove (tmpname);
+  free (tmpname);
+}
+
+/* Look for an index of the units of STASH saved by save_unit_index, or
+   if there is none, read all the units and save their index, so that
+   later lookups in the same file by other processes can read just the
+   units they need.  */
+
+static void
+check_saved_unit_index (struct dwarf2_debug *stash)
+{
+  struct dwarf2_debug_file *file = &stash->f;
+  struct comp_unit *each;
+  char *name;
+
+  file->saved_index_checked = true;
+  name = unit_index_file_name (stash);
+  if (name == NULL)
+    return;
+
+  load_unit_index (file, name);
+  if (!file->saved_index_loaded)
+    {
+      while (stash_comp_unit (stash, file) != NULL)
+	;
+      if (!file->read_failed)
+	{
+	  for (each = file->all_comp_units; each; each = each->next_unit)
+	    comp_unit_maybe_decode_line_info (each);
+	  save_unit_index (file, name);
+	}
+    }
+  free (name);
+}
+
 /* Hash function for an asymbol.  */
 
 static hashval_t
@@ -5903,43 +6401,23 @@ _bfd_dwarf2_find_nearest_line_with_alt
     }
   else
     {
-      struct trie_node *trie = stash->f.trie_root;
-      unsigned int bits = VMA_BITS - 8;
       struct comp_unit **prev_each;
+      size_t i, num_found;
 
-      /* Traverse interior nodes until we get to a leaf.  */
-      while (trie && trie->num_room_in_leaf == 0)
-	{
-	  int ch = (addr >> bits) & 0xff;
-	  trie = ((struct trie_interior *) trie)->children[ch];
-	  bits -= 8;
-	}
+      if (!stash->f.saved_index_checked)
+	check_saved_unit_index (stash);
 
-      if (trie)
+      num_found = unit_index_find (&stash->f.unit_index, addr);
+      for (i = 0; i < num_found; i++)
 	{
-	  const struct trie_leaf *leaf = (struct trie_leaf *) trie;
-	  unsigned int i;
-
-	  for (i = 0; i < leaf->num_stored_in_leaf; ++i)
-	    leaf->ranges[i].unit->mark = false;
-
-	  for (i = 0; i < leaf->num_stored_in_leaf; ++i)
-	    {
-	      struct comp_unit *unit = leaf->ranges[i].unit;
-	      if (unit->mark
-		  || addr < leaf->ranges[i].low_pc
-		  || addr >= leaf->ranges[i].high_pc)
-	        continue;
-	      unit->mark = true;
-
-	      found = comp_unit_find_nearest_line (unit, addr,
-						   filename_ptr,
-						   &function,
-						   linenumber_ptr,
-						   discriminator_ptr);
-	      if (found)
-		goto done;
-	   }
+	  found = comp_unit_find_nearest_line (stash->f.unit_index.found[i],
+					       addr,
+					       filename_ptr,
+					       &function,
+					       linenumber_ptr,
+					       discriminator_ptr);
+	  if (found)
+	    goto done;
 	}
 
       /* Also scan through all compilation units without any ranges,
@@ -5963,6 +6441,29 @@ _bfd_dwarf2_find_nearest_line_with_alt
 	    goto done;
 	  prev_each = &each->next_unit_without_ranges;
 	}
+
+      /* A saved index covers all the units, so read just those it
+	 says may contain ADDR.  */
+      if (stash->f.saved_index_loaded)
+	{
+	  num_found = unit_index_find (&stash->f.saved_index, addr);
+	  for (i = 0; i < num_found; i++)
+	    {
+	      each = stash_comp_unit_at (stash, &stash->f,
+					 stash->f.saved_index.found[i]);
+	      if (each != NULL)
+		{
+		  found = comp_unit_find_nearest_line (each, addr,
+						       filename_ptr,
+						       &function,
+						       linenumber_ptr,
+						       discriminator_ptr);
+		  if (found)
+		    goto done;
+		}
+	    }
+	  goto done;
+	}
     }
 
   /* Read each remaining comp. units checking each as they are read.  */
@@ -6062,6 +6563,15 @@ _bfd_dwarf2_find_inliner_info (bfd *abfd ATTRIBUTE_UNUSED,
   return false;
 }
 
+/* Free BUF, a section of FILE read by read_section.  */
+
+static void
+free_section_buffer (struct dwarf2_debug_file *file, bfd_byte *buf)
+{
+  if (!bfd_release_section_view (file->bfd_ptr, buf))
+    free (buf);
+}
+
 void
 _bfd_dwarf2_cleanup_debug_info (bfd *abfd, void **pinfo)
 {
@@ -6117,15 +6627,20 @@ _bfd_dwarf2_cleanup_debug_info (bfd *abfd, void **pinfo)
 	  free (file->line_table->dirs);
 	}
       htab_delete (file->abbrev_offsets);
+      unit_index_free (&file->unit_index);
+      unit_index_free (&file->saved_index);
       if (file->comp_unit_tree != NULL)
 	splay_tree_delete (file->comp_unit_tree);
 
-      free (file->dwarf_line_str_buffer);
-      free (file->dwarf_str_buffer);
-      free (file->dwarf_ranges_buffer);
-      free (file->dwarf_line_buffer);
-      free (file->dwarf_abbrev_buffer);
-      free (file->dwarf_info_buffer);
+      free_section_buffer (file, file->dwarf_line_str_buffer);
+      free_section_buffer (file, file->dwarf_str_buffer);
+      free_section_buffer (file, file->dwarf_str_offsets_buffer);
+      free_section_buffer (file, file->dwarf_addr_buffer);
+      free_section_buffer (file, file->dwarf_ranges_buffer);
+      free_section_buffer (file, file->dwarf_rnglists_buffer);
+      free_section_buffer (file, file->dwarf_line_buffer);
+      free_section_buffer (file, file->dwarf_abbrev_buffer);
+      free_section_buffer (file, file->dwarf_info_buffer);
       if (file == &stash->alt)
 	break;
       file = &stash->alt;
@@ -737,6 +737,15 @@ struct elf_link_hash_table
   /* Small local sym cache.  */
   struct sym_cache sym_cache;
 
+  /* Sections marked by _bfd_elf_gc_mark whose relocs have yet to be
+     followed, and the size of the stack.  */
+  struct elf_gc_mark_item *gc_mark_stack;
+  size_t gc_mark_count;
+  size_t gc_mark_alloc;
+
+  /* TRUE while _bfd_elf_gc_mark is working through GC_MARK_STACK.  */
+  bool gc_marking;
+
   /* Short-cuts to get to dynamic linker sections.  */
   asection *sgot;
   asection *sgotplt;
@@ -2046,6 +2055,13 @@ struct elf_obj_tdata
   unsigned int num_elf_sections;	/* elf_sect_ptr size */
   unsigned char *being_created;
 
+  /* While elf_object_p makes the sections of an input file whose
+     debugging sections are to be compressed, the sections found to
+     need compressing, so that they can be compressed together once
+     all the sections have been made.  */
+  asection **sections_to_compress;
+  unsigned int sections_to_compress_count;
+
   /* A mapping from external symbols to entries in the linker hash
      table, used when linking.  This is indexed by the symbol index
      minus the sh_info field of the symbol table header.  */
@@ -2731,6 +2747,22 @@ extern bool _bfd_elf_link_iterate_on_relocs
   bool (*) (bfd *, struct bfd_link_info *, asection *,
 	    const Elf_Internal_Rela *));
 
+/* A key for _bfd_elf_radix_sort.  Keys are ordered by K[0], then by
+   K[1], then by K[2], as far as the number of words being sorted on.
+   INDEX is for the caller, typically the position of the item the key
+   was made for.  */
+
+struct elf_radix_sort_key
+{
+  uint64_t k[3];
+  size_t index;
+};
+
+extern bool _bfd_elf_radix_sort
+  (struct elf_radix_sort_key *, size_t, unsigned int, unsigned int);
+extern bool _bfd_elf_radix_sort_apply
+  (void *, size_t, size_t, struct elf_radix_sort_key *);
+
 extern bool bfd_elf_link_record_dynamic_symbol
   (struct bfd_link_info *, struct elf_link_hash_entry *);
 
@@ -101,8 +101,8 @@ _bfd_elf_strtab_init (void)
   if (table == NULL)
     return NULL;
 
-  if (!bfd_hash_table_init (&table->table, elf_strtab_hash_newfunc,
-			    sizeof (struct elf_strtab_hash_entry)))
+  if (!bfd_hash_table_init_open (&table->table, elf_strtab_hash_newfunc,
+				 sizeof (struct elf_strtab_hash_entry)))
     {
       free (table);
       return NULL;
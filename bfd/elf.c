@@ -1219,7 +1219,12 @@ _bfd_elf_make_section_from_shdr (bfd *abfd,
 
       if (action == compress)
 	{
-	  if (!bfd_init_section_compress_status (abfd, newsect))
+	  struct elf_obj_tdata *tdata = elf_tdata (abfd);
+
+	  if (tdata->sections_to_compress != NULL)
+	    tdata->sections_to_compress[tdata->sections_to_compress_count++]
+	      = newsect;
+	  else if (!bfd_init_section_compress_status (abfd, newsect))
 	    {
 	      _bfd_error_handler
 		/* xgettext:c-format */
@@ -7151,6 +7156,63 @@ _bfd_elf_modify_headers (bfd *obfd, struct bfd_link_info *link_info)
   return true;
 }
 
+/* Whether SHDRP is a DWARF debug section whose position is left to
+   _bfd_elf_assign_file_positions_for_non_load, so that it can be
+   compressed first.  */
+
+static bool
+elf_section_to_compress (Elf_Internal_Shdr *shdrp)
+{
+  return (shdrp->sh_offset == -1
+	  && shdrp->bfd_section != NULL
+	  && shdrp->sh_type != SHT_REL
+	  && shdrp->sh_type != SHT_RELA
+	  && !bfd_section_is_ctf (shdrp->bfd_section)
+	  && shdrp->sh_name == -1u);
+}
+
+/* Compress the DWARF debug sections of ABFD, all together so that
+   they can be compressed in parallel.  */
+
+static bool
+elf_compress_debug_sections (bfd *abfd)
+{
+  Elf_Internal_Shdr **shdrpp, **end_shdrpp;
+  asection **secs;
+  bfd_byte **contents;
+  size_t count;
+  bool ret;
+
+  shdrpp = elf_elfsections (abfd);
+  end_shdrpp = shdrpp + elf_numsections (abfd);
+  count = 0;
+  for (shdrpp++; shdrpp < end_shdrpp; shdrpp++)
+    if (elf_section_to_compress (*shdrpp))
+      count++;
+  if (count == 0)
+    return true;
+
+  secs = (asection **) bfd_malloc (count * (sizeof (*secs)
+					    + sizeof (*contents)));
+  if (secs == NULL)
+    return false;
+  contents = (bfd_byte **) (secs + count);
+
+  shdrpp = elf_elfsections (abfd);
+  count = 0;
+  for (shdrpp++; shdrpp < end_shdrpp; shdrpp++)
+    if (elf_section_to_compress (*shdrpp))
+      {
+	secs[count] = (*shdrpp)->bfd_section;
+	contents[count] = (*shdrpp)->contents;
+	count++;
+      }
+
+  ret = _bfd_compress_sections (abfd, count, secs, contents);
+  free (secs);
+  return ret;
+}
+
 /* Assign file positions for all the reloc sections which are not part
    of the loadable file image, and the file position of section headers.  */
 
@@ -7167,6 +7229,10 @@ _bfd_elf_assign_file_positions_for_non_load (bfd *abfd)
   if ((abfd->flags & BFD_NO_SECTION_HEADER) != 0)
     return true;
 
+  /* Compress DWARF debug sections.  */
+  if (!elf_compress_debug_sections (abfd))
+    return false;
+
   off = elf_next_file_pos (abfd);
 
   shdrpp = elf_elfsections (abfd);
@@ -7192,10 +7258,6 @@ _bfd_elf_assign_file_positions_for_non_load (bfd *abfd)
 	      const char *name = sec->name;
 	      struct bfd_elf_section_data *d;
 
-	      /* Compress DWARF debug sections.  */
-	      if (!bfd_compress_section (abfd, sec, shdrp->contents))
-		return false;
-
 	      if (sec->compress_status == COMPRESS_SECTION_DONE
 		  && (abfd->flags & BFD_COMPRESS_GABI) == 0
 		  && name[1] == 'd')
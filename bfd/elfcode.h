@@ -876,9 +876,35 @@ elf_object_p (bfd *abfd)
 	 can start processing them.  Note that the first section header is
 	 a dummy placeholder entry, so we ignore it.  */
       num_sec = elf_numsections (abfd);
+      if ((abfd->flags & BFD_COMPRESS) != 0)
+	{
+	  /* Collect the debugging sections to be compressed, and
+	     compress them all at once.  */
+	  elf_tdata (abfd)->sections_to_compress
+	    = (asection **) bfd_alloc (abfd, num_sec * sizeof (asection *));
+	  if (elf_tdata (abfd)->sections_to_compress == NULL)
+	    goto got_no_match;
+	}
       for (shindex = 1; shindex < num_sec; shindex++)
 	if (!bfd_section_from_shdr (abfd, shindex))
 	  goto got_no_match;
+      if (elf_tdata (abfd)->sections_to_compress != NULL)
+	{
+	  asection **secs = elf_tdata (abfd)->sections_to_compress;
+	  unsigned int count = elf_tdata (abfd)->sections_to_compress_count;
+	  size_t done;
+
+	  elf_tdata (abfd)->sections_to_compress = NULL;
+	  done = _bfd_init_sections_compress_status (abfd, count, secs);
+	  if (done != count)
+	    {
+	      _bfd_error_handler
+		/* xgettext:c-format */
+		(_("%pB: unable to compress section %s"), abfd,
+		 secs[done]->name);
+	      goto got_no_match;
+	    }
+	}
 
       /* Set up ELF sections for SHF_GROUP and SHF_LINK_ORDER.  */
       if (! _bfd_elf_setup_sections (abfd))
@@ -1053,19 +1053,21 @@ elf_merge_st_other (bfd *abfd, struct elf_link_hash_entry *h,
    existing symbol.  It handles the various cases which arise when we
    find a definition in a dynamic object, or when there is already a
    definition in a dynamic object.  The new symbol is described by
-   NAME, SYM, PSEC, and PVALUE.  We set SYM_HASH to the hash table
-   entry.  We set POLDBFD to the old symbol's BFD.  We set POLD_WEAK
-   if the old symbol was weak.  We set POLD_ALIGNMENT to the alignment
-   of an old common symbol.  We set OVERRIDE if the old symbol is
-   overriding a new definition.  We set TYPE_CHANGE_OK if it is OK for
-   the type to change.  We set SIZE_CHANGE_OK if it is OK for the size
-   to change.  By OK to change, we mean that we shouldn't warn if the
-   type or size does change.  */
+   NAME, SYM, PSEC, and PVALUE.  HINT, if not NULL, is the existing
+   hash table entry for NAME, found ahead of time.  We set SYM_HASH to
+   the hash table entry.  We set POLDBFD to the old symbol's BFD.  We
+   set POLD_WEAK if the old symbol was weak.  We set POLD_ALIGNMENT to
+   the alignment of an old common symbol.  We set OVERRIDE if the old
+   symbol is overriding a new definition.  We set TYPE_CHANGE_OK if it
+   is OK for the type to change.  We set SIZE_CHANGE_OK if it is OK for
+   the size to change.  By OK to change, we mean that we shouldn't warn
+   if the type or size does change.  */
 
 static bool
 _bfd_elf_merge_symbol (bfd *abfd,
 		       struct bfd_link_info *info,
 		       const char *name,
+		       struct elf_link_hash_entry *hint,
 		       Elf_Internal_Sym *sym,
 		       asection **psec,
 		       bfd_vma *pvalue,
@@ -1098,7 +1100,9 @@ _bfd_elf_merge_symbol (bfd *abfd,
   sec = *psec;
   bind = ELF_ST_BIND (sym->st_info);
 
-  if (! bfd_is_und_section (sec))
+  if (hint != NULL)
+    h = hint;
+  else if (! bfd_is_und_section (sec))
     h = elf_link_hash_lookup (elf_hash_table (info), name, true, false, false);
   else
     h = ((struct elf_link_hash_entry *)
@@ -1944,9 +1948,10 @@ _bfd_elf_add_default_symbol (bfd *abfd,
   size_change_ok = false;
   matched = true;
   tmp_sec = sec;
-  if (!_bfd_elf_merge_symbol (abfd, info, shortname, sym, &tmp_sec, &value,
-			      &hi, poldbfd, NULL, NULL, &skip, &override,
-			      &type_change_ok, &size_change_ok, &matched))
+  if (!_bfd_elf_merge_symbol (abfd, info, shortname, NULL, sym, &tmp_sec,
+			      &value, &hi, poldbfd, NULL, NULL, &skip,
+			      &override, &type_change_ok, &size_change_ok,
+			      &matched))
     return false;
 
   if (skip)
@@ -2103,9 +2108,10 @@ _bfd_elf_add_default_symbol (bfd *abfd,
   type_change_ok = false;
   size_change_ok = false;
   tmp_sec = sec;
-  if (!_bfd_elf_merge_symbol (abfd, info, shortname, sym, &tmp_sec, &value,
-			      &hi, poldbfd, NULL, NULL, &skip, &override,
-			      &type_change_ok, &size_change_ok, &matched))
+  if (!_bfd_elf_merge_symbol (abfd, info, shortname, NULL, sym, &tmp_sec,
+			      &value, &hi, poldbfd, NULL, NULL, &skip,
+			      &override, &type_change_ok, &size_change_ok,
+			      &matched))
     return false;
 
   if (skip)
@@ -4202,6 +4208,102 @@ _bfd_elf_link_check_relocs (bfd *abfd, struct bfd_link_info *info)
   return true;
 }
 
+/* With --threads, the global symbols of an input file with at least
+   ELF_SYMBOL_HINT_MIN of them are looked up in the linker hash table by
+   other threads, ELF_SYMBOL_HINT_CHUNK symbols at a time, before any
+   of them are added.  The table is not modified while this happens,
+   so the lookups need no locking; symbols not yet in the table are
+   looked up again as they are added.  */
+
+#define ELF_SYMBOL_HINT_MIN 4096
+#define ELF_SYMBOL_HINT_CHUNK 1024
+
+struct elf_symbol_hints
+{
+  struct bfd_hash_table *table;
+  const Elf_Internal_Sym *isymbuf;
+  size_t count;
+  const char *strtab;
+  bfd_size_type strtab_size;
+  struct elf_link_hash_entry **hints;
+};
+
+static void
+elf_find_symbol_hints (void *data, size_t chunk)
+{
+  struct elf_symbol_hints *sh = (struct elf_symbol_hints *) data;
+  size_t i = chunk * ELF_SYMBOL_HINT_CHUNK;
+  size_t end = i + ELF_SYMBOL_HINT_CHUNK;
+
+  if (end > sh->count)
+    end = sh->count;
+  for (; i < end; i++)
+    {
+      const Elf_Internal_Sym *isym = sh->isymbuf + i;
+      struct bfd_hash_entry *ent = NULL;
+
+      if (ELF_ST_BIND (isym->st_info) != STB_LOCAL
+	  && isym->st_name != 0
+	  && isym->st_name < sh->strtab_size)
+	ent = bfd_hash_lookup (sh->table, sh->strtab + isym->st_name,
+			       false, false);
+      sh->hints[i] = (struct elf_link_hash_entry *) ent;
+    }
+}
+
+/* Return an array giving the existing hash table entry, or NULL, for
+   each of the EXTSYMCOUNT symbols in ISYMBUF, read from the symbol
+   table HDR of ABFD.  Set *PSTRTAB to the string table the entries
+   were looked up by.  Return NULL if it isn't worth looking the
+   symbols up ahead of time, or if anything goes wrong; the symbols
+   are then just looked up as they are added.  */
+
+static struct elf_link_hash_entry **
+elf_link_symbol_hints (bfd *abfd, struct bfd_link_info *info,
+		       Elf_Internal_Shdr *hdr, Elf_Internal_Sym *isymbuf,
+		       size_t extsymcount, const char **pstrtab)
+{
+  struct elf_symbol_hints sh;
+  Elf_Internal_Shdr *strhdr;
+  size_t amt;
+
+  if (!BFD_SUPPORTS_THREADS
+      || info->threads <= 1
+      || extsymcount < ELF_SYMBOL_HINT_MIN
+      || info->wrap_hash != NULL
+      || !is_elf_hash_table (info->hash)
+      || hdr->sh_link >= elf_numsections (abfd))
+    return NULL;
+
+  /* Read the string table now, as bfd_elf_string_from_elf_section
+     would, so that the other threads only look at memory.  */
+  strhdr = elf_elfsections (abfd)[hdr->sh_link];
+  if (strhdr == NULL || strhdr->sh_type != SHT_STRTAB)
+    return NULL;
+  if (strhdr->contents == NULL
+      && bfd_elf_get_str_section (abfd, hdr->sh_link) == NULL)
+    return NULL;
+  if (strhdr->sh_size == 0
+      || strhdr->contents[strhdr->sh_size - 1] != 0)
+    return NULL;
+
+  amt = extsymcount * sizeof (struct elf_link_hash_entry *);
+  sh.hints = (struct elf_link_hash_entry **) bfd_malloc (amt);
+  if (sh.hints == NULL)
+    return NULL;
+  sh.table = &info->hash->table;
+  sh.isymbuf = isymbuf;
+  sh.count = extsymcount;
+  sh.strtab = (const char *) strhdr->contents;
+  sh.strtab_size = strhdr->sh_size;
+  _bfd_parallel_for (info->threads,
+		     ((extsymcount + ELF_SYMBOL_HINT_CHUNK - 1)
+		      / ELF_SYMBOL_HINT_CHUNK),
+		     elf_find_symbol_hints, &sh);
+  *pstrtab = sh.strtab;
+  return sh.hints;
+}
+
 /* Add symbols from an ELF object file to the linker hash table.  */
 
 static bool
@@ -4223,6 +4325,8 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
   Elf_Internal_Sym *isymbuf = NULL;
   Elf_Internal_Sym *isym;
   Elf_Internal_Sym *isymend;
+  struct elf_link_hash_entry **sym_hints = NULL;
+  const char *sym_strtab = NULL;
   const struct elf_backend_data *bed;
   bool add_needed;
   struct elf_link_hash_table *htab;
@@ -4775,6 +4879,9 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
 	(_("%pB: plugin needed to handle lto object"), abfd);
     }
 
+  sym_hints = elf_link_symbol_hints (abfd, info, hdr, isymbuf, extsymcount,
+				     &sym_strtab);
+
   for (isym = isymbuf, isymend = PTR_ADD (isymbuf, extsymcount);
        isym < isymend;
        isym++, sym_hash++, ever = (ever != NULL ? ever + 1 : NULL))
@@ -4786,6 +4893,7 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
       const char *name;
       struct elf_link_hash_entry *h;
       struct elf_link_hash_entry *hi;
+      struct elf_link_hash_entry *hint;
       bool definition;
       bool size_change_ok;
       bool type_change_ok;
@@ -5092,8 +5200,12 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
 	    isym->st_other = (STV_HIDDEN
 			      | (isym->st_other & ~ELF_ST_VISIBILITY (-1)));
 
-	  if (!_bfd_elf_merge_symbol (abfd, info, name, isym, &sec, &value,
-				      sym_hash, &old_bfd, &old_weak,
+	  hint = NULL;
+	  if (sym_hints != NULL && name == sym_strtab + isym->st_name)
+	    hint = sym_hints[isym - isymbuf];
+
+	  if (!_bfd_elf_merge_symbol (abfd, info, name, hint, isym, &sec,
+				      &value, sym_hash, &old_bfd, &old_weak,
 				      &old_alignment, &skip, &override,
 				      &type_change_ok, &size_change_ok,
 				      &matched))
@@ -5568,6 +5680,8 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
 
   free (extversym);
   extversym = NULL;
+  free (sym_hints);
+  sym_hints = NULL;
   free (isymbuf);
   isymbuf = NULL;
 
@@ -5914,6 +6028,7 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
   return true;
 
  error_free_vers:
+  free (sym_hints);
   free (old_tab);
   free (old_strtab);
   free (nondeflt_vers);
@@ -8142,6 +8257,7 @@ _bfd_elf_link_hash_table_free (bfd *obfd)
   if (htab->dynstr != NULL)
     _bfd_elf_strtab_free (htab->dynstr);
   _bfd_merge_sections_free (htab->merge_info);
+  free (htab->gc_mark_stack);
   _bfd_generic_link_hash_table_free (obfd);
 }
 
@@ -8727,6 +8843,11 @@ struct elf_final_link_info
   size_t filesym_count;
   /* Local symbol hash table.  */
   struct bfd_hash_table local_hash_table;
+  /* Input section contents being read ahead by other threads, or
+     NULL if we are not using threads.  */
+  struct elf_link_prefetch *prefetch;
+  /* The contents read ahead for the input BFD being linked, or NULL.  */
+  struct elf_prefetch_bfd *prefetched;
 };
 
 struct local_hash_entry
@@ -9689,6 +9810,263 @@ elf_link_sort_cmp2 (const void *A, const void *B)
   return 0;
 }
 
+/* Each thread used by _bfd_elf_radix_sort handles at least this many
+   keys.  */
+#define ELF_RADIX_SORT_CHUNK_MIN 32768
+
+/* One pass of _bfd_elf_radix_sort, which moves the keys at FROM to TO
+   in order of byte SHIFT / 8 of word WORD.  The keys are split into
+   chunks of CHUNK keys, one per thread.  */
+
+struct elf_radix_sort_pass
+{
+  struct elf_radix_sort_key *from;
+  struct elf_radix_sort_key *to;
+  size_t count;
+  size_t chunk;
+  unsigned int word;
+  unsigned int shift;
+  /* For each chunk, the number of keys with each byte value, then the
+     position in TO of the next of them.  */
+  size_t (*counts)[256];
+};
+
+/* Count the byte values in chunk C of a radix sort pass.  */
+
+static void
+elf_radix_sort_count (void *data, size_t c)
+{
+  struct elf_radix_sort_pass *rp = (struct elf_radix_sort_pass *) data;
+  size_t *counts = rp->counts[c];
+  size_t i = c * rp->chunk;
+  size_t end = i + rp->chunk < rp->count ? i + rp->chunk : rp->count;
+
+  memset (counts, 0, sizeof (rp->counts[c]));
+  for (; i < end; i++)
+    counts[(rp->from[i].k[rp->word] >> rp->shift) & 0xff]++;
+}
+
+/* Move the keys of chunk C of a radix sort pass to their places.  */
+
+static void
+elf_radix_sort_scatter (void *data, size_t c)
+{
+  struct elf_radix_sort_pass *rp = (struct elf_radix_sort_pass *) data;
+  size_t *pos = rp->counts[c];
+  size_t i = c * rp->chunk;
+  size_t end = i + rp->chunk < rp->count ? i + rp->chunk : rp->count;
+
+  for (; i < end; i++)
+    rp->to[pos[(rp->from[i].k[rp->word] >> rp->shift) & 0xff]++]
+      = rp->from[i];
+}
+
+/* Sort the COUNT keys at KEYS by their first NWORDS words, using up to
+   THREADS threads.  This is a least significant digit radix sort, so
+   keys which compare equal keep their order.  Bytes which are the
+   same in every key are skipped, so a sort on addresses in one
+   output file usually takes only three or four passes.  Return false
+   if we run out of memory, leaving KEYS unchanged.  */
+
+bool
+_bfd_elf_radix_sort (struct elf_radix_sort_key *keys, size_t count,
+		     unsigned int nwords, unsigned int threads)
+{
+  struct elf_radix_sort_pass rp;
+  struct elf_radix_sort_key *tmp;
+  size_t nchunks, i;
+
+  if (count < 2)
+    return true;
+
+  /* Input is often in order already, or nearly so.  */
+  for (i = 1; i < count; i++)
+    {
+      unsigned int w;
+
+      for (w = 0; w < nwords; w++)
+	if (keys[i - 1].k[w] != keys[i].k[w])
+	  break;
+      if (w < nwords && keys[i - 1].k[w] > keys[i].k[w])
+	break;
+    }
+  if (i == count)
+    return true;
+
+  nchunks = 1;
+  if (BFD_SUPPORTS_THREADS && threads > 1)
+    {
+      nchunks = count / ELF_RADIX_SORT_CHUNK_MIN;
+      if (nchunks > threads)
+	nchunks = threads;
+      if (nchunks == 0)
+	nchunks = 1;
+    }
+
+  tmp = (struct elf_radix_sort_key *) bfd_malloc (count * sizeof (*tmp));
+  rp.counts = (size_t (*)[256]) bfd_malloc (nchunks * sizeof (*rp.counts));
+  if (tmp == NULL || rp.counts == NULL)
+    {
+      free (tmp);
+      free (rp.counts);
+      return false;
+    }
+
+  rp.from = keys;
+  rp.to = tmp;
+  rp.count = count;
+  rp.chunk = (count + nchunks - 1) / nchunks;
+  for (rp.word = nwords; rp.word-- > 0; )
+    {
+      uint64_t differ = 0;
+
+      /* Find the bytes of this word that differ between keys.  */
+      for (i = 1; i < count; i++)
+	differ |= rp.from[i].k[rp.word] ^ rp.from[0].k[rp.word];
+
+      for (rp.shift = 0; rp.shift < 64; rp.shift += 8)
+	{
+	  struct elf_radix_sort_key *swap;
+	  size_t pos, c;
+	  unsigned int b;
+
+	  if (((differ >> rp.shift) & 0xff) == 0)
+	    continue;
+
+	  _bfd_parallel_for (threads, nchunks, elf_radix_sort_count, &rp);
+
+	  /* Each chunk's keys with a given byte go after those of the
+	     earlier chunks, so that the sort is stable.  */
+	  pos = 0;
+	  for (b = 0; b < 256; b++)
+	    for (c = 0; c < nchunks; c++)
+	      {
+		size_t n = rp.counts[c][b];
+		rp.counts[c][b] = pos;
+		pos += n;
+	      }
+
+	  _bfd_parallel_for (threads, nchunks, elf_radix_sort_scatter, &rp);
+	  swap = rp.from;
+	  rp.from = rp.to;
+	  rp.to = swap;
+	}
+    }
+
+  if (rp.from != keys)
+    memcpy (keys, rp.from, count * sizeof (*keys));
+  free (tmp);
+  free (rp.counts);
+  return true;
+}
+
+/* Put the COUNT items of SIZE bytes at BASE in the order given by
+   KEYS, so that item I is the one which was at KEYS[I].INDEX.  The
+   items are moved in place, a cycle of the permutation at a time, and
+   the indices in KEYS are overwritten.  Return false if we run out of
+   memory, leaving the items as they were.  */
+
+bool
+_bfd_elf_radix_sort_apply (void *base, size_t count, size_t size,
+			   struct elf_radix_sort_key *keys)
+{
+  bfd_byte *p = (bfd_byte *) base;
+  bfd_byte *tmp;
+  size_t i;
+
+  tmp = (bfd_byte *) bfd_malloc (size);
+  if (tmp == NULL)
+    return false;
+
+  for (i = 0; i < count; i++)
+    {
+      size_t j, k;
+
+      if (keys[i].index == i)
+	continue;
+
+      memcpy (tmp, p + i * size, size);
+      for (j = i; (k = keys[j].index) != i; j = k)
+	{
+	  memcpy (p + j * size, p + k * size, size);
+	  keys[j].index = j;
+	}
+      memcpy (p + j * size, tmp, size);
+      keys[j].index = j;
+    }
+
+  free (tmp);
+  return true;
+}
+
+/* The relocs being put in order by elf_link_sort_permute.  */
+
+struct elf_link_sort_order
+{
+  bfd_byte *to;
+  const bfd_byte *from;
+  const struct elf_radix_sort_key *keys;
+  size_t count;
+  size_t sort_elt;
+  size_t chunk;
+};
+
+/* Copy chunk C of the relocs being put in order.  */
+
+static void
+elf_link_sort_permute (void *data, size_t c)
+{
+  struct elf_link_sort_order *so = (struct elf_link_sort_order *) data;
+  size_t i = c * so->chunk;
+  size_t end = i + so->chunk < so->count ? i + so->chunk : so->count;
+
+  for (; i < end; i++)
+    memcpy (so->to + i * so->sort_elt,
+	    so->from + so->keys[i].index * so->sort_elt, so->sort_elt);
+}
+
+/* Sort the COUNT relocs of SORT_ELT bytes at SORT by KEYS, which has
+   been set up with the first NWORDS words of the key for each reloc
+   and its position.  Return false if we run out of memory, leaving
+   the relocs as they were.  */
+
+static bool
+elf_link_sort_by_keys (struct bfd_link_info *info, bfd_byte *sort,
+		       size_t count, size_t sort_elt,
+		       struct elf_radix_sort_key *keys, unsigned int nwords)
+{
+  struct elf_link_sort_order so;
+  bfd_byte *copy;
+  size_t nchunks;
+
+  if (!_bfd_elf_radix_sort (keys, count, nwords, info->threads))
+    return false;
+
+  copy = (bfd_byte *) bfd_malloc (count * sort_elt);
+  if (copy == NULL)
+    return false;
+  memcpy (copy, sort, count * sort_elt);
+
+  nchunks = 1;
+  if (BFD_SUPPORTS_THREADS && info->threads > 1)
+    {
+      nchunks = count / ELF_RADIX_SORT_CHUNK_MIN;
+      if (nchunks > info->threads)
+	nchunks = info->threads;
+      if (nchunks == 0)
+	nchunks = 1;
+    }
+  so.to = sort;
+  so.from = copy;
+  so.keys = keys;
+  so.count = count;
+  so.sort_elt = sort_elt;
+  so.chunk = (count + nchunks - 1) / nchunks;
+  _bfd_parallel_for (info->threads, nchunks, elf_link_sort_permute, &so);
+  free (copy);
+  return true;
+}
+
 static size_t
 elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
 {
@@ -9699,6 +10077,7 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
   size_t i, ret, sort_elt, ext_size;
   bfd_byte *sort, *s_non_relative, *p;
   struct elf_link_sort_rela *sq;
+  struct elf_radix_sort_key *keys;
   const struct elf_backend_data *bed = get_elf_backend_data (abfd);
   int i2e = bed->s->int_rels_per_ext_rel;
   unsigned int opb = bfd_octets_per_byte (abfd, NULL);
@@ -9920,7 +10299,23 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
 	  }
       }
 
-  qsort (sort, count, sort_elt, elf_link_sort_cmp1);
+  /* Sort the relocs by the same keys as elf_link_sort_cmp1 and
+     elf_link_sort_cmp2, with a radix sort if we have the memory for
+     it.  */
+  keys = (struct elf_radix_sort_key *) bfd_malloc (count * sizeof (*keys));
+
+  for (i = 0, p = sort; keys != NULL && i < count; i++, p += sort_elt)
+    {
+      struct elf_link_sort_rela *s = (struct elf_link_sort_rela *) p;
+
+      keys[i].k[0] = s->type != reloc_class_relative;
+      keys[i].k[1] = s->rela->r_info & r_sym_mask;
+      keys[i].k[2] = s->rela->r_offset;
+      keys[i].index = i;
+    }
+  if (keys == NULL
+      || !elf_link_sort_by_keys (info, sort, count, sort_elt, keys, 3))
+    qsort (sort, count, sort_elt, elf_link_sort_cmp1);
 
   for (i = 0, p = sort; i < count; i++, p += sort_elt)
     {
@@ -9940,7 +10335,21 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
       sp->u.offset = sq->rela->r_offset;
     }
 
-  qsort (s_non_relative, count - ret, sort_elt, elf_link_sort_cmp2);
+  for (i = 0, p = s_non_relative; keys != NULL && i < count - ret;
+       i++, p += sort_elt)
+    {
+      struct elf_link_sort_rela *s = (struct elf_link_sort_rela *) p;
+
+      keys[i].k[0] = s->type;
+      keys[i].k[1] = s->u.offset;
+      keys[i].k[2] = s->rela->r_offset;
+      keys[i].index = i;
+    }
+  if (keys == NULL
+      || !elf_link_sort_by_keys (info, s_non_relative, count - ret,
+				 sort_elt, keys, 3))
+    qsort (s_non_relative, count - ret, sort_elt, elf_link_sort_cmp2);
+  free (keys);
 
   struct elf_link_hash_table *htab = elf_hash_table (info);
   if (htab->srelplt && htab->srelplt->output_section == dynamic_relocs)
@@ -11033,6 +11442,401 @@ _bfd_elf_check_kept_section (asection *sec, struct bfd_link_info *info)
   return kept;
 }
 
+/* With --threads, the contents of input sections are read ahead of
+   elf_link_input_bfd by other threads, while the calling thread
+   relocates the input BFDs before them.  The relocation itself stays
+   on the calling thread, since the backend relocate_section
+   functions update GOT, PLT and dynamic relocation state shared by
+   all input BFDs, and since BFD's own file handling is not thread
+   safe; the other threads only pread the raw contents through a
+   private file descriptor.  The contents read are the same bytes
+   that bfd_get_full_section_contents would have returned, so the
+   output does not change.  */
+
+/* Read ahead at most this many input BFDs, and stop adding input
+   BFDs once this many bytes are being read.  */
+#define ELF_PREFETCH_MAX_BFDS 64
+#define ELF_PREFETCH_MAX_BYTES (32 * 1024 * 1024)
+
+/* The contents read ahead for one input section.  */
+
+struct elf_prefetch_section
+{
+  /* The position of the contents in the file, and their size.  */
+  file_ptr pos;
+  bfd_size_type size;
+  /* The contents, or NULL if they are not read ahead or could not
+     be read.  */
+  bfd_byte *contents;
+};
+
+/* The contents read ahead for one input BFD.  */
+
+struct elf_prefetch_bfd
+{
+  /* The descriptor to read from, or -1.  The thread reading the
+     contents closes it.  */
+  int fd;
+  /* The sections, indexed by section index.  */
+  unsigned int count;
+  struct elf_prefetch_section *sections;
+};
+
+/* A run of input BFDs being read ahead.  */
+
+struct elf_prefetch_batch
+{
+  /* The threads reading the contents, or NULL once they are done.  */
+  struct bfd_parallel_work *work;
+  /* The index in elf_link_prefetch ORDER of the first input BFD, and
+     the number of input BFDs.  */
+  size_t first;
+  size_t count;
+  struct elf_prefetch_bfd *bfds;
+};
+
+struct elf_link_prefetch
+{
+  /* The number of threads to use.  */
+  unsigned int threads;
+  /* The input BFDs, in the order that elf_link_input_bfd sees them.  */
+  bfd **order;
+  size_t count;
+  /* The index in ORDER of the next input BFD to be linked.  */
+  size_t next;
+  /* The run of input BFDs being linked, and the next run.  */
+  struct elf_prefetch_batch current;
+  struct elf_prefetch_batch upcoming;
+};
+
+/* Read the contents of the sections of input BFD I of a batch.  This
+   runs on another thread, and touches nothing but PB.  */
+
+static void
+elf_prefetch_read_bfd (void *data, size_t i)
+{
+  struct elf_prefetch_bfd *pb = (struct elf_prefetch_bfd *) data + i;
+  unsigned int j;
+
+  if (pb->fd < 0)
+    return;
+
+  for (j = 0; j < pb->count; j++)
+    {
+      struct elf_prefetch_section *ps = &pb->sections[j];
+      bfd_size_type done = 0;
+
+      if (ps->contents == NULL)
+	continue;
+
+#ifdef HAVE_PREAD
+      while (done < ps->size)
+	{
+	  ssize_t n = pread (pb->fd, ps->contents + done, ps->size - done,
+			     ps->pos + done);
+	  if (n < 0 && errno == EINTR)
+	    continue;
+	  if (n <= 0)
+	    break;
+	  done += n;
+	}
+#endif
+      if (done != ps->size)
+	{
+	  free (ps->contents);
+	  ps->contents = NULL;
+	}
+    }
+
+  close (pb->fd);
+  pb->fd = -1;
+}
+
+/* Decide which sections of INPUT_BFD elf_link_input_bfd will read
+   with bfd_get_full_section_contents, and set up PB to read them
+   ahead.  Return the number of bytes to be read.  */
+
+static bfd_size_type
+elf_prefetch_setup_bfd (struct elf_final_link_info *flinfo,
+			bfd *input_bfd, struct elf_prefetch_bfd *pb)
+{
+  const struct elf_backend_data *bed;
+  bfd_size_type total = 0;
+  ufile_ptr origin;
+  asection *o;
+
+  pb->fd = -1;
+  pb->count = 0;
+  pb->sections = NULL;
+
+  /* elf_link_input_bfd does not read the contents of dynamic
+     objects, and we can only read them for ourselves if the target
+     reads them straight from the file.  */
+  if ((input_bfd->flags & DYNAMIC) != 0
+      || (input_bfd->xvec->_bfd_get_section_contents
+	  != _bfd_generic_get_section_contents)
+      || input_bfd->section_count == 0)
+    return 0;
+
+  pb->sections = ((struct elf_prefetch_section *)
+		  bfd_zmalloc (input_bfd->section_count
+			       * sizeof (*pb->sections)));
+  if (pb->sections == NULL)
+    return 0;
+  pb->count = input_bfd->section_count;
+
+  pb->fd = _bfd_cache_dup_fd (input_bfd, &origin);
+  if (pb->fd < 0)
+    return 0;
+
+  bed = get_elf_backend_data (flinfo->output_bfd);
+  for (o = input_bfd->sections; o != NULL; o = o->next)
+    {
+      struct elf_prefetch_section *ps;
+      bfd_size_type readsz;
+      bfd_size_type allocsz;
+
+      /* These are the tests elf_link_input_bfd makes before calling
+	 bfd_get_full_section_contents, and the cases which it and
+	 bfd_get_section_contents handle without reading the file.  */
+      if (!o->linker_mark
+	  || (o->flags & (SEC_HAS_CONTENTS | SEC_LINKER_CREATED
+			  | SEC_IN_MEMORY | SEC_CONSTRUCTOR)) != SEC_HAS_CONTENTS
+	  || elf_section_data (o)->this_hdr.contents != NULL
+	  || ((o->flags & SEC_RELOC) == 0
+	      && !bed->elf_backend_write_section
+	      && o->sec_info_type == SEC_INFO_TYPE_MERGE)
+	  || o->compress_status != COMPRESS_SECTION_NONE
+	  || o->filepos < 0
+	  || o->index >= pb->count)
+	continue;
+
+      readsz = bfd_get_section_limit_octets (input_bfd, o);
+      allocsz = bfd_get_section_alloc_size (input_bfd, o);
+      if (readsz == 0
+	  || allocsz < readsz
+	  || (input_bfd->my_archive != NULL
+	      && !bfd_is_thin_archive (input_bfd->my_archive)
+	      && (ufile_ptr) o->filepos + readsz > arelt_size (input_bfd)))
+	continue;
+
+      ps = &pb->sections[o->index];
+      ps->contents = (bfd_byte *) bfd_malloc (allocsz);
+      if (ps->contents == NULL)
+	continue;
+      if (allocsz > readsz)
+	memset (ps->contents + readsz, 0, allocsz - readsz);
+      ps->pos = origin + o->filepos;
+      ps->size = readsz;
+      total += allocsz;
+    }
+
+  return total;
+}
+
+/* Free the contents read ahead for PB.  */
+
+static void
+elf_prefetch_free_bfd (struct elf_prefetch_bfd *pb)
+{
+  unsigned int j;
+
+  if (pb->fd >= 0)
+    close (pb->fd);
+  pb->fd = -1;
+  for (j = 0; j < pb->count; j++)
+    free (pb->sections[j].contents);
+  free (pb->sections);
+  pb->sections = NULL;
+  pb->count = 0;
+}
+
+/* Start reading ahead the run of input BFDs from FIRST in the link
+   order into BATCH, using THREADS threads.  */
+
+static void
+elf_prefetch_start_batch (struct elf_final_link_info *flinfo,
+			  struct elf_prefetch_batch *batch,
+			  size_t first, unsigned int threads)
+{
+  struct elf_link_prefetch *pf = flinfo->prefetch;
+  bfd_size_type total = 0;
+  size_t n;
+
+  memset (batch, 0, sizeof (*batch));
+  batch->first = first;
+  n = pf->count - first;
+  if (n == 0)
+    return;
+  if (n > ELF_PREFETCH_MAX_BFDS)
+    n = ELF_PREFETCH_MAX_BFDS;
+  batch->bfds = ((struct elf_prefetch_bfd *)
+		 bfd_malloc (n * sizeof (*batch->bfds)));
+  if (batch->bfds == NULL)
+    return;
+
+  while (batch->count < n && total < ELF_PREFETCH_MAX_BYTES)
+    {
+      total += elf_prefetch_setup_bfd (flinfo, pf->order[first + batch->count],
+				       &batch->bfds[batch->count]);
+      batch->count++;
+    }
+
+  batch->work = _bfd_parallel_start (threads, batch->count,
+				     elf_prefetch_read_bfd, batch->bfds);
+}
+
+/* Wait for BATCH to be read, and free it.  */
+
+static void
+elf_prefetch_free_batch (struct elf_prefetch_batch *batch)
+{
+  size_t i;
+
+  _bfd_parallel_finish (batch->work);
+  batch->work = NULL;
+  for (i = 0; i < batch->count; i++)
+    elf_prefetch_free_bfd (&batch->bfds[i]);
+  free (batch->bfds);
+  memset (batch, 0, sizeof (*batch));
+}
+
+/* Set up FLINFO to read input section contents ahead of
+   elf_link_input_bfd, if the link may use threads.  This must be
+   called with output_has_begun clear on all input BFDs, and leaves
+   it that way.  */
+
+static void
+elf_link_prefetch_init (struct elf_final_link_info *flinfo)
+{
+  struct bfd_link_info *info = flinfo->info;
+  bfd *obfd = flinfo->output_bfd;
+  const struct elf_backend_data *bed = get_elf_backend_data (obfd);
+  struct elf_link_prefetch *pf;
+  struct bfd_link_order *p;
+  size_t count;
+  asection *o;
+  bfd *sub;
+
+  if (!BFD_SUPPORTS_THREADS || info->threads <= 1)
+    return;
+
+  pf = (struct elf_link_prefetch *) bfd_zmalloc (sizeof (*pf));
+  if (pf == NULL)
+    return;
+
+  count = 0;
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    count++;
+  pf->order = (bfd **) bfd_malloc (count * sizeof (*pf->order));
+  if (pf->order == NULL)
+    {
+      free (pf);
+      return;
+    }
+
+  /* Find the input BFDs in the order that bfd_elf_final_link links
+     them, which is the order of their first input section in the
+     output.  */
+  for (o = obfd->sections; o != NULL; o = o->next)
+    for (p = o->map_head.link_order; p != NULL; p = p->next)
+      if (p->type == bfd_indirect_link_order
+	  && (bfd_get_flavour ((sub = p->u.indirect.section->owner))
+	      == bfd_target_elf_flavour)
+	  && elf_elfheader (sub)->e_ident[EI_CLASS] == bed->s->elfclass
+	  && !sub->output_has_begun
+	  && pf->count < count)
+	{
+	  pf->order[pf->count++] = sub;
+	  sub->output_has_begun = true;
+	}
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    sub->output_has_begun = false;
+
+  pf->threads = info->threads;
+  flinfo->prefetch = pf;
+
+  /* Start on the first run straight away; elf_link_prefetch_next
+     waits for it when the first input BFD is linked.  */
+  elf_prefetch_start_batch (flinfo, &pf->upcoming, 0, pf->threads);
+}
+
+/* Note that INPUT_BFD is about to be linked, and set up FLINFO to use
+   the contents read ahead for it.  */
+
+static void
+elf_link_prefetch_next (struct elf_final_link_info *flinfo, bfd *input_bfd)
+{
+  struct elf_link_prefetch *pf = flinfo->prefetch;
+
+  /* Drop the contents of the previous input BFD.  */
+  if (flinfo->prefetched != NULL)
+    elf_prefetch_free_bfd (flinfo->prefetched);
+  flinfo->prefetched = NULL;
+
+  if (pf == NULL
+      || pf->next >= pf->count
+      || pf->order[pf->next] != input_bfd)
+    return;
+
+  if (pf->next >= pf->current.first + pf->current.count)
+    {
+      /* Move on to the next run, wait for it to be read, and start
+	 reading the one after it while this one is being linked.  */
+      elf_prefetch_free_batch (&pf->current);
+      pf->current = pf->upcoming;
+      _bfd_parallel_finish (pf->current.work);
+      pf->current.work = NULL;
+      elf_prefetch_start_batch (flinfo, &pf->upcoming,
+				pf->current.first + pf->current.count,
+				pf->threads - 1);
+    }
+
+  if (pf->next >= pf->current.first
+      && pf->next < pf->current.first + pf->current.count)
+    flinfo->prefetched = &pf->current.bfds[pf->next - pf->current.first];
+  pf->next++;
+}
+
+/* Return the contents of input section O read ahead for the input
+   BFD being linked, or NULL if they were not read.  */
+
+static bfd_byte *
+elf_link_prefetched_contents (struct elf_final_link_info *flinfo,
+			      bfd *input_bfd, asection *o)
+{
+  struct elf_prefetch_section *ps;
+
+  if (flinfo->prefetched == NULL
+      || o->index >= flinfo->prefetched->count)
+    return NULL;
+
+  ps = &flinfo->prefetched->sections[o->index];
+  if (ps->contents == NULL
+      || o->compress_status != COMPRESS_SECTION_NONE
+      || (o->flags & SEC_IN_MEMORY) != 0
+      || ps->size != bfd_get_section_limit_octets (input_bfd, o))
+    return NULL;
+  return ps->contents;
+}
+
+/* Free everything read ahead.  */
+
+static void
+elf_link_prefetch_free (struct elf_final_link_info *flinfo)
+{
+  struct elf_link_prefetch *pf = flinfo->prefetch;
+
+  flinfo->prefetched = NULL;
+  if (pf == NULL)
+    return;
+  elf_prefetch_free_batch (&pf->current);
+  elf_prefetch_free_batch (&pf->upcoming);
+  free (pf->order);
+  free (pf);
+  flinfo->prefetch = NULL;
+}
+
 /* Link an input file into the linker output file.  This function
    handles all the sections and relocations of the input file at once.
    This is so that we only have to read the local symbols once, and
@@ -11402,9 +12206,13 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 	contents = NULL;
       else
 	{
-	  contents = flinfo->contents;
-	  if (! bfd_get_full_section_contents (input_bfd, o, &contents))
-	    return false;
+	  contents = elf_link_prefetched_contents (flinfo, input_bfd, o);
+	  if (contents == NULL)
+	    {
+	      contents = flinfo->contents;
+	      if (! bfd_get_full_section_contents (input_bfd, o, &contents))
+		return false;
+	    }
 	}
 
       if ((o->flags & SEC_RELOC) != 0)
@@ -12254,6 +13062,7 @@ elf_final_link_free (bfd *obfd, struct elf_final_link_info *flinfo)
 {
   asection *o;
 
+  elf_link_prefetch_free (flinfo);
   if (flinfo->symstrtab != NULL)
     _bfd_elf_strtab_free (flinfo->symstrtab);
   free (flinfo->contents);
@@ -12274,6 +13083,17 @@ elf_final_link_free (bfd *obfd, struct elf_final_link_info *flinfo)
     }
 }
 
+/* Tell the linker that phase PHASE of the final link, working on ABFD
+   if not NULL, starts or ends.  */
+
+static void
+elf_link_trace (struct bfd_link_info *info, const char *phase, bfd *abfd,
+		bool start)
+{
+  if (info->callbacks->trace_phase != NULL)
+    info->callbacks->trace_phase (phase, abfd, start);
+}
+
 /* Do the final step of an ELF link.  */
 
 bool
@@ -12806,6 +13626,7 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 
   for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
     sub->output_has_begun = false;
+  elf_link_prefetch_init (&flinfo);
   for (o = abfd->sections; o != NULL; o = o->next)
     {
       for (p = o->map_head.link_order; p != NULL; p = p->next)
@@ -12817,7 +13638,11 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 	    {
 	      if (! sub->output_has_begun)
 		{
-		  if (! elf_link_input_bfd (&flinfo, sub))
+		  elf_link_prefetch_next (&flinfo, sub);
+		  elf_link_trace (info, "relocate", sub, true);
+		  bool ok = elf_link_input_bfd (&flinfo, sub);
+		  elf_link_trace (info, "relocate", sub, false);
+		  if (!ok)
 		    goto error_return;
 		  sub->output_has_begun = true;
 		}
@@ -12868,6 +13693,7 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 	    }
 	}
     }
+  elf_link_prefetch_free (&flinfo);
 
   /* Free symbol buffer if needed.  */
   if (!info->reduce_memory_overheads)
@@ -12888,6 +13714,7 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
      prior to any global symbols.  FIXME: We should only do this if
      some global symbols were, in fact, converted to become local.
      FIXME: Will this work correctly with the Irix 5 linker?  */
+  elf_link_trace (info, "output symbols", NULL, true);
   eoinfo.failed = false;
   eoinfo.flinfo = &flinfo;
   eoinfo.localsyms = true;
@@ -13049,6 +13876,7 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
       ret = false;
       goto return_local_hash_table;
     }
+  elf_link_trace (info, "output symbols", NULL, false);
 
   /* Now we know the size of the symtab section.  */
   if (bfd_get_symcount (abfd) > 0)
@@ -13144,7 +13972,11 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 
   relativecount = 0;
   if (dynamic && info->combreloc && dynobj != NULL)
-    relativecount = elf_link_sort_relocs (abfd, info, &reldyn);
+    {
+      elf_link_trace (info, "sort dynamic relocs", NULL, true);
+      relativecount = elf_link_sort_relocs (abfd, info, &reldyn);
+      elf_link_trace (info, "sort dynamic relocs", NULL, false);
+    }
 
   relr_entsize = 0;
   if (htab->srelrdyn != NULL
@@ -13817,20 +14649,27 @@ _bfd_elf_gc_mark_reloc (struct bfd_link_info *info,
   return true;
 }
 
-/* The mark phase of garbage collection.  For a given section, mark
-   it and any sections in this section's group, and all the sections
-   which define symbols to which it refers.  */
+/* A section marked by _bfd_elf_gc_mark, and the gc_mark_hook to use
+   when following its relocs.  */
 
-bool
-_bfd_elf_gc_mark (struct bfd_link_info *info,
-		  asection *sec,
-		  elf_gc_mark_hook_fn gc_mark_hook)
+struct elf_gc_mark_item
+{
+  asection *sec;
+  elf_gc_mark_hook_fn gc_mark_hook;
+};
+
+/* Follow the relocs of section SEC, which has been marked, and mark
+   any sections in SEC's group and the sections which define symbols
+   to which it refers.  */
+
+static bool
+elf_gc_mark_section (struct bfd_link_info *info,
+		     asection *sec,
+		     elf_gc_mark_hook_fn gc_mark_hook)
 {
   bool ret;
   asection *group_sec, *eh_frame;
 
-  sec->gc_mark = 1;
-
   /* Mark all the sections in the group.  */
   group_sec = elf_section_data (sec)->next_in_group;
   if (group_sec && !group_sec->gc_mark)
@@ -13883,6 +14722,56 @@ _bfd_elf_gc_mark (struct bfd_link_info *info,
   return ret;
 }
 
+/* The mark phase of garbage collection.  For a given section, mark
+   it and any sections in this section's group, and all the sections
+   which define symbols to which it refers.
+
+   Rather than recursing through the relocs, which can run out of
+   stack on long chains of references, sections marked while another
+   is being followed are pushed on a stack in the hash table, and the
+   outermost call follows them all before returning.  */
+
+bool
+_bfd_elf_gc_mark (struct bfd_link_info *info,
+		  asection *sec,
+		  elf_gc_mark_hook_fn gc_mark_hook)
+{
+  struct elf_link_hash_table *htab = elf_hash_table (info);
+  struct elf_gc_mark_item *item;
+  bool ret;
+
+  sec->gc_mark = 1;
+
+  if (htab->gc_mark_count >= htab->gc_mark_alloc)
+    {
+      size_t alloc = htab->gc_mark_alloc * 2 + 64;
+
+      item = (struct elf_gc_mark_item *)
+	bfd_realloc (htab->gc_mark_stack, alloc * sizeof (*item));
+      if (item == NULL)
+	return false;
+      htab->gc_mark_stack = item;
+      htab->gc_mark_alloc = alloc;
+    }
+  item = &htab->gc_mark_stack[htab->gc_mark_count++];
+  item->sec = sec;
+  item->gc_mark_hook = gc_mark_hook;
+
+  if (htab->gc_marking)
+    return true;
+
+  htab->gc_marking = true;
+  ret = true;
+  while (ret && htab->gc_mark_count > 0)
+    {
+      item = &htab->gc_mark_stack[--htab->gc_mark_count];
+      ret = elf_gc_mark_section (info, item->sec, item->gc_mark_hook);
+    }
+  htab->gc_mark_count = 0;
+  htab->gc_marking = false;
+  return ret;
+}
+
 /* Scan and mark sections in a special or debug section group.  */
 
 static void
@@ -14062,54 +14951,371 @@ _bfd_elf_gc_mark_extra_sections (struct bfd_link_info *info,
   return true;
 }
 
+/* Return TRUE if SUB is an input BFD whose sections are garbage
+   collected when linking to ABFD.  */
+
 static bool
-elf_gc_sweep (bfd *abfd, struct bfd_link_info *info)
+elf_gc_input_bfd_p (bfd *abfd, bfd *sub, struct bfd_link_info *info)
 {
-  bfd *sub;
   const struct elf_backend_data *bed = get_elf_backend_data (abfd);
 
-  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+  return (bfd_get_flavour (sub) == bfd_target_elf_flavour
+	  && elf_object_id (sub) == elf_hash_table_id (elf_hash_table (info))
+	  && (*bed->relocs_compatible) (sub->xvec, abfd->xvec)
+	  && sub->sections != NULL
+	  && sub->sections->sec_info_type != SEC_INFO_TYPE_JUST_SYMS);
+}
+
+/* With --threads, the relocs of the input sections are read and
+   swapped in by other threads before the mark phase, rather than one
+   section at a time as the mark phase reaches them.  The other
+   threads only pread the relocs through a private file descriptor
+   and swap them in; the calling thread allocates the memory for
+   them, and installs them as the cached relocs of their section, as
+   _bfd_elf_link_info_read_relocs would have done.  Relocs that can't
+   be read this way, or that fail the checks made by
+   elf_link_read_relocs_from_section, are left to be read as before,
+   so that any errors are reported in the usual way.  */
+
+/* The relocs of one input section to be read by another thread.  */
+
+struct elf_gc_relocs_read
+{
+  asection *sec;
+  /* The REL and RELA reloc sections of SEC, either of which may be
+     NULL.  */
+  Elf_Internal_Shdr *hdr[2];
+  /* Where to put the relocs.  */
+  Elf_Internal_Rela *relocs;
+  /* Whether they were all read and swapped in.  */
+  bool ok;
+};
+
+/* The relocs of one input BFD to be read by another thread.  */
+
+struct elf_gc_bfd_read
+{
+  bfd *abfd;
+  /* The descriptor to read from, which the reading thread closes,
+     and the offset of ABFD within the file.  */
+  int fd;
+  ufile_ptr origin;
+  /* The number of symbols in the symbol table of ABFD.  */
+  size_t nsyms;
+  /* The sections to read.  */
+  struct elf_gc_relocs_read *secs;
+  unsigned int count;
+};
+
+/* Read the external relocs in HDR of PB->ABFD
+   and swap them in to INTERNAL_RELOCS, which has room for LIMIT of
+   them.  Return the number of internal relocs written, or -1 if they
+   could not be read or are bad.  This runs on another thread.  */
+
+static bfd_signed_vma
+elf_gc_read_reloc_section (struct elf_gc_bfd_read *pb,
+			   Elf_Internal_Shdr *hdr,
+			   Elf_Internal_Rela *internal_relocs,
+			   bfd_size_type limit)
+{
+  const struct elf_backend_data *bed = get_elf_backend_data (pb->abfd);
+  void (*swap_in) (bfd *, const bfd_byte *, Elf_Internal_Rela *);
+  bfd_byte *external_relocs;
+  const bfd_byte *erela, *erelaend;
+  bfd_size_type done = 0, count = 0;
+  bool ok = true;
+
+  if (hdr->sh_entsize == bed->s->sizeof_rel)
+    swap_in = bed->s->swap_reloc_in;
+  else if (hdr->sh_entsize == bed->s->sizeof_rela)
+    swap_in = bed->s->swap_reloca_in;
+  else
+    return -1;
+
+  external_relocs = (bfd_byte *) malloc (hdr->sh_size);
+  if (external_relocs == NULL)
+    return -1;
+
+#ifdef HAVE_PREAD
+  while (done < hdr->sh_size)
+    {
+      ssize_t n = pread (pb->fd, external_relocs + done,
+			 hdr->sh_size - done,
+			 pb->origin + hdr->sh_offset + done);
+      if (n < 0 && errno == EINTR)
+	continue;
+      if (n <= 0)
+	break;
+      done += n;
+    }
+#endif
+  if (done != hdr->sh_size)
+    {
+      free (external_relocs);
+      return -1;
+    }
+
+  erela = external_relocs;
+  erelaend = erela + hdr->sh_size - hdr->sh_entsize;
+  while (erela <= erelaend)
+    {
+      bfd_vma r_symndx;
+
+      if (count + bed->s->int_rels_per_ext_rel > limit)
+	{
+	  ok = false;
+	  break;
+	}
+      (*swap_in) (pb->abfd, erela, internal_relocs + count);
+      r_symndx = ELF32_R_SYM (internal_relocs[count].r_info);
+      if (bed->s->arch_size == 64)
+	r_symndx >>= 24;
+      if (pb->nsyms > 0
+	  ? (size_t) r_symndx >= pb->nsyms
+	  : r_symndx != STN_UNDEF)
+	{
+	  ok = false;
+	  break;
+	}
+      count += bed->s->int_rels_per_ext_rel;
+      erela += hdr->sh_entsize;
+    }
+  free (external_relocs);
+  return ok ? (bfd_signed_vma) count : -1;
+}
+
+/* Read the relocs of the sections of input BFD I.  This runs on
+   another thread, and touches nothing but the relocs being read.  */
+
+static void
+elf_gc_read_bfd_relocs (void *data, size_t i)
+{
+  struct elf_gc_bfd_read *pb = (struct elf_gc_bfd_read *) data + i;
+  const struct elf_backend_data *bed = get_elf_backend_data (pb->abfd);
+  unsigned int j;
+
+  for (j = 0; j < pb->count; j++)
     {
+      struct elf_gc_relocs_read *pr = &pb->secs[j];
+      bfd_size_type nrels
+	= pr->sec->reloc_count * bed->s->int_rels_per_ext_rel;
+      bfd_size_type done = 0;
+      unsigned int k;
+
+      pr->ok = true;
+      for (k = 0; k < 2 && pr->ok; k++)
+	if (pr->hdr[k] != NULL)
+	  {
+	    bfd_signed_vma n
+	      = elf_gc_read_reloc_section (pb, pr->hdr[k], pr->relocs + done,
+					   nrels - done);
+	    if (n < 0)
+	      pr->ok = false;
+	    else
+	      done += n;
+	  }
+    }
+
+  close (pb->fd);
+  pb->fd = -1;
+}
+
+/* Read the relocs of the input sections to be garbage collected when
+   linking to ABFD, using other threads.  */
+
+static void
+elf_gc_read_relocs (bfd *abfd, struct bfd_link_info *info)
+{
+  const struct elf_backend_data *bed;
+  struct elf_gc_bfd_read *bfds;
+  size_t nbfds, i;
+  bool full;
+  bfd *sub;
+
+  if (!BFD_SUPPORTS_THREADS
+      || info->threads <= 1
+      || !_bfd_link_keep_memory (info))
+    return;
+
+  nbfds = 0;
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    nbfds++;
+  bfds = (struct elf_gc_bfd_read *) bfd_zmalloc (nbfds * sizeof (*bfds));
+  if (bfds == NULL)
+    return;
+
+  /* Allocate the memory for the relocs here, since bfd_alloc may only
+     be used on this thread.  Only allocated sections are read, since
+     the relocs of other sections are seldom followed.  Stop once the
+     relocs would take the cache over max_cache_size; the rest are read
+     on demand as usual.  */
+  nbfds = 0;
+  full = false;
+  for (sub = info->input_bfds; sub != NULL && !full; sub = sub->link.next)
+    {
+      struct elf_gc_bfd_read *pb = &bfds[nbfds];
+      unsigned int count;
       asection *o;
 
-      if (bfd_get_flavour (sub) != bfd_target_elf_flavour
-	  || elf_object_id (sub) != elf_hash_table_id (elf_hash_table (info))
-	  || !(*bed->relocs_compatible) (sub->xvec, abfd->xvec))
+      if (!elf_gc_input_bfd_p (abfd, sub, info))
 	continue;
-      o = sub->sections;
-      if (o == NULL || o->sec_info_type == SEC_INFO_TYPE_JUST_SYMS)
+
+      count = 0;
+      for (o = sub->sections; o != NULL; o = o->next)
+	if ((o->flags & (SEC_RELOC | SEC_ALLOC | SEC_EXCLUDE))
+	    == (SEC_RELOC | SEC_ALLOC)
+	    && o->reloc_count > 0
+	    && elf_section_data (o)->relocs == NULL)
+	  count++;
+      if (count == 0)
 	continue;
 
+      pb->secs = (struct elf_gc_relocs_read *)
+	bfd_zmalloc (count * sizeof (*pb->secs));
+      if (pb->secs == NULL)
+	continue;
+      pb->fd = _bfd_cache_dup_fd (sub, &pb->origin);
+      if (pb->fd < 0)
+	{
+	  free (pb->secs);
+	  pb->secs = NULL;
+	  continue;
+	}
+      pb->abfd = sub;
+      pb->nsyms = NUM_SHDR_ENTRIES (&elf_tdata (sub)->symtab_hdr);
+      bed = get_elf_backend_data (sub);
+
       for (o = sub->sections; o != NULL; o = o->next)
+	if ((o->flags & (SEC_RELOC | SEC_ALLOC | SEC_EXCLUDE))
+	    == (SEC_RELOC | SEC_ALLOC)
+	    && o->reloc_count > 0
+	    && elf_section_data (o)->relocs == NULL)
+	  {
+	    struct elf_gc_relocs_read *pr = &pb->secs[pb->count];
+	    bfd_size_type size = (o->reloc_count * bed->s->int_rels_per_ext_rel
+				  * sizeof (Elf_Internal_Rela));
+
+	    if (info->cache_size + size > info->max_cache_size)
+	      {
+		full = true;
+		break;
+	      }
+	    pr->relocs = (Elf_Internal_Rela *) bfd_alloc (sub, size);
+	    if (pr->relocs == NULL)
+	      break;
+	    info->cache_size += size;
+	    pr->sec = o;
+	    pr->hdr[0] = elf_section_data (o)->rel.hdr;
+	    pr->hdr[1] = elf_section_data (o)->rela.hdr;
+	    pb->count++;
+	  }
+      nbfds++;
+    }
+
+  _bfd_parallel_for (info->threads, nbfds, elf_gc_read_bfd_relocs, bfds);
+
+  for (i = 0; i < nbfds; i++)
+    {
+      unsigned int j;
+
+      for (j = 0; j < bfds[i].count; j++)
+	if (bfds[i].secs[j].ok)
+	  elf_section_data (bfds[i].secs[j].sec)->relocs
+	    = bfds[i].secs[j].relocs;
+      free (bfds[i].secs);
+    }
+  free (bfds);
+}
+
+/* Remove the sections of input BFD SUB that were not marked.  */
+
+static void
+elf_gc_sweep_bfd (bfd *sub, struct bfd_link_info *info)
+{
+  asection *o;
+
+  for (o = sub->sections; o != NULL; o = o->next)
+    {
+      /* When any section in a section group is kept, we keep all
+	 sections in the section group.  If the first member of
+	 the section group is excluded, we will also exclude the
+	 group section.  */
+      if (o->flags & SEC_GROUP)
 	{
-	  /* When any section in a section group is kept, we keep all
-	     sections in the section group.  If the first member of
-	     the section group is excluded, we will also exclude the
-	     group section.  */
-	  if (o->flags & SEC_GROUP)
-	    {
-	      asection *first = elf_next_in_group (o);
-	      o->gc_mark = first->gc_mark;
-	    }
+	  asection *first = elf_next_in_group (o);
+	  o->gc_mark = first->gc_mark;
+	}
 
-	  if (o->gc_mark)
-	    continue;
+      if (o->gc_mark)
+	continue;
 
-	  /* Skip sweeping sections already excluded.  */
-	  if (o->flags & SEC_EXCLUDE)
-	    continue;
+      /* Skip sweeping sections already excluded.  */
+      if (o->flags & SEC_EXCLUDE)
+	continue;
 
-	  /* Since this is early in the link process, it is simple
-	     to remove a section from the output.  */
-	  o->flags |= SEC_EXCLUDE;
+      /* Since this is early in the link process, it is simple
+	 to remove a section from the output.  */
+      o->flags |= SEC_EXCLUDE;
 
-	  if (info->print_gc_sections && o->size != 0)
-	    /* xgettext:c-format */
-	    _bfd_error_handler (_("removing unused section '%pA' in file '%pB'"),
-				o, sub);
+      if (info->print_gc_sections && o->size != 0)
+	/* xgettext:c-format */
+	_bfd_error_handler (_("removing unused section '%pA' in file '%pB'"),
+			    o, sub);
+    }
+}
+
+/* The input BFDs swept by elf_gc_sweep_one.  */
+
+struct elf_gc_sweep_info
+{
+  struct bfd_link_info *info;
+  bfd **bfds;
+};
+
+/* Sweep input BFD I.  This runs on another thread.  */
+
+static void
+elf_gc_sweep_one (void *data, size_t i)
+{
+  struct elf_gc_sweep_info *sw = (struct elf_gc_sweep_info *) data;
+
+  elf_gc_sweep_bfd (sw->bfds[i], sw->info);
+}
+
+static bool
+elf_gc_sweep (bfd *abfd, struct bfd_link_info *info)
+{
+  bfd *sub;
+
+  /* Each input BFD can be swept on its own, except that the removed
+     sections must be reported in order.  */
+  if (BFD_SUPPORTS_THREADS
+      && info->threads > 1
+      && !info->print_gc_sections)
+    {
+      struct elf_gc_sweep_info sw;
+      size_t count = 0;
+
+      for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+	count++;
+      sw.info = info;
+      sw.bfds = (bfd **) bfd_malloc (count * sizeof (*sw.bfds));
+      if (sw.bfds != NULL)
+	{
+	  count = 0;
+	  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+	    if (elf_gc_input_bfd_p (abfd, sub, info))
+	      sw.bfds[count++] = sub;
+	  _bfd_parallel_for (info->threads, count, elf_gc_sweep_one, &sw);
+	  free (sw.bfds);
+	  return true;
 	}
     }
 
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    if (elf_gc_input_bfd_p (abfd, sub, info))
+      elf_gc_sweep_bfd (sub, info);
+
   return true;
 }
 
@@ -14342,6 +15548,9 @@ bfd_elf_gc_sections (bfd *abfd, struct bfd_link_info *info)
   bed->gc_keep (info);
   htab = elf_hash_table (info);
 
+  /* With threads, read the relocs that the mark phase will need.  */
+  elf_gc_read_relocs (abfd, info);
+
   /* Try to parse each bfd's .eh_frame section.  Point elf_eh_frame_section
      at the .eh_frame section if we can mark the FDEs individually.  */
   for (sub = info->input_bfds;
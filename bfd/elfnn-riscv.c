@@ -4246,6 +4246,106 @@ riscv_update_pcgp_relocs (riscv_pcgp_relocs *p, asection *deleted_sec,
     }
 }
 
+/* Call ADJUST (H, DATA) once for each global symbol H of ABFD that is
+   defined in SEC.  Return false if we run out of memory.
+
+   The '--wrap SYMBOL' option is causing a pain when the object file,
+   containing the definition of __wrap_SYMBOL, includes a direct
+   call to SYMBOL as well. Since both __wrap_SYMBOL and SYMBOL reference
+   the same symbol (which is __wrap_SYMBOL), but still exist as two
+   different symbols in 'sym_hashes', we don't want to adjust
+   the global symbol __wrap_SYMBOL twice.
+
+   The same problem occurs with symbols that are versioned_hidden, as
+   foo becomes an alias for foo@BAR, and hence they need the same
+   treatment.  Keep a set of the symbols already adjusted to catch
+   these.  */
+
+static bool
+riscv_adjust_global_syms (bfd *abfd, asection *sec,
+			  struct bfd_link_info *link_info,
+			  void (*adjust) (struct elf_link_hash_entry *, void *),
+			  void *data)
+{
+  struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (abfd);
+  Elf_Internal_Shdr *symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
+  unsigned int i, symcount;
+  htab_t seen = NULL;
+
+  symcount = ((symtab_hdr->sh_size / sizeof (ElfNN_External_Sym))
+	      - symtab_hdr->sh_info);
+
+  for (i = 0; i < symcount; i++)
+    if (link_info->wrap_hash != NULL
+	|| sym_hashes[i]->versioned != unversioned)
+      {
+	seen = htab_create (64, htab_hash_pointer, htab_eq_pointer, NULL);
+	if (seen == NULL)
+	  return false;
+	break;
+      }
+
+  for (i = 0; i < symcount; i++)
+    {
+      struct elf_link_hash_entry *sym_hash = sym_hashes[i];
+
+      if (!((sym_hash->root.type == bfd_link_hash_defined
+	     || sym_hash->root.type == bfd_link_hash_defweak)
+	    && sym_hash->root.u.def.section == sec))
+	continue;
+
+      if (seen != NULL)
+	{
+	  void **slot = htab_find_slot (seen, sym_hash, INSERT);
+
+	  if (slot == NULL)
+	    {
+	      htab_delete (seen);
+	      return false;
+	    }
+	  /* Don't adjust the symbol again.  */
+	  if (*slot != NULL)
+	    continue;
+	  *slot = sym_hash;
+	}
+
+      adjust (sym_hash, data);
+    }
+
+  if (seen != NULL)
+    htab_delete (seen);
+  return true;
+}
+
+/* The deletion of COUNT bytes at ADDR in a section that ended at
+   TOADDR, for riscv_adjust_global_sym.  */
+
+struct riscv_delete_adjust
+{
+  bfd_vma addr;
+  bfd_vma count;
+  bfd_vma toaddr;
+};
+
+/* Adjust global symbol H for the deletion described by DATA.  */
+
+static void
+riscv_adjust_global_sym (struct elf_link_hash_entry *h, void *data)
+{
+  struct riscv_delete_adjust *adj = (struct riscv_delete_adjust *) data;
+
+  /* As for local symbols, adjust the value if needed.  */
+  if (h->root.u.def.value > adj->addr
+      && h->root.u.def.value <= adj->toaddr)
+    h->root.u.def.value -= adj->count;
+
+  /* As for local symbols, adjust the size if needed.  */
+  else if (h->root.u.def.value <= adj->addr
+	   && h->root.u.def.value + h->size > adj->addr
+	   && h->root.u.def.value + h->size <= adj->toaddr)
+    h->size -= adj->count;
+}
+
 /* Delete some bytes, adjust relcocations and symbol table from a section.  */
 
 static bool
@@ -4254,24 +4354,19 @@ _riscv_relax_delete_bytes (bfd *abfd,
 			   bfd_vma addr,
 			   size_t count,
 			   struct bfd_link_info *link_info,
-			   riscv_pcgp_relocs *p,
-			   bfd_vma delete_total,
-			   bfd_vma toaddr)
+			   riscv_pcgp_relocs *p)
 {
-  unsigned int i, symcount;
-  struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (abfd);
+  unsigned int i;
+  bfd_vma toaddr = sec->size;
+  struct riscv_delete_adjust adj;
   Elf_Internal_Shdr *symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
   unsigned int sec_shndx = _bfd_elf_section_from_bfd_section (abfd, sec);
   struct bfd_elf_section_data *data = elf_section_data (sec);
   bfd_byte *contents = data->this_hdr.contents;
-  size_t bytes_to_move = toaddr - addr - count;
 
   /* Actually delete the bytes.  */
   sec->size -= count;
-  memmove (contents + addr, contents + addr + count + delete_total, bytes_to_move);
-
-  /* Still adjust relocations and symbols in non-linear times.  */
-  toaddr = sec->size + count;
+  memmove (contents + addr, contents + addr + count, toaddr - addr - count);
 
   /* Adjust the location of all of the relocs.  Note that we need not
      adjust the addends, since all PC-relative references must be against
@@ -4313,60 +4408,11 @@ _riscv_relax_delete_bytes (bfd *abfd,
     }
 
   /* Now adjust the global symbols defined in this section.  */
-  symcount = ((symtab_hdr->sh_size / sizeof (ElfNN_External_Sym))
-	      - symtab_hdr->sh_info);
-
-  for (i = 0; i < symcount; i++)
-    {
-      struct elf_link_hash_entry *sym_hash = sym_hashes[i];
-
-      /* The '--wrap SYMBOL' option is causing a pain when the object file,
-	 containing the definition of __wrap_SYMBOL, includes a direct
-	 call to SYMBOL as well. Since both __wrap_SYMBOL and SYMBOL reference
-	 the same symbol (which is __wrap_SYMBOL), but still exist as two
-	 different symbols in 'sym_hashes', we don't want to adjust
-	 the global symbol __wrap_SYMBOL twice.
-
-	 The same problem occurs with symbols that are versioned_hidden, as
-	 foo becomes an alias for foo@BAR, and hence they need the same
-	 treatment.  */
-      if (link_info->wrap_hash != NULL
-	  || sym_hash->versioned != unversioned)
-	{
-	  struct elf_link_hash_entry **cur_sym_hashes;
-
-	  /* Loop only over the symbols which have already been checked.  */
-	  for (cur_sym_hashes = sym_hashes; cur_sym_hashes < &sym_hashes[i];
-	       cur_sym_hashes++)
-	    {
-	      /* If the current symbol is identical to 'sym_hash', that means
-		 the symbol was already adjusted (or at least checked).  */
-	      if (*cur_sym_hashes == sym_hash)
-		break;
-	    }
-	  /* Don't adjust the symbol again.  */
-	  if (cur_sym_hashes < &sym_hashes[i])
-	    continue;
-	}
-
-      if ((sym_hash->root.type == bfd_link_hash_defined
-	   || sym_hash->root.type == bfd_link_hash_defweak)
-	  && sym_hash->root.u.def.section == sec)
-	{
-	  /* As above, adjust the value if needed.  */
-	  if (sym_hash->root.u.def.value > addr
-	      && sym_hash->root.u.def.value <= toaddr)
-	    sym_hash->root.u.def.value -= count;
-
-	  /* As above, adjust the size if needed.  */
-	  else if (sym_hash->root.u.def.value <= addr
-		   && sym_hash->root.u.def.value + sym_hash->size > addr
-		   && sym_hash->root.u.def.value + sym_hash->size <= toaddr)
-	    sym_hash->size -= count;
-	}
-    }
-
-  return true;
+  adj.addr = addr;
+  adj.count = count;
+  adj.toaddr = toaddr;
+  return riscv_adjust_global_syms (abfd, sec, link_info,
+				   riscv_adjust_global_sym, &adj);
 }
 
 typedef bool (*relax_delete_t) (bfd *, asection *,
@@ -4410,11 +4456,90 @@ _riscv_relax_delete_immediate (bfd *abfd,
 {
   if (rel != NULL)
     rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
-  return _riscv_relax_delete_bytes (abfd, sec, addr, count,
-				    link_info, p, 0, sec->size);
+  return _riscv_relax_delete_bytes (abfd, sec, addr, count, link_info, p);
+}
+
+/* A deletion recorded by an R_RISCV_DELETE reloc: COUNT bytes at
+   offset ADDR, with BEFORE bytes deleted at lower offsets.  */
+
+typedef struct
+{
+  bfd_vma addr;
+  bfd_vma count;
+  bfd_vma before;
+} riscv_delete_span;
+
+/* Return the number of bytes deleted by the NSPANS deletions in SPANS,
+   which are sorted by offset and end with a sentinel, at offsets
+   lower than OFF.  */
+
+static bfd_vma
+riscv_deleted_before (const riscv_delete_span *spans, size_t nspans,
+		      bfd_vma off)
+{
+  size_t lo = 0, hi = nspans;
+
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (spans[mid].addr < off)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return spans[lo].before;
 }
 
-/* Delete the bytes for R_RISCV_DELETE relocs.  */
+/* Adjust a symbol at *VALUE of size *SIZE, in a section of SEC_SIZE
+   bytes, for the deletions in SPANS.  This gives the same result as
+   _riscv_relax_delete_bytes would, called for each deletion in
+   turn.  */
+
+static void
+riscv_adjust_symbol_for_deletes (const riscv_delete_span *spans,
+				 size_t nspans, bfd_vma sec_size,
+				 bfd_vma *value, bfd_vma *size)
+{
+  bfd_vma start = *value;
+  bfd_vma end = start + *size;
+
+  if (start > sec_size)
+    return;
+
+  /* Deletions before the symbol move it down; deletions from its start
+     up to its end shrink it, if it ends within the section.  */
+  *value -= riscv_deleted_before (spans, nspans, start);
+  if (*size != 0 && end > start && end <= sec_size)
+    *size -= (riscv_deleted_before (spans, nspans, end)
+	      - riscv_deleted_before (spans, nspans, start));
+}
+
+/* The deletions for riscv_adjust_global_sym_for_deletes.  */
+
+struct riscv_deletes_adjust
+{
+  const riscv_delete_span *spans;
+  size_t nspans;
+  bfd_vma sec_size;
+};
+
+/* Adjust global symbol H for the deletions described by DATA.  */
+
+static void
+riscv_adjust_global_sym_for_deletes (struct elf_link_hash_entry *h,
+				     void *data)
+{
+  struct riscv_deletes_adjust *adj = (struct riscv_deletes_adjust *) data;
+
+  riscv_adjust_symbol_for_deletes (adj->spans, adj->nspans, adj->sec_size,
+				   &h->root.u.def.value, &h->size);
+}
+
+/* Delete the bytes for R_RISCV_DELETE relocs.  Rather than delete each
+   run of bytes in turn, adjusting every reloc and symbol each time,
+   collect the deletions into a table of offsets and running totals,
+   then move the contents and adjust the relocs and symbols in one pass
+   each.  */
 
 static bool
 riscv_relax_resolve_delete_relocs (bfd *abfd,
@@ -4422,48 +4547,92 @@ riscv_relax_resolve_delete_relocs (bfd *abfd,
 				   struct bfd_link_info *link_info,
 				   Elf_Internal_Rela *relocs)
 {
-  bfd_vma delete_total = 0;
+  struct bfd_elf_section_data *data = elf_section_data (sec);
+  bfd_byte *contents = data->this_hdr.contents;
+  Elf_Internal_Shdr *symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
+  unsigned int sec_shndx;
+  riscv_delete_span *spans;
+  struct riscv_deletes_adjust adj;
+  size_t nspans, j;
+  bfd_vma sec_size = sec->size;
+  bfd_vma delete_total;
   unsigned int i;
+  bool ret;
 
+  /* Collect the deletions.  The relocs are in order of offset, since
+     we only replace existing relocs and don't add new ones.  Like the
+     deletions themselves, ignore a delete reloc that doesn't come
+     after the previous one.  */
+  nspans = 0;
+  for (i = 0; i < sec->reloc_count; i++)
+    if (ELFNN_R_TYPE (relocs[i].r_info) == R_RISCV_DELETE)
+      nspans++;
+  if (nspans == 0)
+    return true;
+
+  spans = bfd_malloc ((nspans + 1) * sizeof (*spans));
+  if (spans == NULL)
+    return false;
+
+  nspans = 0;
+  delete_total = 0;
   for (i = 0; i < sec->reloc_count; i++)
     {
       Elf_Internal_Rela *rel = relocs + i;
-      if (ELFNN_R_TYPE (rel->r_info) != R_RISCV_DELETE)
+
+      if (ELFNN_R_TYPE (rel->r_info) != R_RISCV_DELETE
+	  || (nspans != 0 && rel->r_offset <= spans[nspans - 1].addr))
 	continue;
+      spans[nspans].addr = rel->r_offset;
+      spans[nspans].count = rel->r_addend;
+      spans[nspans].before = delete_total;
+      delete_total += rel->r_addend;
+      nspans++;
+      rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+    }
+  spans[nspans].addr = (bfd_vma) -1;
+  spans[nspans].count = 0;
+  spans[nspans].before = delete_total;
 
-      /* Find the next R_RISCV_DELETE reloc if possible.  */
-      Elf_Internal_Rela *rel_next = NULL;
-      unsigned int start = rel - relocs;
-      for (i = start; i < sec->reloc_count; i++)
-	{
-	  /* Since we only replace existing relocs and don't add new relocs, the
-	     relocs are in sequential order. We can skip the relocs prior to this
-	     one, making this search linear time.  */
-	  rel_next = relocs + i;
-	  if (ELFNN_R_TYPE ((rel_next)->r_info) == R_RISCV_DELETE
-	      && (rel_next)->r_offset > rel->r_offset)
-	    {
-	      BFD_ASSERT (rel_next - rel > 0);
-	      break;
-	    }
-	  else
-	    rel_next = NULL;
-	}
+  /* Close up the contents.  */
+  for (j = 0; j < nspans; j++)
+    {
+      bfd_vma from = spans[j].addr + spans[j].count;
+      bfd_vma to = j + 1 < nspans ? spans[j + 1].addr : sec_size;
 
-      bfd_vma toaddr = rel_next == NULL ? sec->size : rel_next->r_offset;
-      if (!_riscv_relax_delete_bytes (abfd, sec, rel->r_offset, rel->r_addend,
-				      link_info, NULL, delete_total, toaddr))
-	return false;
+      memmove (contents + spans[j].addr - spans[j].before,
+	       contents + from, to - from);
+    }
+  sec->size -= delete_total;
 
-      delete_total += rel->r_addend;
-      rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+  /* Adjust the location of all of the relocs.  Note that we need not
+     adjust the addends, since all PC-relative references must be against
+     symbols, which we will adjust below.  */
+  for (i = 0; i < sec->reloc_count; i++)
+    if (data->relocs[i].r_offset < sec_size)
+      data->relocs[i].r_offset
+	-= riscv_deleted_before (spans, nspans, data->relocs[i].r_offset);
 
-      /* Skip ahead to the next delete reloc.  */
-      i = rel_next != NULL ? (unsigned int) (rel_next - relocs - 1)
-			   : sec->reloc_count;
+  /* Adjust the local symbols defined in this section.  */
+  sec_shndx = _bfd_elf_section_from_bfd_section (abfd, sec);
+  for (i = 0; i < symtab_hdr->sh_info; i++)
+    {
+      Elf_Internal_Sym *sym = (Elf_Internal_Sym *) symtab_hdr->contents + i;
+
+      if (sym->st_shndx == sec_shndx)
+	riscv_adjust_symbol_for_deletes (spans, nspans, sec_size,
+					 &sym->st_value, &sym->st_size);
     }
 
-  return true;
+  /* Now adjust the global symbols defined in this section.  */
+  adj.spans = spans;
+  adj.nspans = nspans;
+  adj.sec_size = sec_size;
+  ret = riscv_adjust_global_syms (abfd, sec, link_info,
+				  riscv_adjust_global_sym_for_deletes, &adj);
+
+  free (spans);
+  return ret;
 }
 
 typedef bool (*relax_func_t) (bfd *, asection *, asection *,
@@ -1812,6 +1812,39 @@ elf_x86_relative_reloc_compare (const void *pa, const void *pb)
   return 0;
 }
 
+/* Sort the COUNT relative relocations of HTAB by address, with a
+   radix sort if we have the memory for it.  */
+
+static void
+elf_x86_sort_relative_reloc (struct bfd_link_info *info,
+			     struct elf_x86_link_hash_table *htab,
+			     bfd_size_type count)
+{
+  struct elf_x86_relative_reloc_record *data = htab->relative_reloc.data;
+  struct elf_radix_sort_key *keys;
+  bfd_size_type i;
+
+  keys = (struct elf_radix_sort_key *) bfd_malloc (count * sizeof (*keys));
+  if (keys != NULL)
+    {
+      for (i = 0; i < count; i++)
+	{
+	  keys[i].k[0] = data[i].address;
+	  keys[i].index = i;
+	}
+      if (_bfd_elf_radix_sort (keys, count, 1, info->threads)
+	  && _bfd_elf_radix_sort_apply (data, count, sizeof (*data), keys))
+	{
+	  free (keys);
+	  return;
+	}
+      free (keys);
+    }
+
+  qsort (data, count, sizeof (struct elf_x86_relative_reloc_record),
+	 elf_x86_relative_reloc_compare);
+}
+
 enum dynobj_sframe_plt_type
 {
   SFRAME_PLT = 1,
@@ -2090,9 +2123,7 @@ _bfd_elf_x86_size_relative_relocs (struct bfd_link_info *info,
 	 sort them in the first pass since the relative positions
 	 won't change.  */
       if (htab->generate_relative_reloc_pass == 0)
-	qsort (htab->relative_reloc.data, count,
-	       sizeof (struct elf_x86_relative_reloc_record),
-	       elf_x86_relative_reloc_compare);
+	elf_x86_sort_relative_reloc (info, htab, count);
 
       elf_x86_compute_dl_relr_bitmap (info, htab, need_layout);
     }
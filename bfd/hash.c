@@ -83,6 +83,18 @@ SUBSECTION
 	used to allocate new entries.  You may allocate memory on this
 	objalloc using <<bfd_hash_allocate>>.
 
+@findex bfd_hash_table_init_open
+	A hash table may instead be created with
+	<<bfd_hash_table_init_open>>, which takes the same arguments
+	as <<bfd_hash_table_init>>.  Such a table keeps its entries in
+	a single array which is searched by linear probing, with part
+	of the hash code of each entry stored alongside, so that a
+	lookup usually touches only one or two cache lines before it
+	finds the entry it wants.  The entries of such a table are not
+	chained through their <<next>> fields, so it is only suitable
+	for users which do not walk the chains themselves.  All the
+	functions described here work on either kind of table.
+
 @findex bfd_hash_table_free
 	Use <<bfd_hash_table_free>> to free up all the memory that has
 	been allocated for a hash table.  This will not free up the
@@ -337,6 +349,11 @@ EXTERNAL
 .  unsigned int entsize;
 .  {* If non-zero, don't grow the hash table.  *}
 .  unsigned int frozen:1;
+.  {* For a table created by bfd_hash_table_init_open, the keys of the
+.     slots in TABLE: zero for an empty slot, otherwise derived from
+.     the hash code of the entry in the slot.  NULL for a table which
+.     chains entries from TABLE.  *}
+.  unsigned int *keys;
 .};
 .
 */
@@ -344,6 +361,10 @@ EXTERNAL
 /* The default number of entries to use when creating a hash table.  */
 #define DEFAULT_SIZE 4051
 
+/* Grow an open addressing hash table once it is this full.  */
+#define OPEN_LOAD_NUM 3
+#define OPEN_LOAD_DEN 4
+
 /* The following function returns a nearest prime number which is
    greater than N, and near a power of two.  Copied from libiberty.
    Returns zero for ridiculously large N to signify an error.  */
@@ -453,6 +474,79 @@ bfd_hash_table_init_n (struct bfd_hash_table *table,
       return false;
     }
   memset ((void *) table->table, 0, alloc);
+  table->keys = NULL;
+  table->size = size;
+  table->entsize = entsize;
+  table->count = 0;
+  table->frozen = 0;
+  table->newfunc = newfunc;
+  return true;
+}
+
+/* Allocate the slots for an open addressing hash table of SIZE slots,
+   which must be a power of two, setting *ENTRIES and *KEYS.  */
+
+static bool
+bfd_hash_open_alloc (struct bfd_hash_table *table,
+		     unsigned int size,
+		     struct bfd_hash_entry ***entries,
+		     unsigned int **keys)
+{
+  size_t slot = sizeof (struct bfd_hash_entry *) + sizeof (unsigned int);
+  void *mem;
+
+  if (size == 0 || size > (size_t) -1 / slot)
+    return false;
+
+  mem = objalloc_alloc ((struct objalloc *) table->memory, size * slot);
+  if (mem == NULL)
+    return false;
+  memset (mem, 0, size * slot);
+  *entries = (struct bfd_hash_entry **) mem;
+  *keys = (unsigned int *) (*entries + size);
+  return true;
+}
+
+/*
+FUNCTION
+	bfd_hash_table_init_open
+
+SYNOPSIS
+	bool bfd_hash_table_init_open
+	  (struct bfd_hash_table *,
+	   struct bfd_hash_entry *(* {*newfunc*})
+	     (struct bfd_hash_entry *, struct bfd_hash_table *, const char *),
+	   unsigned int {*entsize*});
+
+DESCRIPTION
+	Create a new hash table which uses open addressing rather than
+	chaining, with at least the default number of entries.
+*/
+
+bool
+bfd_hash_table_init_open (struct bfd_hash_table *table,
+			  struct bfd_hash_entry *(*newfunc) (struct bfd_hash_entry *,
+							     struct bfd_hash_table *,
+							     const char *),
+			  unsigned int entsize)
+{
+  unsigned int size;
+
+  table->memory = (void *) objalloc_create ();
+  if (table->memory == NULL)
+    {
+      bfd_set_error (bfd_error_no_memory);
+      return false;
+    }
+
+  for (size = 64; size < bfd_default_hash_table_size; size *= 2)
+    ;
+  if (!bfd_hash_open_alloc (table, size, &table->table, &table->keys))
+    {
+      bfd_hash_table_free (table);
+      bfd_set_error (bfd_error_no_memory);
+      return false;
+    }
   table->size = size;
   table->entsize = entsize;
   table->count = 0;
@@ -503,6 +597,7 @@ bfd_hash_table_free (struct bfd_hash_table *table)
 {
   objalloc_free ((struct objalloc *) table->memory);
   table->memory = NULL;
+  table->keys = NULL;
 }
 
 static inline unsigned long
@@ -530,6 +625,117 @@ bfd_hash_hash (const char *string, unsigned int *lenp)
   return hash;
 }
 
+/* Return the key stored in an open addressing table for an entry with
+   hash code HASH.  Keys are never zero, which marks an empty slot.  */
+
+static inline unsigned int
+bfd_hash_open_key (unsigned long hash)
+{
+  return ((unsigned int) hash & 0xffffffff) | 0x80000000;
+}
+
+/* Return the slot at which to start looking for KEY in an open
+   addressing table of SIZE slots.  The key is mixed first, since
+   the low bits of bfd_hash_hash alone are not well distributed.  */
+
+static inline unsigned int
+bfd_hash_open_index (unsigned int key, unsigned int size)
+{
+  uint32_t h = (uint32_t) key * UINT32_C (0x9e3779b1);
+
+  return (h ^ (h >> 15)) & (size - 1);
+}
+
+/* Return the slot holding ENT in open addressing table TABLE.  */
+
+static unsigned int
+bfd_hash_open_find (struct bfd_hash_table *table,
+		    struct bfd_hash_entry *ent)
+{
+  unsigned int mask = table->size - 1;
+  unsigned int _index;
+
+  for (_index = bfd_hash_open_index (bfd_hash_open_key (ent->hash),
+				     table->size);
+       table->table[_index] != ent;
+       _index = (_index + 1) & mask)
+    if (table->keys[_index] == 0)
+      abort ();
+  return _index;
+}
+
+/* Put ENT, whose key is KEY, in the first free slot for it in open
+   addressing table TABLE.  */
+
+static void
+bfd_hash_open_place (struct bfd_hash_table *table,
+		     struct bfd_hash_entry *ent,
+		     unsigned int key)
+{
+  unsigned int mask = table->size - 1;
+  unsigned int _index;
+
+  for (_index = bfd_hash_open_index (key, table->size);
+       table->keys[_index] != 0;
+       _index = (_index + 1) & mask)
+    ;
+  table->keys[_index] = key;
+  table->table[_index] = ent;
+}
+
+/* Empty slot _INDEX of open addressing table TABLE, moving back any
+   entries after it which would otherwise no longer be found.  */
+
+static void
+bfd_hash_open_remove (struct bfd_hash_table *table, unsigned int _index)
+{
+  unsigned int mask = table->size - 1;
+  unsigned int next = _index;
+
+  for (;;)
+    {
+      unsigned int home;
+
+      next = (next + 1) & mask;
+      if (table->keys[next] == 0)
+	break;
+
+      /* The entry at NEXT can fill the hole at _INDEX unless its own
+	 first slot lies cyclically after the hole.  */
+      home = bfd_hash_open_index (table->keys[next], table->size);
+      if (((next - home) & mask) >= ((next - _index) & mask))
+	{
+	  table->keys[_index] = table->keys[next];
+	  table->table[_index] = table->table[next];
+	  _index = next;
+	}
+    }
+  table->keys[_index] = 0;
+  table->table[_index] = NULL;
+}
+
+/* Double the size of open addressing table TABLE.  */
+
+static bool
+bfd_hash_open_grow (struct bfd_hash_table *table)
+{
+  struct bfd_hash_entry **old_table = table->table;
+  unsigned int *old_keys = table->keys;
+  unsigned int old_size = table->size;
+  unsigned int i;
+
+  if (old_size > (unsigned int) -1 / 2
+      || !bfd_hash_open_alloc (table, old_size * 2,
+			       &table->table, &table->keys))
+    return false;
+
+  table->size = old_size * 2;
+  for (i = 0; i < old_size; i++)
+    if (old_keys[i] != 0)
+      bfd_hash_open_place (table, old_table[i], old_keys[i]);
+  return true;
+}
+
 /*
 FUNCTION
 	bfd_hash_lookup
@@ -555,14 +761,30 @@ bfd_hash_lookup (struct bfd_hash_table *table,
   unsigned int _index;
 
   hash = bfd_hash_hash (string, &len);
-  _index = hash % table->size;
-  for (hashp = table->table[_index];
-       hashp != NULL;
-       hashp = hashp->next)
+  if (table->keys != NULL)
     {
-      if (hashp->hash == hash
-	  && strcmp (hashp->string, string) == 0)
-	return hashp;
+      unsigned int key = bfd_hash_open_key (hash);
+      unsigned int mask = table->size - 1;
+
+      for (_index = bfd_hash_open_index (key, table->size);
+	   table->keys[_index] != 0;
+	   _index = (_index + 1) & mask)
+	if (table->keys[_index] == key
+	    && (hashp = table->table[_index])->hash == hash
+	    && strcmp (hashp->string, string) == 0)
+	  return hashp;
+    }
+  else
+    {
+      _index = hash % table->size;
+      for (hashp = table->table[_index];
+	   hashp != NULL;
+	   hashp = hashp->next)
+	{
+	  if (hashp->hash == hash
+	      && strcmp (hashp->string, string) == 0)
+	    return hashp;
+	}
     }
 
   if (! create)
@@ -608,6 +830,31 @@ bfd_hash_insert (struct bfd_hash_table *table,
   struct bfd_hash_entry *hashp;
   unsigned int _index;
 
+  if (table->keys != NULL)
+    {
+      /* Grow the table before adding to it, and always keep a free
+	 slot so that searches end.  */
+      if (!table->frozen
+	  && table->count + 1 > table->size / OPEN_LOAD_DEN * OPEN_LOAD_NUM
+	  && !bfd_hash_open_grow (table))
+	table->frozen = 1;
+      if (table->count + 1 >= table->size)
+	{
+	  bfd_set_error (bfd_error_no_memory);
+	  return NULL;
+	}
+
+      hashp = (*table->newfunc) (NULL, table, string);
+      if (hashp == NULL)
+	return NULL;
+      hashp->next = NULL;
+      hashp->string = string;
+      hashp->hash = hash;
+      bfd_hash_open_place (table, hashp, bfd_hash_open_key (hash));
+      table->count++;
+      return hashp;
+    }
+
   hashp = (*table->newfunc) (NULL, table, string);
   if (hashp == NULL)
     return NULL;
@@ -684,6 +931,15 @@ bfd_hash_rename (struct bfd_hash_table *table,
   unsigned int _index;
   struct bfd_hash_entry **pph;
 
+  if (table->keys != NULL)
+    {
+      bfd_hash_open_remove (table, bfd_hash_open_find (table, ent));
+      ent->string = string;
+      ent->hash = bfd_hash_hash (string, NULL);
+      bfd_hash_open_place (table, ent, bfd_hash_open_key (ent->hash));
+      return;
+    }
+
   _index = ent->hash % table->size;
   for (pph = &table->table[_index]; *pph != NULL; pph = &(*pph)->next)
     if (*pph == ent)
@@ -720,6 +976,12 @@ bfd_hash_replace (struct bfd_hash_table *table,
   unsigned int _index;
   struct bfd_hash_entry **pph;
 
+  if (table->keys != NULL)
+    {
+      table->table[bfd_hash_open_find (table, old)] = nw;
+      return;
+    }
+
   _index = old->hash % table->size;
   for (pph = &table->table[_index];
        (*pph) != NULL;
@@ -945,8 +1207,8 @@ _bfd_stringtab_init (void)
   if (table == NULL)
     return NULL;
 
-  if (!bfd_hash_table_init (&table->table, strtab_hash_newfunc,
-			    sizeof (struct strtab_hash_entry)))
+  if (!bfd_hash_table_init_open (&table->table, strtab_hash_newfunc,
+				 sizeof (struct strtab_hash_entry)))
     {
       free (table);
       return NULL;
@@ -35,6 +35,14 @@
 
 #include "hashtab.h"
 
+/* Nonzero if the _bfd_parallel_* functions can use more than one
+   thread.  */
+#if defined (HAVE_PTHREAD_H) && defined (HAVE_PTHREAD_CREATE)
+#define BFD_SUPPORTS_THREADS 1
+#else
+#define BFD_SUPPORTS_THREADS 0
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -85,6 +93,19 @@ struct artdata
   file_ptr armap_datepos;	/* Position within archive to seek to
 				   rewrite the date field.  */
   void *tdata;			/* Backend specific information.  */
+  /* The elements found by bfd_archive_member_count.  */
+  struct ar_member *members;
+  size_t member_count;
+  /* Why the walk of the element headers stopped, or bfd_error_no_error
+     if the elements have not been indexed.  */
+  bfd_error_type members_error;
+};
+
+/* An element of an archive, as found by walking the element headers.  */
+struct ar_member
+{
+  file_ptr filepos;		/* Where the element header is.  */
+  bfd_size_type size;		/* Octets of the element.  */
 };
 
 #define bfd_ardata(bfd) ((bfd)->tdata.aout_ar_data)
@@ -604,6 +625,9 @@ extern bool _bfd_dwarf2_slurp_debug_info
 extern void _bfd_dwarf2_cleanup_debug_info
   (bfd *, void **) ATTRIBUTE_HIDDEN;
 
+/* The directory set by bfd_set_dwarf2_index_cache.  */
+extern const char *_bfd_dwarf2_index_cache_dir ATTRIBUTE_HIDDEN;
+
 extern void _bfd_stab_cleanup
   (bfd *, void **) ATTRIBUTE_HIDDEN;
 
@@ -850,6 +874,13 @@ extern struct bfd_link_info *_bfd_get_link_info (bfd *);
 extern bool _bfd_link_keep_memory (struct bfd_link_info *)
   ATTRIBUTE_HIDDEN;
 
+/* Compress several sections, as bfd_compress_section and
+   bfd_init_section_compress_status would, in parallel.  */
+extern bool _bfd_compress_sections
+  (bfd *, size_t, asection **, bfd_byte **) ATTRIBUTE_HIDDEN;
+extern size_t _bfd_init_sections_compress_status
+  (bfd *, size_t, asection **) ATTRIBUTE_HIDDEN;
+
 #if GCC_VERSION >= 7000
 #define _bfd_mul_overflow(a, b, res) __builtin_mul_overflow (a, b, res)
 #else
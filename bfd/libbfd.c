@@ -24,6 +24,10 @@
 #include "libbfd.h"
 #include "objalloc.h"
 
+#if BFD_SUPPORTS_THREADS
+#include <pthread.h>
+#endif
+
 #ifndef HAVE_GETPAGESIZE
 #define getpagesize() 2048
 #endif
@@ -1184,6 +1188,234 @@ bfd_log2 (bfd_vma x)
   return result;
 }
 
+/* A batch of work items being run by _bfd_parallel_start.  */
+
+struct bfd_parallel_work
+{
+#if BFD_SUPPORTS_THREADS
+  /* Protects NEXT.  */
+  pthread_mutex_t lock;
+  /* The threads started, and how many there are.  */
+  pthread_t *threads;
+  unsigned int nthreads;
+#endif
+  /* The next item to hand out, and the number of items.  */
+  size_t next;
+  size_t count;
+  /* The function to call for each item.  */
+  void (*fn) (void *, size_t);
+  void *data;
+};
+
+/* Run items from WORK until there are none left.  */
+
+static void *
+parallel_work_loop (void *arg)
+{
+  struct bfd_parallel_work *work = (struct bfd_parallel_work *) arg;
+
+  while (1)
+    {
+      size_t i;
+
+#if BFD_SUPPORTS_THREADS
+      pthread_mutex_lock (&work->lock);
+#endif
+      i = work->next;
+      if (i < work->count)
+	work->next = i + 1;
+#if BFD_SUPPORTS_THREADS
+      pthread_mutex_unlock (&work->lock);
+#endif
+      if (i >= work->count)
+	break;
+      work->fn (work->data, i);
+    }
+  return NULL;
+}
+
+/*
+INTERNAL_FUNCTION
+	_bfd_parallel_start
+
+SYNOPSIS
+	struct bfd_parallel_work *_bfd_parallel_start
+	  (unsigned int {*threads*}, size_t {*count*},
+	   void (*{*fn*}) (void *, size_t), void *{*data*});
+
+DESCRIPTION
+	Start calling @var{fn} (@var{data}, @var{i}) for each @var{i}
+	from 0 to @var{count} - 1 on up to @var{threads} new threads,
+	and return without waiting for them.  The calls happen in no
+	particular order, so @var{fn} must only touch state that belongs
+	to item @var{i}.  It must not call back into BFD, since BFD's
+	file cache and error state are not thread safe.  The result must
+	be passed to _bfd_parallel_finish.
+
+	If threads are not supported, or can not be started, the work
+	is done before returning and NULL is returned.
+*/
+
+struct bfd_parallel_work *
+_bfd_parallel_start (unsigned int threads, size_t count,
+		     void (*fn) (void *, size_t), void *data)
+{
+#if BFD_SUPPORTS_THREADS
+  struct bfd_parallel_work *work;
+
+  if (threads > count)
+    threads = count;
+  if (threads != 0)
+    {
+      work = (struct bfd_parallel_work *) bfd_malloc (sizeof (*work));
+      if (work != NULL)
+	{
+	  work->threads
+	    = (pthread_t *) bfd_malloc (threads * sizeof (pthread_t));
+	  if (work->threads == NULL)
+	    free (work);
+	  else
+	    {
+	      work->next = 0;
+	      work->count = count;
+	      work->fn = fn;
+	      work->data = data;
+	      pthread_mutex_init (&work->lock, NULL);
+	      for (work->nthreads = 0; work->nthreads < threads;
+		   work->nthreads++)
+		if (pthread_create (&work->threads[work->nthreads], NULL,
+				    parallel_work_loop, work) != 0)
+		  break;
+	      if (work->nthreads != 0)
+		return work;
+	      pthread_mutex_destroy (&work->lock);
+	      free (work->threads);
+	      free (work);
+	    }
+	}
+    }
+#else
+  (void) threads;
+#endif
+
+  {
+    struct bfd_parallel_work serial;
+
+    serial.next = 0;
+    serial.count = count;
+    serial.fn = fn;
+    serial.data = data;
+#if BFD_SUPPORTS_THREADS
+    pthread_mutex_init (&serial.lock, NULL);
+#endif
+    parallel_work_loop (&serial);
+#if BFD_SUPPORTS_THREADS
+    pthread_mutex_destroy (&serial.lock);
+#endif
+  }
+  return NULL;
+}
+
+/*
+INTERNAL_FUNCTION
+	_bfd_parallel_finish
+
+SYNOPSIS
+	void _bfd_parallel_finish (struct bfd_parallel_work *{*work*});
+
+DESCRIPTION
+	Help the threads running @var{work} until all of its items
+	have been done, then release it.  @var{work} may be NULL.
+*/
+
+void
+_bfd_parallel_finish (struct bfd_parallel_work *work)
+{
+#if BFD_SUPPORTS_THREADS
+  unsigned int i;
+
+  if (work == NULL)
+    return;
+
+  parallel_work_loop (work);
+  for (i = 0; i < work->nthreads; i++)
+    pthread_join (work->threads[i], NULL);
+  pthread_mutex_destroy (&work->lock);
+  free (work->threads);
+  free (work);
+#else
+  BFD_ASSERT (work == NULL);
+#endif
+}
+
+/*
+INTERNAL_FUNCTION
+	_bfd_parallel_for
+
+SYNOPSIS
+	void _bfd_parallel_for
+	  (unsigned int {*threads*}, size_t {*count*},
+	   void (*{*fn*}) (void *, size_t), void *{*data*});
+
+DESCRIPTION
+	Call @var{fn} (@var{data}, @var{i}) for each @var{i} from 0 to
+	@var{count} - 1, using up to @var{threads} threads including the
+	calling one, and wait for all the calls to finish.  The same
+	restrictions on @var{fn} apply as for _bfd_parallel_start.
+*/
+
+void
+_bfd_parallel_for (unsigned int threads, size_t count,
+		   void (*fn) (void *, size_t), void *data)
+{
+  _bfd_parallel_finish (_bfd_parallel_start (threads > 1 ? threads - 1 : 0,
+					     count, fn, data));
+}
+
+/*
+FUNCTION
+	bfd_parallel_start
+
+SYNOPSIS
+	struct bfd_parallel_work *bfd_parallel_start
+	  (unsigned int {*threads*}, size_t {*count*},
+	   void (*{*fn*}) (void *, size_t), void *{*data*});
+
+DESCRIPTION
+	Start calling @var{fn} (@var{data}, @var{i}) for each @var{i}
+	from 0 to @var{count} - 1 on up to @var{threads} new threads,
+	and return without waiting for them, so that the caller can get
+	on with other work.  @var{fn} must not call any BFD function.
+	The result must be passed to <<bfd_parallel_finish>>.  If
+	@var{threads} is zero, or threads are not supported, the work
+	is done before returning and NULL is returned.
+*/
+
+struct bfd_parallel_work *
+bfd_parallel_start (unsigned int threads, size_t count,
+		    void (*fn) (void *, size_t), void *data)
+{
+  return _bfd_parallel_start (threads, count, fn, data);
+}
+
+/*
+FUNCTION
+	bfd_parallel_finish
+
+SYNOPSIS
+	void bfd_parallel_finish (struct bfd_parallel_work *{*work*});
+
+DESCRIPTION
+	Wait for the work started by <<bfd_parallel_start>> to finish,
+	helping with any items not yet started.
+*/
+
+void
+bfd_parallel_finish (struct bfd_parallel_work *work)
+{
+  _bfd_parallel_finish (work);
+}
+
 bool
 bfd_generic_is_local_label_name (bfd *abfd, const char *name)
 {
@@ -41,6 +41,14 @@
 
 #include "hashtab.h"
 
+/* Nonzero if the _bfd_parallel_* functions can use more than one
+   thread.  */
+#if defined (HAVE_PTHREAD_H) && defined (HAVE_PTHREAD_CREATE)
+#define BFD_SUPPORTS_THREADS 1
+#else
+#define BFD_SUPPORTS_THREADS 0
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -91,6 +99,19 @@ struct artdata
   file_ptr armap_datepos;	/* Position within archive to seek to
 				   rewrite the date field.  */
   void *tdata;			/* Backend specific information.  */
+  /* The elements found by bfd_archive_member_count.  */
+  struct ar_member *members;
+  size_t member_count;
+  /* Why the walk of the element headers stopped, or bfd_error_no_error
+     if the elements have not been indexed.  */
+  bfd_error_type members_error;
+};
+
+/* An element of an archive, as found by walking the element headers.  */
+struct ar_member
+{
+  file_ptr filepos;		/* Where the element header is.  */
+  bfd_size_type size;		/* Octets of the element.  */
 };
 
 #define bfd_ardata(bfd) ((bfd)->tdata.aout_ar_data)
@@ -610,6 +631,9 @@ extern bool _bfd_dwarf2_slurp_debug_info
 extern void _bfd_dwarf2_cleanup_debug_info
   (bfd *, void **) ATTRIBUTE_HIDDEN;
 
+/* The directory set by bfd_set_dwarf2_index_cache.  */
+extern const char *_bfd_dwarf2_index_cache_dir ATTRIBUTE_HIDDEN;
+
 extern void _bfd_stab_cleanup
   (bfd *, void **) ATTRIBUTE_HIDDEN;
 
@@ -856,6 +880,13 @@ extern struct bfd_link_info *_bfd_get_link_info (bfd *);
 extern bool _bfd_link_keep_memory (struct bfd_link_info *)
   ATTRIBUTE_HIDDEN;
 
+/* Compress several sections, as bfd_compress_section and
+   bfd_init_section_compress_status would, in parallel.  */
+extern bool _bfd_compress_sections
+  (bfd *, size_t, asection **, bfd_byte **) ATTRIBUTE_HIDDEN;
+extern size_t _bfd_init_sections_compress_status
+  (bfd *, size_t, asection **) ATTRIBUTE_HIDDEN;
+
 #if GCC_VERSION >= 7000
 #define _bfd_mul_overflow(a, b, res) __builtin_mul_overflow (a, b, res)
 #else
@@ -928,6 +959,16 @@ bool bfd_write_bigendian_4byte_int (bfd *, unsigned int) ATTRIBUTE_HIDDEN;
 
 unsigned int bfd_log2 (bfd_vma x) ATTRIBUTE_HIDDEN;
 
+struct bfd_parallel_work *_bfd_parallel_start
+   (unsigned int /*threads*/, size_t /*count*/,
+    void (*/*fn*/) (void *, size_t), void */*data*/) ATTRIBUTE_HIDDEN;
+
+void _bfd_parallel_finish (struct bfd_parallel_work */*work*/) ATTRIBUTE_HIDDEN;
+
+void _bfd_parallel_for
+   (unsigned int /*threads*/, size_t /*count*/,
+    void (*/*fn*/) (void *, size_t), void */*data*/) ATTRIBUTE_HIDDEN;
+
 /* Extracted from bfd.c.  */
 /* A buffer that is freed on bfd_close.  */
 extern char *_bfd_error_buf;
@@ -1013,6 +1054,8 @@ bool bfd_cache_init (bfd *abfd) ATTRIBUTE_HIDDEN;
 
 FILE* bfd_open_file (bfd *abfd) ATTRIBUTE_HIDDEN;
 
+int _bfd_cache_dup_fd (bfd *abfd, ufile_ptr *origin) ATTRIBUTE_HIDDEN;
+
 /* Extracted from hash.c.  */
 struct bfd_strtab_hash *_bfd_stringtab_init (void) ATTRIBUTE_HIDDEN;
 
@@ -3650,6 +3693,8 @@ bool _bfd_unrecognized_reloc
     unsigned int r_type) ATTRIBUTE_HIDDEN;
 
 /* Extracted from section.c.  */
+void _bfd_free_section_views (bfd *abfd) ATTRIBUTE_HIDDEN;
+
 bool _bfd_section_size_insane (bfd *abfd, asection *sec) ATTRIBUTE_HIDDEN;
 
 /* Extracted from stabs.c.  */
@@ -780,6 +780,367 @@ record_section (struct sec_merge_info *sinfo,
   return false;
 }
 
+/* With --threads, the sections of a merged blob are recorded by
+   record_sections_parallel in three steps.  First each section is read
+   and split into entries, with their hashes, by one thread per section.
+   Then the entries are looked up, with each thread looking after the
+   entries whose hashes fall into its partition of the hash space.  Each
+   partition has a table of its own, mapping every distinct entry to a
+   representative (the first copy seen, in section order).  Last, the
+   hash table entries are made from the representatives in the order
+   their first copies appear, which is the order record_section would
+   have made them in, so the merged section is the same.  */
+
+/* A distinct entry found by a partition.  */
+
+struct sec_merge_rep
+{
+  /* The first copy of the entry, in the contents of its section.  */
+  const char *str;
+  /* Its length, including the zero terminator.  */
+  unsigned int len;
+  /* The largest alignment of any copy.  */
+  unsigned int alignment;
+  /* The hash table entry made from it.  */
+  struct sec_merge_hash_entry *entry;
+};
+
+/* One of the input sections being recorded.  */
+
+struct sec_merge_prep
+{
+  struct sec_merge_sec_info *secinfo;
+  bfd_byte *contents;
+  /* Number of entries in the section, and their input offsets, with a
+     sentinel at the end giving the size of the section.  */
+  unsigned int count;
+  mapofs_type *ofs;
+  uint32_t *hash;
+  /* The entries grouped by partition, and where each group starts.  */
+  unsigned int *order;
+  unsigned int *part_start;
+  /* The representative for each entry.  */
+  struct sec_merge_rep **rep;
+};
+
+/* A partition of the hash space and its table.  */
+
+struct sec_merge_part
+{
+  unsigned int nbuckets;
+  uint64_t *key_lens;
+  struct sec_merge_rep **values;
+  unsigned int nreps;
+  struct sec_merge_rep *reps;
+};
+
+struct sec_merge_parallel
+{
+  struct sec_merge_hash *htab;
+  struct sec_merge_prep *preps;
+  unsigned int nprep;
+  struct sec_merge_part *parts;
+  /* log2 of the number of partitions.  */
+  unsigned int part_bits;
+  bool failed;
+};
+
+/* The partition of an entry with hash HASH.  */
+#define MERGE_PART(P, HASH) \
+  ((P)->part_bits == 0 ? 0 : (HASH) >> (32 - (P)->part_bits))
+
+/* Split the contents of section I of DATA into entries, recording
+   their offsets, hashes and partitions.  Called on other threads, so
+   this must not call into BFD.  */
+
+static void
+sec_merge_split_section (void *data, size_t i)
+{
+  struct sec_merge_parallel *par = (struct sec_merge_parallel *) data;
+  struct sec_merge_prep *prep = &par->preps[i];
+  unsigned int nparts = 1u << par->part_bits;
+  bfd_size_type size = prep->secinfo->sec->size;
+  unsigned int max, count, j;
+  unsigned char *p, *end;
+
+  max = 1024;
+  prep->ofs = malloc ((max + 1) * sizeof (*prep->ofs));
+  prep->hash = malloc (max * sizeof (*prep->hash));
+  prep->part_start = calloc (nparts + 1, sizeof (*prep->part_start));
+  if (prep->ofs == NULL || prep->hash == NULL || prep->part_start == NULL)
+    goto fail;
+
+  count = 0;
+  end = prep->contents + size;
+  for (p = prep->contents; p < end;)
+    {
+      unsigned int len;
+
+      if (count == max)
+	{
+	  mapofs_type *newofs;
+	  uint32_t *newhash;
+
+	  max *= 2;
+	  newofs = realloc (prep->ofs, (max + 1) * sizeof (*prep->ofs));
+	  if (newofs == NULL)
+	    goto fail;
+	  prep->ofs = newofs;
+	  newhash = realloc (prep->hash, max * sizeof (*prep->hash));
+	  if (newhash == NULL)
+	    goto fail;
+	  prep->hash = newhash;
+	}
+      prep->ofs[count] = p - prep->contents;
+      prep->hash[count] = hashit (par->htab, (char *) p, &len);
+      prep->part_start[MERGE_PART (par, prep->hash[count]) + 1]++;
+      count++;
+      p += len;
+    }
+  prep->ofs[count] = size;
+  prep->count = count;
+
+  /* Group the entries by partition, keeping them in section order
+     within each group.  */
+  prep->order = malloc ((count + 1) * sizeof (*prep->order));
+  prep->rep = malloc ((count + 1) * sizeof (*prep->rep));
+  if (prep->order == NULL || prep->rep == NULL)
+    goto fail;
+  for (j = 0; j < nparts; j++)
+    prep->part_start[j + 1] += prep->part_start[j];
+  {
+    unsigned int *next = malloc (nparts * sizeof (*next));
+
+    if (next == NULL)
+      goto fail;
+    memcpy (next, prep->part_start, nparts * sizeof (*next));
+    for (j = 0; j < count; j++)
+      prep->order[next[MERGE_PART (par, prep->hash[j])]++] = j;
+    free (next);
+  }
+  return;
+
+ fail:
+  par->failed = true;
+}
+
+/* Find a representative for every entry of every section that falls
+   into partition PART of DATA.  Called on other threads, so this must
+   not call into BFD.  */
+
+static void
+sec_merge_find_reps (void *data, size_t part)
+{
+  struct sec_merge_parallel *par = (struct sec_merge_parallel *) data;
+  struct sec_merge_part *pp = &par->parts[part];
+  unsigned int i, j, total;
+
+  total = 0;
+  for (i = 0; i < par->nprep; i++)
+    if (par->preps[i].part_start != NULL)
+      total += (par->preps[i].part_start[part + 1]
+		- par->preps[i].part_start[part]);
+  if (total == 0)
+    return;
+
+  pp->nbuckets = 16;
+  while (pp->nbuckets / 3 * 2 <= total)
+    pp->nbuckets *= 2;
+  pp->key_lens = calloc (pp->nbuckets, sizeof (*pp->key_lens));
+  pp->values = calloc (pp->nbuckets, sizeof (*pp->values));
+  pp->reps = malloc (total * sizeof (*pp->reps));
+  if (pp->key_lens == NULL || pp->values == NULL || pp->reps == NULL)
+    {
+      par->failed = true;
+      return;
+    }
+
+  for (i = 0; i < par->nprep; i++)
+    {
+      struct sec_merge_prep *prep = &par->preps[i];
+      bfd_vma mask = ((bfd_vma) 1 << prep->secinfo->sec->alignment_power) - 1;
+
+      if (prep->part_start == NULL)
+	continue;
+      for (j = prep->part_start[part]; j < prep->part_start[part + 1]; j++)
+	{
+	  unsigned int k = prep->order[j];
+	  unsigned int ofs = prep->ofs[k];
+	  unsigned int len = prep->ofs[k + 1] - ofs;
+	  const char *str = (const char *) prep->contents + ofs;
+	  uint32_t hash = prep->hash[k];
+	  uint64_t hlen = ((uint64_t) hash << 32) | len;
+	  unsigned int idx = hash & (pp->nbuckets - 1);
+	  struct sec_merge_rep *rep;
+	  bfd_vma eltalign;
+
+	  /* The same alignment rule as record_section.  */
+	  eltalign = ofs;
+	  eltalign = ((eltalign ^ (eltalign - 1)) + 1) >> 1;
+	  if (!eltalign || eltalign > mask)
+	    eltalign = mask + 1;
+
+	  for (;;)
+	    {
+	      rep = pp->values[idx];
+	      if (rep == NULL)
+		{
+		  rep = &pp->reps[pp->nreps++];
+		  rep->str = str;
+		  rep->len = len;
+		  rep->alignment = eltalign;
+		  rep->entry = NULL;
+		  pp->key_lens[idx] = hlen;
+		  pp->values[idx] = rep;
+		  break;
+		}
+	      if (pp->key_lens[idx] == hlen
+		  && memcmp (rep->str, str, len) == 0)
+		{
+		  if (rep->alignment < eltalign)
+		    rep->alignment = eltalign;
+		  break;
+		}
+	      idx = (idx + 1) & (pp->nbuckets - 1);
+	    }
+	  prep->rep[k] = rep;
+	}
+    }
+}
+
+/* Record all the sections of SINFO into its hash table, like
+   record_section, using up to THREADS threads.  */
+
+static bool
+record_sections_parallel (struct sec_merge_info *sinfo, unsigned int threads)
+{
+  struct sec_merge_hash *htab = sinfo->htab;
+  struct sec_merge_parallel par;
+  struct sec_merge_sec_info *secinfo;
+  unsigned int i, j, nparts;
+  bool ret = false;
+
+  memset (&par, 0, sizeof (par));
+  par.htab = htab;
+  for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
+    if (!(secinfo->sec->flags & SEC_EXCLUDE))
+      par.nprep++;
+  par.preps = bfd_zmalloc (par.nprep * sizeof (*par.preps));
+  while ((1u << par.part_bits) < threads && par.part_bits < 6)
+    par.part_bits++;
+  nparts = 1u << par.part_bits;
+  par.parts = bfd_zmalloc (nparts * sizeof (*par.parts));
+  if (par.preps == NULL || par.parts == NULL)
+    goto out;
+
+  /* Slurp in all the section contents (possibly decompressing them).  */
+  i = 0;
+  for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
+    {
+      asection *sec = secinfo->sec;
+      bfd_size_type amt;
+
+      if (sec->flags & SEC_EXCLUDE)
+	continue;
+      par.preps[i].secinfo = secinfo;
+      amt = sec->size;
+      if (sec->flags & SEC_STRINGS)
+	/* Allow for a missing zero terminator, as record_section does.  */
+	amt += sec->entsize;
+      par.preps[i].contents = bfd_malloc (amt);
+      if (par.preps[i].contents == NULL)
+	goto out;
+      sec->rawsize = sec->size;
+      if (sec->flags & SEC_STRINGS)
+	memset (par.preps[i].contents + sec->size, 0, sec->entsize);
+      if (! bfd_get_full_section_contents (sec->owner, sec,
+					   &par.preps[i].contents))
+	goto out;
+      i++;
+    }
+
+  _bfd_parallel_for (threads, par.nprep, sec_merge_split_section, &par);
+  if (par.failed)
+    goto no_memory;
+  _bfd_parallel_for (threads, nparts, sec_merge_find_reps, &par);
+  if (par.failed)
+    goto no_memory;
+
+  /* Make the hash table entries in order of first appearance, and the
+     offset mappings.  The entries are only chained together, as
+     nothing looks them up after this.  */
+  for (i = 0; i < par.nprep; i++)
+    {
+      struct sec_merge_prep *prep = &par.preps[i];
+
+      secinfo = prep->secinfo;
+      for (j = 0; j < prep->count; j++)
+	{
+	  struct sec_merge_rep *rep = prep->rep[j];
+
+	  if (rep->entry == NULL)
+	    {
+	      struct sec_merge_hash_entry *e;
+	      unsigned int amt = rep->len + sizeof (*e);
+
+	      e = (struct sec_merge_hash_entry *)
+		bfd_hash_allocate (&htab->table, amt);
+	      if (e == NULL)
+		goto out;
+	      memcpy (e->str, rep->str, rep->len);
+	      e->len = rep->len;
+	      e->alignment = rep->alignment;
+	      e->u.suffix = NULL;
+	      e->next = NULL;
+	      htab->table.count++;
+	      htab->size++;
+	      if (htab->first == NULL)
+		htab->first = e;
+	      else
+		htab->last->next = e;
+	      htab->last = e;
+	      rep->entry = e;
+	    }
+	  if (! append_offsetmap (secinfo, prep->ofs[j], rep->entry))
+	    goto out;
+	}
+
+      /* Add a sentinel element that's conceptually behind all others.  */
+      append_offsetmap (secinfo, secinfo->sec->size, NULL);
+      /* But don't count it.  */
+      secinfo->noffsetmap--;
+    }
+  ret = true;
+  goto out;
+
+ no_memory:
+  bfd_set_error (bfd_error_no_memory);
+ out:
+  if (par.preps != NULL)
+    for (i = 0; i < par.nprep; i++)
+      {
+	free (par.preps[i].contents);
+	free (par.preps[i].ofs);
+	free (par.preps[i].hash);
+	free (par.preps[i].order);
+	free (par.preps[i].part_start);
+	free (par.preps[i].rep);
+      }
+  if (par.parts != NULL)
+    for (i = 0; i < nparts; i++)
+      {
+	free (par.parts[i].key_lens);
+	free (par.parts[i].values);
+	free (par.parts[i].reps);
+      }
+  free (par.preps);
+  free (par.parts);
+  if (!ret)
+    for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
+      *secinfo->psecinfo = NULL;
+  return ret;
+}
+
 /* qsort comparison function.  Won't ever return zero as all entries
    differ, so there is no issue with qsort stability here.  */
 
@@ -834,6 +1195,161 @@ strrevcmp_align (const void *a, const void *b)
   return lenA - lenB;
 }
 
+/* Buckets with fewer entries than this are finished off by
+   strrev_radix_sort with qsort.  */
+#define STRREV_RADIX_MIN 64
+
+/* A bucket still to be sorted by strrev_radix_sort: N entries starting
+   at START, all of whose last DEPTH octets are the same.  */
+
+struct strrev_bucket
+{
+  size_t start;
+  size_t n;
+  unsigned int depth;
+};
+
+/* Sort the N entries of ARRAY into the same order as qsort with
+   strrevcmp would, using TMP (also of N entries) as scratch space.
+   This is an MSD radix sort on the strings read backwards, with an
+   end-of-string key sorting before every octet value.  Return false
+   if we run out of memory, leaving ARRAY in some order.  */
+
+static bool
+strrev_radix_sort (struct sec_merge_hash_entry **array,
+		   struct sec_merge_hash_entry **tmp, size_t n)
+{
+  struct strrev_bucket *stack;
+  size_t nstack, maxstack;
+  size_t count[257];
+
+  maxstack = 256;
+  stack = bfd_malloc (maxstack * sizeof (*stack));
+  if (stack == NULL)
+    return false;
+  stack[0].start = 0;
+  stack[0].n = n;
+  stack[0].depth = 0;
+  nstack = 1;
+
+  while (nstack != 0)
+    {
+      struct strrev_bucket b = stack[--nstack];
+      struct sec_merge_hash_entry **a = array + b.start;
+      size_t i, pos;
+      unsigned int k;
+
+      if (b.n < STRREV_RADIX_MIN)
+	{
+	  qsort (a, b.n, sizeof (*a), strrevcmp);
+	  continue;
+	}
+
+      /* Key 0 is for strings no longer than DEPTH, of which there is
+	 at most one as all entries differ; key C + 1 for octet C.  */
+      memset (count, 0, sizeof (count));
+      for (i = 0; i < b.n; i++)
+	{
+	  struct sec_merge_hash_entry *e = a[i];
+	  k = (e->len > b.depth
+	       ? (unsigned char) e->str[e->len - 1 - b.depth] + 1 : 0);
+	  count[k]++;
+	}
+
+      if (nstack + 256 > maxstack)
+	{
+	  struct strrev_bucket *newstack;
+
+	  maxstack *= 2;
+	  newstack = bfd_realloc (stack, maxstack * sizeof (*stack));
+	  if (newstack == NULL)
+	    {
+	      free (stack);
+	      return false;
+	    }
+	  stack = newstack;
+	}
+
+      /* Turn the counts into bucket starts, queueing up the buckets
+	 that need more sorting.  */
+      pos = 0;
+      for (k = 0; k < 257; k++)
+	{
+	  size_t c = count[k];
+
+	  count[k] = pos;
+	  if (k != 0 && c > 1)
+	    {
+	      stack[nstack].start = b.start + pos;
+	      stack[nstack].n = c;
+	      stack[nstack].depth = b.depth + 1;
+	      nstack++;
+	    }
+	  pos += c;
+	}
+
+      for (i = 0; i < b.n; i++)
+	{
+	  struct sec_merge_hash_entry *e = a[i];
+	  k = (e->len > b.depth
+	       ? (unsigned char) e->str[e->len - 1 - b.depth] + 1 : 0);
+	  tmp[count[k]++] = e;
+	}
+      memcpy (a, tmp, b.n * sizeof (*a));
+    }
+
+  free (stack);
+  return true;
+}
+
+/* Sort the N entries of ARRAY into the same order as qsort with
+   strrevcmp_align would, where ALIGNMENT is the alignment shared by
+   all the entries.  */
+
+static bool
+strrev_radix_sort_align (struct sec_merge_hash_entry **array,
+			 struct sec_merge_hash_entry **tmp, size_t n,
+			 unsigned int alignment)
+{
+  size_t *count;
+  size_t i, pos;
+  unsigned int k;
+
+  /* Group the entries by the length of their tail past the last
+     ALIGNMENT boundary, then sort each group.  */
+  count = bfd_zmalloc ((alignment + 1) * sizeof (*count));
+  if (count == NULL)
+    return false;
+  for (i = 0; i < n; i++)
+    count[array[i]->len & (alignment - 1)]++;
+  pos = 0;
+  for (k = 0; k < alignment; k++)
+    {
+      size_t c = count[k];
+
+      count[k] = pos;
+      pos += c;
+    }
+  count[alignment] = n;
+  for (i = 0; i < n; i++)
+    tmp[count[array[i]->len & (alignment - 1)]++] = array[i];
+  memcpy (array, tmp, n * sizeof (*array));
+
+  /* COUNT[K] is now the end of group K and the start of group K + 1.  */
+  pos = 0;
+  for (k = 0; k < alignment; k++)
+    {
+      if (!strrev_radix_sort (array + pos, tmp, count[k] - pos))
+	{
+	  free (count);
+	  return false;
+	}
+      pos = count[k];
+    }
+  free (count);
+  return true;
+}
+
 static inline int
 is_suffix (const struct sec_merge_hash_entry *A,
 	   const struct sec_merge_hash_entry *B)
@@ -852,7 +1368,7 @@ is_suffix (const struct sec_merge_hash_entry *A,
 static struct sec_merge_sec_info *
 merge_strings (struct sec_merge_info *sinfo)
 {
-  struct sec_merge_hash_entry **array, **a, *e;
+  struct sec_merge_hash_entry **array, **tmp, **a, *e;
   struct sec_merge_sec_info *secinfo;
   bfd_size_type size, amt;
   unsigned int alignment = 0;
@@ -862,6 +1378,7 @@ merge_strings (struct sec_merge_info *sinfo)
   array = (struct sec_merge_hash_entry **) bfd_malloc (amt);
   if (array == NULL)
     return NULL;
+  tmp = (struct sec_merge_hash_entry **) bfd_malloc (amt);
 
   for (e = sinfo->htab->first, a = array; e; e = e->next)
     if (e->alignment)
@@ -881,10 +1398,21 @@ merge_strings (struct sec_merge_info *sinfo)
   sinfo->htab->size = a - array;
   if (sinfo->htab->size != 0)
     {
-      qsort (array, (size_t) sinfo->htab->size,
-	     sizeof (struct sec_merge_hash_entry *),
-	     (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize
-	      ? strrevcmp_align : strrevcmp));
+      bool aligned = (alignment != (unsigned) -1
+		      && alignment > sinfo->htab->entsize);
+
+      /* The radix sort gives the same order as qsort would, faster,
+	 but needs scratch space.  Strings that need an alignment
+	 unusually large for string sections are left to qsort.  */
+      if (tmp == NULL
+	  || (aligned
+	      ? (alignment > 256
+		 || !strrev_radix_sort_align (array, tmp, sinfo->htab->size,
+					      alignment))
+	      : !strrev_radix_sort (array, tmp, sinfo->htab->size)))
+	qsort (array, (size_t) sinfo->htab->size,
+	       sizeof (struct sec_merge_hash_entry *),
+	       aligned ? strrevcmp_align : strrevcmp);
 
       /* Loop over the sorted array and merge suffixes */
       e = *--a;
@@ -906,6 +1434,7 @@ merge_strings (struct sec_merge_info *sinfo)
 	}
     }
 
+  free (tmp);
   free (array);
 
   /* Now assign positions to the strings we want to keep.  */
@@ -948,7 +1477,7 @@ merge_strings (struct sec_merge_info *sinfo)
 
 bool
 _bfd_merge_sections (bfd *abfd,
-		     struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		     struct bfd_link_info *info,
 		     void *xsinfo,
 		     void (*remove_hook) (bfd *, asection *))
 {
@@ -958,10 +1487,18 @@ _bfd_merge_sections (bfd *abfd,
     {
       struct sec_merge_sec_info *secinfo;
       bfd_size_type align;  /* Bytes.  */
+      bool parallel;
 
       if (! sinfo->chain)
 	continue;
 
+      /* Sections are recorded one by one, unless there are threads to
+	 share out the work of several of them.  */
+      parallel = (BFD_SUPPORTS_THREADS
+		  && info != NULL
+		  && info->threads > 1
+		  && sinfo->chain->next != NULL);
+
       /* Record the sections into the hash table.  */
       align = 1;
       for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
@@ -973,7 +1510,7 @@ _bfd_merge_sections (bfd *abfd,
 	  }
 	else
 	  {
-	    if (!record_section (sinfo, secinfo))
+	    if (!parallel && !record_section (sinfo, secinfo))
 	      return false;
 	    if (align)
 	      {
@@ -985,6 +1522,9 @@ _bfd_merge_sections (bfd *abfd,
 	      }
 	  }
 
+      if (parallel && !record_sections_parallel (sinfo, info->threads))
+	return false;
+
       if (sinfo->htab->first == NULL)
 	continue;
 
@@ -160,6 +160,8 @@ _bfd_delete_bfd (bfd *abfd)
   if (abfd->memory && abfd->xvec)
     bfd_free_cached_info (abfd);
 
+  _bfd_free_section_views (abfd);
+
   /* The target _bfd_free_cached_info may not have done anything..  */
   if (abfd->memory)
     {
@@ -212,6 +214,7 @@ _bfd_free_cached_info (bfd *abfd)
 	  memcpy (copy, filename, len);
 	  abfd->filename = copy;
 	}
+      _bfd_free_section_views (abfd);
       bfd_hash_table_free (&abfd->section_htab);
       objalloc_free ((struct objalloc *) abfd->memory);
 
@@ -793,6 +796,46 @@ bfd_openw (const char *filename, const char *target)
   return nbfd;
 }
 
+/*
+FUNCTION
+	bfd_openw_memory
+
+SYNOPSIS
+	bfd *bfd_openw_memory (const char *filename, const char *target);
+
+DESCRIPTION
+	Create a BFD in the manner of <<bfd_openw>>, using the file
+	format @var{target}, but write it to memory rather than to a
+	file.  @var{filename} is only used as the name of the BFD, for
+	example as the name of an archive element.  Unlike
+	<<bfd_create>> the format is not set, so the BFD can be written
+	either through <<bfd_set_format>> or with plain <<bfd_write>>.
+	Call <<bfd_make_readable>> to read the result back.
+
+	Possible errors are <<bfd_error_no_memory>> and
+	<<bfd_error_invalid_target>>.
+*/
+
+bfd *
+bfd_openw_memory (const char *filename, const char *target)
+{
+  bfd *nbfd;
+
+  nbfd = _bfd_new_bfd ();
+  if (nbfd == NULL)
+    return NULL;
+
+  if (bfd_find_target (target, nbfd) == NULL
+      || !bfd_set_filename (nbfd, filename)
+      || !bfd_make_writable (nbfd))
+    {
+      _bfd_delete_bfd (nbfd);
+      return NULL;
+    }
+
+  return nbfd;
+}
+
 /*
 FUNCTION
 	bfd_elf_bfd_from_remote_memory
@@ -844,6 +887,7 @@ _maybe_make_executable (bfd * abfd)
   /* If the file was open for writing and is now executable,
      make it so.  */
   if (abfd->direction == write_direction
+      && (abfd->flags & BFD_IN_MEMORY) == 0
       && (abfd->flags & (EXEC_P | DYNAMIC)) != 0)
     {
       struct stat buf;
@@ -1025,10 +1069,12 @@ SYNOPSIS
 
 DESCRIPTION
 	Takes a BFD as created by <<bfd_create>> and
-	<<bfd_make_writable>> and converts it into one like as
-	returned by <<bfd_openr>>.  It does this by writing the
-	contents out to the memory buffer, then reversing the
-	direction.
+	<<bfd_make_writable>>, or by <<bfd_openw_memory>>, and
+	converts it into one like as returned by <<bfd_openr>>.  It
+	does this by writing the contents out to the memory buffer,
+	then reversing the direction.  If the format of the BFD was
+	never set, what was written with <<bfd_write>> is kept as it
+	is.
 
 	<<TRUE>> is returned if all is ok, otherwise <<FALSE>>.  */
 
@@ -1041,7 +1087,8 @@ bfd_make_readable (bfd *abfd)
       return false;
     }
 
-  if (! BFD_SEND_FMT (abfd, _bfd_write_contents, (abfd)))
+  if (abfd->format != bfd_unknown
+      && ! BFD_SEND_FMT (abfd, _bfd_write_contents, (abfd)))
     return false;
 
   if (! BFD_SEND (abfd, _close_and_cleanup, (abfd)))
@@ -1060,6 +1107,7 @@ bfd_make_readable (bfd *abfd)
   abfd->cacheable = false;
   abfd->flags |= BFD_IN_MEMORY;
   abfd->mtime_set = false;
+  abfd->mode_set = false;
 
   abfd->target_defaulted = true;
   abfd->direction = read_direction;
@@ -133,6 +133,9 @@ SUBSECTION
 #include "bfd.h"
 #include "libbfd.h"
 #include "bfdlink.h"
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 /*
 DOCDD
@@ -1628,6 +1631,225 @@ bfd_malloc_and_get_section (bfd *abfd, sec_ptr sec, bfd_byte **buf)
   *buf = NULL;
   return bfd_get_full_section_contents (abfd, sec, buf);
 }
+
+/* A view of the contents of SECTION, shared by all the callers of
+   bfd_get_section_view which have not yet released it.  */
+
+struct bfd_section_view
+{
+  struct bfd_section_view *next;
+  asection *section;
+  bfd_byte *data;
+  bfd_size_type size;
+  unsigned int refcount;
+  /* Whether DATA was malloc'd for the view.  */
+  bool malloced;
+  /* The page aligned region of the file mapped for the view, or NULL
+     if DATA was not mapped.  */
+  void *map_addr;
+  bfd_size_type map_len;
+};
+
+/* Sections smaller than this are read rather than mapped; a mapping
+   costs more than copying a few pages.  */
+#define SECTION_VIEW_MMAP_MIN 0x10000
+
+/* Try to map the contents of SEC, which are SIZE bytes, from the file
+   of ABFD into VIEW.  */
+
+static bool
+map_section_view (bfd *abfd ATTRIBUTE_UNUSED,
+		  asection *sec ATTRIBUTE_UNUSED,
+		  bfd_size_type size ATTRIBUTE_UNUSED,
+		  struct bfd_section_view *view ATTRIBUTE_UNUSED)
+{
+#ifdef HAVE_MMAP
+  ufile_ptr filesize;
+  void *data;
+
+  /* Only map sections which bfd_get_section_contents would simply
+     read from the file.  Reading past the end of a mapping raises
+     SIGBUS, so leave a section which claims to extend beyond the end
+     of the file to the read, which diagnoses it.  */
+  if (size < SECTION_VIEW_MMAP_MIN
+      || abfd->direction != read_direction
+      || (abfd->flags & BFD_IN_MEMORY) != 0
+      || (sec->flags & (SEC_HAS_CONTENTS | SEC_IN_MEMORY)) != SEC_HAS_CONTENTS
+      || sec->compress_status != COMPRESS_SECTION_NONE
+      || abfd->xvec->_bfd_get_section_contents
+	 != _bfd_generic_get_section_contents
+      || sec->filepos < 0)
+    return false;
+
+  filesize = bfd_get_file_size (abfd);
+  if (filesize == 0
+      || (ufile_ptr) sec->filepos > filesize
+      || size > filesize - sec->filepos)
+    return false;
+
+  data = bfd_mmap (abfd, NULL, size, PROT_READ, MAP_PRIVATE, sec->filepos,
+		   &view->map_addr, &view->map_len);
+  if (data == (void *) -1)
+    return false;
+
+  view->data = data;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*
+FUNCTION
+	bfd_get_section_view
+
+SYNOPSIS
+	bool bfd_get_section_view
+	  (bfd *abfd, asection *section, const bfd_byte **view,
+	   bfd_size_type *size);
+
+DESCRIPTION
+	Set *@var{view} to point to all the data of @var{section} in
+	BFD @var{abfd}, and *@var{size} to its size.  Large sections
+	of input files are mapped from the file rather than copied
+	where that is possible.  Compressed sections are decompressed
+	into a buffer, and other sections are read into a buffer.
+	Repeated requests for the same section share one view, which
+	lasts until each of them has been passed to
+	@code{bfd_release_section_view}.  The data must not be
+	modified.  An empty section gives a NULL *@var{view} which need
+	not be released.
+	Return @code{true} on success, @code{false} on failure in which
+	case *@var{view} will be NULL.
+*/
+
+bool
+bfd_get_section_view (bfd *abfd, asection *section, const bfd_byte **view,
+		      bfd_size_type *size)
+{
+  struct bfd_section_view *v;
+  bfd_size_type sz;
+
+  *view = NULL;
+  *size = 0;
+
+  for (v = abfd->section_views; v != NULL; v = v->next)
+    if (v->section == section)
+      {
+	v->refcount++;
+	*view = v->data;
+	*size = v->size;
+	return true;
+      }
+
+  sz = bfd_get_section_limit_octets (abfd, section);
+  if (bfd_get_section_alloc_size (abfd, section) == 0)
+    return true;
+
+  v = (struct bfd_section_view *) bfd_zmalloc (sizeof (*v));
+  if (v == NULL)
+    return false;
+
+  if ((section->flags & SEC_IN_MEMORY) != 0
+      && section->contents != NULL
+      && section->compress_status == COMPRESS_SECTION_NONE)
+    v->data = section->contents;
+  else if (!map_section_view (abfd, section, sz, v))
+    {
+      if (!bfd_get_full_section_contents (abfd, section, &v->data))
+	{
+	  free (v);
+	  return false;
+	}
+      v->malloced = true;
+    }
+
+  v->section = section;
+  v->size = sz;
+  v->refcount = 1;
+  v->next = abfd->section_views;
+  abfd->section_views = v;
+  *view = v->data;
+  *size = sz;
+  return true;
+}
+
+/* Free the memory or mapping behind V.  */
+
+static void
+free_section_view (struct bfd_section_view *v)
+{
+#ifdef HAVE_MMAP
+  if (v->map_addr != NULL)
+    munmap (v->map_addr, v->map_len);
+#endif
+  if (v->malloced)
+    free (v->data);
+  free (v);
+}
+
+/*
+FUNCTION
+	bfd_release_section_view
+
+SYNOPSIS
+	bool bfd_release_section_view (bfd *abfd, const void *view);
+
+DESCRIPTION
+	Release @var{view}, which was returned by
+	@code{bfd_get_section_view} for a section of @var{abfd}.  The
+	view is freed or unmapped when it has been released as many
+	times as it was handed out.  Return @code{true} if @var{view}
+	was such a view, or @code{false} if it was not, so that a
+	caller which mixes views and buffers of its own can free the
+	latter.
+*/
+
+bool
+bfd_release_section_view (bfd *abfd, const void *view)
+{
+  struct bfd_section_view **pv, *v;
+
+  if (view == NULL)
+    return false;
+
+  for (pv = &abfd->section_views; (v = *pv) != NULL; pv = &v->next)
+    if (v->data == view)
+      {
+	if (--v->refcount == 0)
+	  {
+	    *pv = v->next;
+	    free_section_view (v);
+	  }
+	return true;
+      }
+  return false;
+}
+
+/*
+INTERNAL_FUNCTION
+	_bfd_free_section_views
+
+SYNOPSIS
+	void _bfd_free_section_views (bfd *abfd);
+
+DESCRIPTION
+	Free all the section views of @var{abfd}, whether released or
+	not.  Called when the sections of @var{abfd} go away.
+*/
+
+void
+_bfd_free_section_views (bfd *abfd)
+{
+  struct bfd_section_view *v, *next;
+
+  for (v = abfd->section_views; v != NULL; v = next)
+    {
+      next = v->next;
+      free_section_view (v);
+    }
+  abfd->section_views = NULL;
+}
 /*
 FUNCTION
 	bfd_copy_private_section_data
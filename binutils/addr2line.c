@@ -28,7 +28,10 @@
    addr2line [options]
 
    both forms write results to stdout, the second form reads addresses
-   to be converted from stdin.  */
+   to be converted from stdin.
+
+   addr2line --batch [options] [-e executable]...
+   reads batches of requests from stdin, see translate_batches.  */
 
 #include "sysdep.h"
 #include "bfd.h"
@@ -38,6 +41,7 @@
 #include "bucomm.h"
 #include "elf-bfd.h"
 #include "safe-ctype.h"
+#include "hashtab.h"
 
 static bool unwind_inlines;	/* -i, unwind inlined functions. */
 static bool with_addresses;	/* -a, show addresses.  */
@@ -45,6 +49,7 @@ static bool with_functions;	/* -f, show function names.  */
 static bool do_demangle;	/* -C, demangle names.  */
 static bool pretty_print;	/* -p, print on one line.  */
 static bool base_names;		/* -s, strip directory names.  */
+static bool batch;		/* --batch, answer batches of requests.  */
 
 /* Flags passed to the name demangler.  */
 static int demangle_flags = DMGL_PARAMS | DMGL_ANSI;
@@ -55,13 +60,21 @@ static char **addr;		/* Hex addresses to process.  */
 static long symcount;
 static asymbol **syms;		/* Symbol table.  */
 
+enum option_values
+  {
+    OPTION_BATCH = 150,
+    OPTION_INDEX_CACHE
+  };
+
 static struct option long_options[] =
 {
   {"addresses", no_argument, NULL, 'a'},
   {"basenames", no_argument, NULL, 's'},
+  {"batch", no_argument, NULL, OPTION_BATCH},
   {"demangle", optional_argument, NULL, 'C'},
   {"exe", required_argument, NULL, 'e'},
   {"functions", no_argument, NULL, 'f'},
+  {"index-cache", required_argument, NULL, OPTION_INDEX_CACHE},
   {"inlines", no_argument, NULL, 'i'},
   {"pretty-print", no_argument, NULL, 'p'},
   {"recurse-limit", no_argument, NULL, 'R'},
@@ -80,6 +93,7 @@ static void slurp_symtab (bfd *);
 static void find_address_in_section (bfd *, asection *, void *);
 static void find_offset_in_section (bfd *, asection *);
 static void translate_addresses (bfd *, asection *);
+static void translate_batches (const char *, const char *);
 
 /* Print a usage message to STREAM and exit with STATUS.  */
 
@@ -92,9 +106,11 @@ usage (FILE *stream, int status)
   fprintf (stream, _(" The options are:\n\
   @<file>                Read options from <file>\n\
   -a --addresses         Show addresses\n\
+     --batch             Answer batches of \"ID [FILE] ADDR\" requests from stdin\n\
   -b --target=<bfdname>  Set the binary file format\n\
   -e --exe=<executable>  Set the input file name (default is a.out)\n\
   -i --inlines           Unwind inlined functions\n\
+     --index-cache=<dir> Keep indexes of the debug info of executables in <dir>\n\
   -j --section=<name>    Read section-relative offsets instead of addresses\n\
   -p --pretty-print      Make the output easier to read for humans\n\
   -s --basenames         Strip directory names\n\
@@ -280,6 +296,177 @@ is_symbol (char *adr, char **symp, size_t *offset)
   return true;
 }
 
+/* When COLLECT_OUTPUT, the output of translate_address is appended
+   to OUT_TEXT instead of being written to stdout.  */
+
+static bool collect_output;
+static char *out_text;
+static size_t out_len;
+static size_t out_size;
+
+static void out (const char *, ...) ATTRIBUTE_PRINTF_1;
+
+static void
+out (const char *format, ...)
+{
+  va_list args;
+  char *s;
+  size_t len;
+
+  va_start (args, format);
+  if (!collect_output)
+    {
+      vprintf (format, args);
+      va_end (args);
+      return;
+    }
+  s = xvasprintf (format, args);
+  va_end (args);
+
+  len = strlen (s);
+  if (out_len + len + 1 > out_size)
+    {
+      out_size = (out_len + len + 1) * 2;
+      out_text = (char *) xrealloc (out_text, out_size);
+    }
+  memcpy (out_text + out_len, s, len + 1);
+  out_len += len;
+  free (s);
+}
+
+/* Convert ADR, a hexadecimal address or a symbol with an optional
+   offset, into an address in ABFD.  */
+
+static bfd_vma
+parse_address (bfd *abfd, char *adr)
+{
+  char *symp;
+  size_t offset;
+  bfd_vma vma;
+
+  if (is_symbol (adr, &symp, &offset))
+    vma = lookup_symbol (abfd, symp, offset);
+  else
+    vma = bfd_scan_vma (adr, NULL, 16);
+  if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
+    {
+      const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+      bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
+
+      vma &= (sign << 1) - 1;
+      if (bed->sign_extend_vma)
+	vma = (vma ^ sign) - sign;
+    }
+  return vma;
+}
+
+/* Translate PC into file_name:line_number and optionally function
+   name.  */
+
+static void
+translate_address (bfd *abfd, asection *section)
+{
+  if (with_addresses)
+    {
+      char buf[30];
+
+      bfd_sprintf_vma (abfd, buf, pc);
+      out ("0x%s", buf);
+
+      if (pretty_print)
+	out (": ");
+      else
+	out ("\n");
+    }
+
+  found = false;
+  if (section)
+    find_offset_in_section (abfd, section);
+  else
+    bfd_map_over_sections (abfd, find_address_in_section, NULL);
+
+  if (! found)
+    {
+      if (with_functions)
+	{
+	  if (pretty_print)
+	    out ("?? ");
+	  else
+	    out ("??\n");
+	}
+      out ("??:0\n");
+    }
+  else
+    {
+      while (1)
+	{
+	  if (with_functions)
+	    {
+	      const char *name;
+	      char *alloc = NULL;
+
+	      name = functionname;
+	      if (name == NULL || *name == '\0')
+		name = "??";
+	      else if (do_demangle)
+		{
+		  alloc = bfd_demangle (abfd, name, demangle_flags);
+		  if (alloc != NULL)
+		    name = alloc;
+		}
+
+	      out ("%s", name);
+	      if (pretty_print)
+		/* Note for translators:  This printf is used to join the
+		   function name just printed above to the line number/
+		   file name pair that is about to be printed below.  Eg:
+
+		     foo at 123:bar.c  */
+		out (_(" at "));
+	      else
+		out ("\n");
+
+	      free (alloc);
+	    }
+
+	  if (base_names && filename != NULL)
+	    {
+	      char *h;
+
+	      h = strrchr (filename, '/');
+	      if (h != NULL)
+		filename = h + 1;
+	    }
+
+	  out ("%s:", filename ? filename : "??");
+	  if (line != 0)
+	    {
+	      if (discriminator != 0)
+		out ("%u (discriminator %u)\n", line, discriminator);
+	      else
+		out ("%u\n", line);
+	    }
+	  else
+	    out ("?\n");
+	  if (!unwind_inlines)
+	    found = false;
+	  else
+	    found = bfd_find_inliner_info (abfd, &filename, &functionname,
+					   &line);
+	  if (! found)
+	    break;
+	  if (pretty_print)
+	    /* Note for translators: This printf is used to join the
+	       line number/file name pair that has just been printed with
+	       the line number/file name pair that is going to be printed
+	       by the next iteration of the while loop.  Eg:
+
+		 123:bar.c (inlined by) 456:main.c  */
+	    out (_(" (inlined by) "));
+	}
+    }
+}
+
 /* Read hexadecimal or symbolic with offset addresses from stdin, translate into
    file_name:line_number and optionally function name.  */
 
@@ -289,8 +476,6 @@ translate_addresses (bfd *abfd, asection *section)
   int read_stdin = (naddr == 0);
   char *adr;
   char addr_hex[100];
-  char *symp;
-  size_t offset;
 
   for (;;)
     {
@@ -308,117 +493,8 @@ translate_addresses (bfd *abfd, asection *section)
 	  adr = *addr++;
 	}
 
-      if (is_symbol (adr, &symp, &offset))
-        pc = lookup_symbol (abfd, symp, offset);
-      else
-        pc = bfd_scan_vma (adr, NULL, 16);
-      if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
-	{
-	  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
-	  bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
-
-	  pc &= (sign << 1) - 1;
-	  if (bed->sign_extend_vma)
-	    pc = (pc ^ sign) - sign;
-	}
-
-      if (with_addresses)
-        {
-          printf ("0x");
-          bfd_printf_vma (abfd, pc);
-
-          if (pretty_print)
-            printf (": ");
-          else
-            printf ("\n");
-        }
-
-      found = false;
-      if (section)
-	find_offset_in_section (abfd, section);
-      else
-	bfd_map_over_sections (abfd, find_address_in_section, NULL);
-
-      if (! found)
-	{
-	  if (with_functions)
-	    {
-	      if (pretty_print)
-		printf ("?? ");
-	      else
-		printf ("??\n");
-	    }
-	  printf ("??:0\n");
-	}
-      else
-	{
-	  while (1)
-            {
-              if (with_functions)
-                {
-                  const char *name;
-                  char *alloc = NULL;
-
-                  name = functionname;
-                  if (name == NULL || *name == '\0')
-                    name = "??";
-                  else if (do_demangle)
-                    {
-                      alloc = bfd_demangle (abfd, name, demangle_flags);
-                      if (alloc != NULL)
-                        name = alloc;
-                    }
-
-                  printf ("%s", name);
-                  if (pretty_print)
-		    /* Note for translators:  This printf is used to join the
-		       function name just printed above to the line number/
-		       file name pair that is about to be printed below.  Eg:
-
-		         foo at 123:bar.c  */
-                    printf (_(" at "));
-                  else
-                    printf ("\n");
-
-		  free (alloc);
-                }
-
-              if (base_names && filename != NULL)
-                {
-                  char *h;
-
-                  h = strrchr (filename, '/');
-                  if (h != NULL)
-                    filename = h + 1;
-                }
-
-              printf ("%s:", filename ? filename : "??");
-	      if (line != 0)
-                {
-                  if (discriminator != 0)
-                    printf ("%u (discriminator %u)\n", line, discriminator);
-                  else
-                    printf ("%u\n", line);
-                }
-	      else
-		printf ("?\n");
-              if (!unwind_inlines)
-                found = false;
-              else
-                found = bfd_find_inliner_info (abfd, &filename, &functionname,
-					       &line);
-              if (! found)
-                break;
-              if (pretty_print)
-		/* Note for translators: This printf is used to join the
-		   line number/file name pair that has just been printed with
-		   the line number/file name pair that is going to be printed
-		   by the next iteration of the while loop.  Eg:
-
-		     123:bar.c (inlined by) 456:main.c  */
-                printf (_(" (inlined by) "));
-            }
-	}
+      pc = parse_address (abfd, adr);
+      translate_address (abfd, section);
 
       /* fflush() is essential for using this command as a server
          child process that reads addresses from a pipe and responds
@@ -428,22 +504,26 @@ translate_addresses (bfd *abfd, asection *section)
     }
 }
 
-/* Process a file.  Returns an exit value for main().  */
+/* Open FILE_NAME and check that it is an object file.  Set *SECTION
+   to its section called SECTION_NAME, if SECTION_NAME is not NULL.
+   Return NULL after reporting an error if any of that fails.  */
 
-static int
-process_file (const char *file_name, const char *section_name,
-	      const char *target)
+static bfd *
+open_file (const char *file_name, const char *section_name,
+	   const char *target, asection **section)
 {
   bfd *abfd;
-  asection *section;
   char **matching;
 
   if (get_file_size (file_name) < 1)
-    return 1;
+    return NULL;
 
   abfd = bfd_openr (file_name, target);
   if (abfd == NULL)
-    bfd_fatal (file_name);
+    {
+      bfd_nonfatal (file_name);
+      return NULL;
+    }
 
   /* Decompress sections.  */
   abfd->flags |= BFD_DECOMPRESS;
@@ -452,7 +532,7 @@ process_file (const char *file_name, const char *section_name,
     {
       non_fatal (_("%s: cannot get addresses from archive"), file_name);
       bfd_close (abfd);
-      return 1;
+      return NULL;
     }
 
   if (! bfd_check_format_matches (abfd, bfd_object, &matching))
@@ -461,21 +541,37 @@ process_file (const char *file_name, const char *section_name,
       if (bfd_get_error () == bfd_error_file_ambiguously_recognized)
 	list_matching_formats (matching);
       bfd_close (abfd);
-      return 1;
+      return NULL;
     }
 
   if (section_name != NULL)
     {
-      section = bfd_get_section_by_name (abfd, section_name);
-      if (section == NULL)
+      *section = bfd_get_section_by_name (abfd, section_name);
+      if (*section == NULL)
 	{
 	  non_fatal (_("%s: cannot find section %s"), file_name, section_name);
 	  bfd_close (abfd);
-	  return 1;
+	  return NULL;
 	}
     }
   else
-    section = NULL;
+    *section = NULL;
+
+  return abfd;
+}
+
+/* Process a file.  Returns an exit value for main().  */
+
+static int
+process_file (const char *file_name, const char *section_name,
+	      const char *target)
+{
+  bfd *abfd;
+  asection *section;
+
+  abfd = open_file (file_name, section_name, target, &section);
+  if (abfd == NULL)
+    return 1;
 
   slurp_symtab (abfd);
 
@@ -488,7 +584,388 @@ process_file (const char *file_name, const char *section_name,
 
   return 0;
 }
-
+
+/* A binary opened by --batch.  Files with the same build-id share one
+   binary, and so share its translations.  */
+
+struct batch_binary
+{
+  struct batch_binary *next;
+  /* The order in which the binary was opened.  */
+  unsigned int index;
+  /* The build-id in hex, or the file name if there is no build-id.  */
+  char *key;
+  bfd *abfd;
+  asection *section;
+  asymbol **syms;
+  long symcount;
+  /* The struct batch_result for each address translated so far.  */
+  htab_t results;
+};
+
+/* A name by which requests refer to a binary.  BINARY is NULL if the
+   file could not be opened.  */
+
+struct batch_name
+{
+  struct batch_name *next;
+  char *name;
+  struct batch_binary *binary;
+};
+
+struct batch_result
+{
+  bfd_vma pc;
+  char *text;
+};
+
+/* One request of a batch.  */
+
+struct batch_request
+{
+  char *id;
+  struct batch_binary *binary;
+  bfd_vma pc;
+  const char *text;
+};
+
+static struct batch_binary *batch_binaries;
+static unsigned int batch_nbinaries;
+static struct batch_name *batch_names;
+
+/* The -e options, in order.  */
+static const char **exe_names;
+static int nexe_names;
+
+static hashval_t
+batch_result_hash (const void *p)
+{
+  const struct batch_result *r = (const struct batch_result *) p;
+
+  return iterative_hash (&r->pc, sizeof (r->pc), 0);
+}
+
+static int
+batch_result_eq (const void *p1, const void *p2)
+{
+  const struct batch_result *r1 = (const struct batch_result *) p1;
+  const struct batch_result *r2 = (const struct batch_result *) p2;
+
+  return r1->pc == r2->pc;
+}
+
+static void
+batch_result_del (void *p)
+{
+  struct batch_result *r = (struct batch_result *) p;
+
+  free (r->text);
+  free (r);
+}
+
+/* Return the key of binary ABFD, called FILE_NAME.  */
+
+static char *
+batch_key (bfd *abfd, const char *file_name)
+{
+  const struct bfd_build_id *build_id = abfd->build_id;
+  char *key;
+  bfd_size_type i;
+
+  if (build_id == NULL || build_id->size == 0)
+    return xstrdup (file_name);
+
+  key = (char *) xmalloc (build_id->size * 2 + 1);
+  for (i = 0; i < build_id->size; i++)
+    sprintf (key + i * 2, "%02x", build_id->data[i]);
+  return key;
+}
+
+/* Return the binary called NAME, a file name or a build-id of a binary
+   already open, opening the file if need be.  Return NULL if it cannot
+   be opened.  */
+
+static struct batch_binary *
+batch_find_binary (const char *name, const char *section_name,
+		   const char *target)
+{
+  struct batch_name *n;
+  struct batch_binary *b;
+  asection *section;
+  bfd *abfd;
+  char *key;
+
+  for (n = batch_names; n != NULL; n = n->next)
+    if (strcmp (n->name, name) == 0)
+      return n->binary;
+  for (b = batch_binaries; b != NULL; b = b->next)
+    if (strcmp (b->key, name) == 0)
+      return b;
+
+  n = (struct batch_name *) xmalloc (sizeof (*n));
+  n->name = xstrdup (name);
+  n->binary = NULL;
+  n->next = batch_names;
+  batch_names = n;
+
+  abfd = open_file (name, section_name, target, &section);
+  if (abfd == NULL)
+    return NULL;
+
+  key = batch_key (abfd, name);
+  for (b = batch_binaries; b != NULL; b = b->next)
+    if (strcmp (b->key, key) == 0)
+      {
+	free (key);
+	bfd_close (abfd);
+	n->binary = b;
+	return b;
+      }
+
+  b = (struct batch_binary *) xmalloc (sizeof (*b));
+  b->index = batch_nbinaries++;
+  b->key = key;
+  b->abfd = abfd;
+  b->section = section;
+  slurp_symtab (abfd);
+  b->syms = syms;
+  b->symcount = symcount;
+  syms = NULL;
+  symcount = 0;
+  b->results = htab_create_alloc (1024, batch_result_hash, batch_result_eq,
+				  batch_result_del, xcalloc, free);
+  b->next = batch_binaries;
+  batch_binaries = b;
+  n->binary = b;
+  return b;
+}
+
+/* Sort requests by binary and then by address.  */
+
+static int
+batch_request_cmp (const void *p1, const void *p2)
+{
+  const struct batch_request *r1 = *(const struct batch_request **) p1;
+  const struct batch_request *r2 = *(const struct batch_request **) p2;
+
+  if (r1->binary != r2->binary)
+    {
+      if (r1->binary == NULL || r2->binary == NULL)
+	return r1->binary == NULL ? -1 : 1;
+      return r1->binary->index < r2->binary->index ? -1 : 1;
+    }
+  if (r1->pc != r2->pc)
+    return r1->pc < r2->pc ? -1 : 1;
+  return 0;
+}
+
+/* Answer the NREQ requests in REQS.  */
+
+static void
+translate_batch (struct batch_request *reqs, size_t nreq)
+{
+  struct batch_request **sorted;
+  size_t i;
+
+  /* Translate in order of address, and each address only once, so that
+     the DWARF of each compilation unit is read once and then found in
+     the caches of bfd/dwarf2.c by the following requests.  */
+  sorted = (struct batch_request **) xmalloc (nreq * sizeof (*sorted));
+  for (i = 0; i < nreq; i++)
+    sorted[i] = &reqs[i];
+  qsort (sorted, nreq, sizeof (*sorted), batch_request_cmp);
+
+  collect_output = true;
+  for (i = 0; i < nreq; i++)
+    {
+      struct batch_request *req = sorted[i];
+      struct batch_binary *b = req->binary;
+      struct batch_result key, *result;
+      void **slot;
+
+      if (b == NULL)
+	continue;
+
+      key.pc = req->pc;
+      slot = htab_find_slot (b->results, &key, INSERT);
+      result = (struct batch_result *) *slot;
+      if (result == NULL)
+	{
+	  syms = b->syms;
+	  symcount = b->symcount;
+	  pc = req->pc;
+	  out_len = 0;
+	  translate_address (b->abfd, b->section);
+
+	  result = (struct batch_result *) xmalloc (sizeof (*result));
+	  result->pc = req->pc;
+	  result->text = xstrdup (out_text);
+	  *slot = result;
+	}
+      req->text = result->text;
+    }
+  collect_output = false;
+  syms = NULL;
+  symcount = 0;
+  free (sorted);
+
+  for (i = 0; i < nreq; i++)
+    {
+      const char *p, *nl;
+
+      for (p = reqs[i].text; *p != 0; p = nl + 1)
+	{
+	  nl = strchr (p, '\n');
+	  printf ("%s %.*s\n", reqs[i].id, (int) (nl - p), p);
+	}
+    }
+  printf ("\n");
+  fflush (stdout);
+}
+
+/* Read a line from stdin into *BUF, of size *SIZE, growing it as need
+   be.  Return false at end of file.  */
+
+static bool
+read_line (char **buf, size_t *size)
+{
+  size_t len = 0;
+
+  for (;;)
+    {
+      if (fgets (*buf + len, (int) (*size - len), stdin) == NULL)
+	return len != 0;
+      len += strlen (*buf + len);
+      if (len != 0 && (*buf)[len - 1] == '\n')
+	return true;
+      *size *= 2;
+      *buf = (char *) xrealloc (*buf, *size);
+    }
+}
+
+/* Read batches of requests from stdin, one request per line, each
+   batch ending with an empty line or at end of file.  A request is
+
+     ID [FILE] ADDR
+
+   where ID is any word, which is echoed back, FILE is the file name of
+   a binary, or the build-id in hex of a binary already opened, and
+   ADDR is an address as for the other forms of addr2line.  Without
+   FILE the request is for the first -e file.
+
+   Answer each batch in the order of the requests, with the location
+   printed as for --pretty-print, each line of it starting with the ID
+   of the request, and then an empty line.  */
+
+static void
+translate_batches (const char *section_name, const char *target)
+{
+  struct batch_binary *default_binary = NULL;
+  struct batch_request *reqs = NULL;
+  size_t nreq = 0, nreq_alloc = 0;
+  size_t size = 256;
+  char *buf = (char *) xmalloc (size);
+  bool more;
+  int i;
+
+  pretty_print = true;
+
+  for (i = 0; i < nexe_names; i++)
+    {
+      struct batch_binary *b;
+
+      b = batch_find_binary (exe_names[i], section_name, target);
+      if (i == 0)
+	default_binary = b;
+    }
+
+  do
+    {
+      char *words[4];
+      int nwords = 0;
+      char *p;
+
+      more = read_line (&buf, &size);
+
+      for (p = buf; more && nwords < 4; )
+	{
+	  while (ISSPACE (*p))
+	    p++;
+	  if (*p == 0)
+	    break;
+	  words[nwords++] = p;
+	  while (*p != 0 && !ISSPACE (*p))
+	    p++;
+	  if (*p != 0)
+	    *p++ = 0;
+	}
+
+      if (nwords == 0)
+	{
+	  if (nreq != 0)
+	    translate_batch (reqs, nreq);
+	  for (; nreq != 0; nreq--)
+	    free (reqs[nreq - 1].id);
+	  continue;
+	}
+
+      if (nreq == nreq_alloc)
+	{
+	  nreq_alloc = nreq_alloc * 2 + 64;
+	  reqs = (struct batch_request *)
+	    xrealloc (reqs, nreq_alloc * sizeof (*reqs));
+	}
+      reqs[nreq].id = xstrdup (words[0]);
+      reqs[nreq].pc = 0;
+      if (nwords == 2)
+	reqs[nreq].binary = default_binary;
+      else if (nwords == 3)
+	reqs[nreq].binary = batch_find_binary (words[1], section_name,
+					       target);
+      else
+	{
+	  non_fatal (_("%s: bad request"), reqs[nreq].id);
+	  reqs[nreq].binary = NULL;
+	}
+      if (reqs[nreq].binary != NULL)
+	{
+	  syms = reqs[nreq].binary->syms;
+	  symcount = reqs[nreq].binary->symcount;
+	  reqs[nreq].pc = parse_address (reqs[nreq].binary->abfd,
+					 words[nwords - 1]);
+	  syms = NULL;
+	  symcount = 0;
+	}
+      reqs[nreq].text = with_functions ? "?? ??:0\n" : "??:0\n";
+      nreq++;
+    }
+  while (more);
+
+  free (reqs);
+  free (buf);
+  free (out_text);
+
+  while (batch_names != NULL)
+    {
+      struct batch_name *n = batch_names;
+
+      batch_names = n->next;
+      free (n->name);
+      free (n);
+    }
+  while (batch_binaries != NULL)
+    {
+      struct batch_binary *b = batch_binaries;
+
+      batch_binaries = b->next;
+      htab_delete (b->results);
+      free (b->syms);
+      free (b->key);
+      bfd_close (b->abfd);
+      free (b);
+    }
+}
+
 int
 main (int argc, char **argv)
 {
@@ -513,6 +990,7 @@ main (int argc, char **argv)
   if (bfd_init () != BFD_INIT_MAGIC)
     fatal (_("fatal error: libbfd ABI mismatch"));
   set_default_bfd_target ();
+  bfd_set_compression_threads (0);
 
   file_name = NULL;
   section_name = NULL;
@@ -552,6 +1030,9 @@ main (int argc, char **argv)
 	  break;
 	case 'e':
 	  file_name = optarg;
+	  exe_names = (const char **)
+	    xrealloc (exe_names, (nexe_names + 1) * sizeof (*exe_names));
+	  exe_names[nexe_names++] = optarg;
 	  break;
 	case 's':
 	  base_names = true;
@@ -576,6 +1057,12 @@ main (int argc, char **argv)
 	case 'j':
 	  section_name = optarg;
 	  break;
+	case OPTION_BATCH:
+	  batch = true;
+	  break;
+	case OPTION_INDEX_CACHE:
+	  bfd_set_dwarf2_index_cache (optarg);
+	  break;
 	default:
 	  usage (stderr, 1);
 	  break;
@@ -583,7 +1070,19 @@ main (int argc, char **argv)
     }
 
   if (file_name == NULL)
-    file_name = "a.out";
+    {
+      file_name = "a.out";
+      exe_names = &file_name;
+      nexe_names = 1;
+    }
+
+  if (batch)
+    {
+      if (optind != argc)
+	usage (stderr, 1);
+      translate_batches (section_name, target);
+      return 0;
+    }
 
   addr = argv + optind;
   naddr = argc - optind;
@@ -137,6 +137,11 @@ static bool full_pathname = false;
 /* Whether to create a "thin" archive (symbol index only -- no files).  */
 static bool make_thin_archive = false;
 
+/* Whether to update the archive incrementally: take the symbol table
+   entries of unchanged members from the old symbol table, and add new
+   members to the end of an archive without a symbol table in place.  */
+static int incremental = 0;
+
 #define LIBDEPS	"__.LIBDEP"
 /* Text to store in the __.LIBDEP archive element for the linker to use.  */
 static char * libdeps = NULL;
@@ -172,6 +177,7 @@ static struct option long_options[] =
   {"output", required_argument, NULL, OPTION_OUTPUT},
   {"record-libdeps", required_argument, NULL, 'l'},
   {"thin", no_argument, NULL, 'T'},
+  {"incremental", no_argument, &incremental, 1},
   {NULL, no_argument, NULL, 0}
 };
 
@@ -341,6 +347,8 @@ usage (int help)
   fprintf (s, _("  --output=DIRNAME - specify the output directory for extraction operations\n"));
   fprintf (s, _("  --record-libdeps=<text> - specify the dependencies of this library\n"));
   fprintf (s, _("  --thin       - make a thin archive\n"));
+  fprintf (s, _("  --incremental - reuse the symbol table entries of unchanged members,\n\
+                  and append to an archive without one in place\n"));
 #if BFD_SUPPORTS_PLUGINS
   fprintf (s, _(" optional:\n"));
   fprintf (s, _("  --plugin <p> - load the specified plugin\n"));
@@ -1280,6 +1288,9 @@ write_archive (bfd *iarch)
   if (full_pathname)
     obfd->flags |= BFD_ARCHIVE_FULL_PATH;
 
+  if (incremental)
+    obfd->flags |= BFD_ARCHIVE_REUSE_ARMAP;
+
   if (make_thin_archive || bfd_is_thin_archive (iarch))
     bfd_set_thin_archive (obfd, true);
 
@@ -1301,6 +1312,37 @@ write_archive (bfd *iarch)
   free (new_name);
 }
 
+/* Add NEW_MEMBERS, the last of the contents of IARCH, to the end of its
+   file in place rather than writing out the whole archive.  Return
+   FALSE if that cannot be done.  */
+
+static bool
+append_archive (bfd *iarch, bfd *new_members)
+{
+  flagword flags = iarch->flags;
+
+  if (ar_truncate)
+    iarch->flags |= BFD_TRADITIONAL_FORMAT;
+
+  if (deterministic)
+    iarch->flags |= BFD_DETERMINISTIC_OUTPUT;
+
+  if (full_pathname)
+    iarch->flags |= BFD_ARCHIVE_FULL_PATH;
+
+  if (!bfd_archive_append_in_place (iarch, new_members))
+    {
+      if (bfd_get_error () != bfd_error_invalid_operation)
+	bfd_fatal (bfd_get_filename (iarch));
+      iarch->flags = flags;
+      return false;
+    }
+
+  output_filename = NULL;
+  bfd_close (iarch);
+  return true;
+}
+
 /* Return a pointer to the pointer to the entry which should be rplacd'd
    into when altering.  DEFAULT_POS should be how to interpret pos_default,
    and should be a pos value.  */
@@ -1462,6 +1504,8 @@ static void
 replace_members (bfd *arch, char **files_to_move, bool quick)
 {
   bool changed = false;
+  bool replaced_any = false;	/* Whether anything but appending was done.  */
+  bfd *appended = NULL;		/* The first member added at the end.  */
   bfd **after_bfd;		/* New entries go after this one.  */
   bfd *current;
   bfd **current_ptr;
@@ -1520,6 +1564,7 @@ replace_members (bfd *arch, char **files_to_move, bool quick)
 		      /* Snip out this entry from the chain.  */
 		      *current_ptr = (*current_ptr)->archive_next;
 		      changed = true;
+		      replaced_any = true;
 		    }
 
 		  goto next_file;
@@ -1530,6 +1575,8 @@ replace_members (bfd *arch, char **files_to_move, bool quick)
 
       /* Add to the end of the archive.  */
       after_bfd = get_pos_bfd (&arch->archive_next, pos_end, NULL);
+      if (*after_bfd != NULL)
+	replaced_any = true;
 
       if (libdeps_bfd != NULL
 	  && FILENAME_CMP (normalize (*files_to_move, arch), LIBDEPS) == 0)
@@ -1542,6 +1589,8 @@ replace_members (bfd *arch, char **files_to_move, bool quick)
 	  changed |= ar_emul_append (after_bfd, *files_to_move, target,
 				     verbose, make_thin_archive);
 	}
+      if (appended == NULL)
+	appended = *after_bfd;
 
     next_file:;
 
@@ -1549,7 +1598,17 @@ replace_members (bfd *arch, char **files_to_move, bool quick)
     }
 
   if (changed)
-    write_archive (arch);
+    {
+      /* Without a symbol table to update, new members at the end can
+	 simply be added to the end of the file.  */
+      if (incremental
+	  && !replaced_any
+	  && appended != NULL
+	  && write_armap < 0
+	  && append_archive (arch, appended))
+	return;
+      write_archive (arch);
+    }
   else
     output_filename = NULL;
 }
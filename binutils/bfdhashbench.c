@@ -0,0 +1,237 @@
+/* A program to compare the speed of BFD's hash table variants.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+
+   This file is part of the GNU Binutils.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+   MA 02110-1301, USA.  */
+
+/* Usage: bfdhashbench [-r ROUNDS] [FILE]...
+
+   Enter the names of the symbols of each FILE, which may be an object
+   file, a shared library or an archive, into a hash table made by
+   bfd_hash_table_init and into one made by bfd_hash_table_init_open,
+   and time adding the names, looking each of them up ROUNDS times,
+   and looking up as many names which are not in the table.  Without
+   any FILE, use a made up set of names shaped like mangled C++
+   symbols.  Exit with status 1 if the two tables disagree.  */
+
+#include "sysdep.h"
+#include "bfd.h"
+#include "libiberty.h"
+
+static void
+die (const char *s)
+{
+  printf ("oops: %s\n", s);
+  exit (1);
+}
+
+static char **names;
+static size_t nnames, anames;
+
+static void
+add_name (const char *name)
+{
+  if (nnames == anames)
+    {
+      anames = anames * 2 + 1024;
+      names = (char **) xrealloc (names, anames * sizeof (*names));
+    }
+  names[nnames++] = xstrdup (name);
+}
+
+/* Add the names of the symbols of ABFD, including its dynamic
+   symbols, or of the members of ABFD if it is an archive.  */
+
+static void
+add_bfd_names (bfd *abfd)
+{
+  if (bfd_check_format (abfd, bfd_archive))
+    {
+      bfd *elt, *next;
+
+      for (elt = bfd_openr_next_archived_file (abfd, NULL);
+	   elt != NULL;
+	   elt = next)
+	{
+	  add_bfd_names (elt);
+	  next = bfd_openr_next_archived_file (abfd, elt);
+	}
+      return;
+    }
+
+  if (!bfd_check_format (abfd, bfd_object))
+    return;
+
+  if ((bfd_get_file_flags (abfd) & HAS_SYMS) != 0)
+    {
+      long size = bfd_get_symtab_upper_bound (abfd);
+
+      if (size > 0)
+	{
+	  asymbol **syms = (asymbol **) xmalloc (size);
+	  long i, count = bfd_canonicalize_symtab (abfd, syms);
+
+	  for (i = 0; i < count; i++)
+	    if (syms[i]->name[0] != '\0')
+	      add_name (syms[i]->name);
+	  free (syms);
+	}
+    }
+
+  if ((bfd_get_file_flags (abfd) & DYNAMIC) != 0)
+    {
+      long size = bfd_get_dynamic_symtab_upper_bound (abfd);
+
+      if (size > 0)
+	{
+	  asymbol **syms = (asymbol **) xmalloc (size);
+	  long i, count = bfd_canonicalize_dynamic_symtab (abfd, syms);
+
+	  for (i = 0; i < count; i++)
+	    if (syms[i]->name[0] != '\0')
+	      add_name (syms[i]->name);
+	  free (syms);
+	}
+    }
+}
+
+/* Add a made up set of names shaped like mangled C++ symbols, with
+   long shared prefixes.  */
+
+static void
+add_made_up_names (void)
+{
+  static const char *const spaces[] =
+    { "4llvm", "3std", "5clang", "4absl", "5boost", "6google" };
+  static const char *const classes[] =
+    { "12SmallVectorIiLj8EE", "6vectorIcSaIcEE", "9StringRef",
+      "13unordered_mapIiiE", "8DenseMapIPvjE", "5RegexE" };
+  static const char *const methods[] =
+    { "9push_backEi", "6insertEPKc", "4findERKi", "5clearEv",
+      "7reserveEm", "C2Ev", "D2Ev", "6resizeEmRKc" };
+  char buf[256];
+  unsigned int i;
+
+  for (i = 0; i < 300000; i++)
+    {
+      sprintf (buf, "_ZN%s%s%u%s%sE",
+	       spaces[i % 6], classes[(i / 6) % 6], i % 97,
+	       i % 2 ? "L" : "", methods[(i / 36) % 8]);
+      sprintf (buf + strlen (buf) - 1, "_%u", i);
+      add_name (buf);
+    }
+}
+
+/* Time adding all the names to TABLE, and ROUNDS lookups of each
+   name, and ROUNDS lookups of each name with a suffix that isn't in
+   the table.  Record in FOUND the entry for each name.  */
+
+static void
+bench (const char *kind, struct bfd_hash_table *table, unsigned int rounds,
+       struct bfd_hash_entry **found)
+{
+  char miss[300];
+  long start, add, hit, nohit;
+  size_t i;
+  unsigned int r;
+
+  start = get_run_time ();
+  for (i = 0; i < nnames; i++)
+    if (bfd_hash_lookup (table, names[i], true, false) == NULL)
+      die ("bfd_hash_lookup");
+  add = get_run_time () - start;
+
+  start = get_run_time ();
+  for (r = 0; r < rounds; r++)
+    for (i = 0; i < nnames; i++)
+      found[i] = bfd_hash_lookup (table, names[i], false, false);
+  hit = get_run_time () - start;
+
+  start = get_run_time ();
+  for (r = 0; r < rounds; r++)
+    for (i = 0; i < nnames; i++)
+      {
+	snprintf (miss, sizeof (miss), "%.280s@@X", names[i]);
+	if (bfd_hash_lookup (table, miss, false, false) != NULL)
+	  die ("found a name not added");
+      }
+  nohit = get_run_time () - start;
+
+  printf ("%-8s %8u entries %7.1f ns/add %7.1f ns/hit %7.1f ns/miss\n",
+	  kind, table->count,
+	  add * 1000.0 / nnames,
+	  hit * 1000.0 / ((double) nnames * rounds),
+	  nohit * 1000.0 / ((double) nnames * rounds));
+}
+
+int
+main (int argc, char **argv)
+{
+  struct bfd_hash_table chained, open;
+  struct bfd_hash_entry **found_chained, **found_open;
+  unsigned int rounds = 5;
+  size_t i;
+  int arg = 1;
+
+  if (arg + 1 < argc && strcmp (argv[arg], "-r") == 0)
+    {
+      rounds = atoi (argv[arg + 1]);
+      arg += 2;
+    }
+
+  if (bfd_init () != BFD_INIT_MAGIC)
+    die ("bfd_init");
+
+  for (; arg < argc; arg++)
+    {
+      bfd *abfd = bfd_openr (argv[arg], NULL);
+
+      if (abfd == NULL)
+	die (argv[arg]);
+      add_bfd_names (abfd);
+    }
+  if (nnames == 0)
+    add_made_up_names ();
+
+  found_chained = (struct bfd_hash_entry **)
+    xmalloc (nnames * sizeof (*found_chained));
+  found_open = (struct bfd_hash_entry **)
+    xmalloc (nnames * sizeof (*found_open));
+
+  if (!bfd_hash_table_init (&chained, bfd_hash_newfunc,
+			    sizeof (struct bfd_hash_entry))
+      || !bfd_hash_table_init_open (&open, bfd_hash_newfunc,
+				    sizeof (struct bfd_hash_entry)))
+    die ("bfd_hash_table_init");
+
+  printf ("%lu names\n", (unsigned long) nnames);
+  bench ("chained", &chained, rounds, found_chained);
+  bench ("open", &open, rounds, found_open);
+
+  if (chained.count != open.count)
+    die ("the tables have different numbers of entries");
+  for (i = 0; i < nnames; i++)
+    if (found_chained[i] == NULL
+	|| found_open[i] == NULL
+	|| strcmp (found_chained[i]->string, names[i]) != 0
+	|| strcmp (found_open[i]->string, names[i]) != 0)
+      die ("the tables disagree");
+
+  bfd_hash_table_free (&chained);
+  bfd_hash_table_free (&open);
+  return 0;
+}
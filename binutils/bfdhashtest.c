@@ -0,0 +1,233 @@
+/* A program to check BFD's open addressing hash tables.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+
+   This file is part of the GNU Binutils.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+   MA 02110-1301, USA.  */
+
+/* Usage: bfdhashtest
+
+   Make the same series of lookups that add entries, renames and
+   replaces on a table made by bfd_hash_table_init_open and on one made
+   by bfd_hash_table_init, and check that looking up each name gives
+   the same entry in both.  A rename removes the entry from its probe
+   chain and places it again, so the first series keeps the open table
+   at its smallest size and three quarters full, where many chains wrap
+   around its end.  The second lets the table grow.  Print nothing and
+   exit with status 0 if the tables always agree.  */
+
+#include "sysdep.h"
+#include "bfd.h"
+#include "libiberty.h"
+
+static void
+die (const char *s)
+{
+  printf ("oops: %s\n", s);
+  exit (1);
+}
+
+struct test_entry
+{
+  struct bfd_hash_entry root;
+  unsigned int id;
+};
+
+static struct bfd_hash_entry *
+test_newfunc (struct bfd_hash_entry *entry,
+	      struct bfd_hash_table *table,
+	      const char *string)
+{
+  if (entry == NULL)
+    {
+      entry = (struct bfd_hash_entry *)
+	bfd_hash_allocate (table, sizeof (struct test_entry));
+      if (entry == NULL)
+	return NULL;
+    }
+  entry = bfd_hash_newfunc (entry, table, string);
+  if (entry != NULL)
+    ((struct test_entry *) entry)->id = 0;
+  return entry;
+}
+
+static struct test_entry *
+find (struct bfd_hash_table *table, const char *name)
+{
+  return (struct test_entry *) bfd_hash_lookup (table, name, false, false);
+}
+
+static char **names;
+static unsigned int next_id;
+static unsigned int seed = 1;
+
+static unsigned int
+next_random (unsigned int n)
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) % n;
+}
+
+/* Check that each of the first NNAMES names is either in neither of
+   CHAINED and OPEN or in both with the same id.  */
+
+static void
+check (struct bfd_hash_table *chained, struct bfd_hash_table *open,
+       unsigned int nnames)
+{
+  unsigned int i;
+
+  if (chained->count != open->count)
+    die ("the tables have different numbers of entries");
+  for (i = 0; i < nnames; i++)
+    {
+      struct test_entry *c = find (chained, names[i]);
+      struct test_entry *o = find (open, names[i]);
+
+      if (c == NULL && o == NULL)
+	continue;
+      if (c == NULL || o == NULL)
+	die ("a name is in only one table");
+      if (c->id != o->id || strcmp (o->root.string, names[i]) != 0)
+	die ("the tables disagree");
+    }
+}
+
+/* Add a new entry for NAME to TABLE, with id ID.  */
+
+static void
+add (struct bfd_hash_table *table, const char *name, unsigned int id)
+{
+  struct test_entry *ent
+    = (struct test_entry *) bfd_hash_lookup (table, name, true, false);
+
+  if (ent == NULL || ent->id != 0)
+    die ("bfd_hash_lookup");
+  ent->id = id;
+}
+
+/* Replace the entry for NAME in TABLE with a copy with id ID.  */
+
+static void
+replace (struct bfd_hash_table *table, const char *name, unsigned int id)
+{
+  struct test_entry *old = find (table, name);
+  struct test_entry *nw;
+
+  nw = (struct test_entry *) test_newfunc (NULL, table, name);
+  if (old == NULL || nw == NULL)
+    die ("bfd_hash_replace");
+  nw->root = old->root;
+  nw->id = id;
+  bfd_hash_replace (table, &old->root, &nw->root);
+}
+
+static bool
+count_entry (struct bfd_hash_entry *ent ATTRIBUTE_UNUSED, void *info)
+{
+  ++*(unsigned int *) info;
+  return true;
+}
+
+/* Make STEPS random changes to two new tables, using the first NNAMES
+   names and keeping no more than LIMIT entries, and check the tables
+   every CHECK_EVERY steps.  */
+
+static void
+run (unsigned int nnames, unsigned int limit, unsigned int steps,
+     unsigned int check_every)
+{
+  struct bfd_hash_table chained, open;
+  unsigned int step, visited;
+
+  if (!bfd_hash_table_init (&chained, test_newfunc,
+			    sizeof (struct test_entry))
+      || !bfd_hash_table_init_open (&open, test_newfunc,
+				    sizeof (struct test_entry)))
+    die ("bfd_hash_table_init");
+
+  for (step = 0; step < steps; step++)
+    {
+      const char *name = names[next_random (nnames)];
+      struct test_entry *ent = find (&chained, name);
+
+      if (ent == NULL)
+	{
+	  if (chained.count < limit)
+	    {
+	      ++next_id;
+	      add (&chained, name, next_id);
+	      add (&open, name, next_id);
+	    }
+	}
+      else if (next_random (2) == 0)
+	{
+	  const char *newname = names[next_random (nnames)];
+
+	  if (find (&chained, newname) == NULL)
+	    {
+	      bfd_hash_rename (&chained, newname, &ent->root);
+	      ent = find (&open, name);
+	      if (ent == NULL)
+		die ("bfd_hash_rename");
+	      bfd_hash_rename (&open, newname, &ent->root);
+	    }
+	}
+      else
+	{
+	  ++next_id;
+	  replace (&chained, name, next_id);
+	  replace (&open, name, next_id);
+	}
+
+      if ((step + 1) % check_every == 0)
+	check (&chained, &open, nnames);
+    }
+  check (&chained, &open, nnames);
+
+  visited = 0;
+  bfd_hash_traverse (&open, count_entry, &visited);
+  if (visited != open.count)
+    die ("bfd_hash_traverse");
+
+  bfd_hash_table_free (&chained);
+  bfd_hash_table_free (&open);
+}
+
+int
+main (void)
+{
+  char buf[32];
+  unsigned int i;
+
+  if (bfd_init () != BFD_INIT_MAGIC)
+    die ("bfd_init");
+
+  names = (char **) xmalloc (4096 * sizeof (*names));
+  for (i = 0; i < 4096; i++)
+    {
+      sprintf (buf, "name%u", i);
+      names[i] = xstrdup (buf);
+    }
+
+  /* The smallest open table has 64 slots and grows when adding an
+     entry would fill more than 48 of them.  */
+  bfd_hash_set_default_size (1);
+  run (96, 48, 20000, 1);
+  run (4096, 4096, 40000, 256);
+
+  return 0;
+}
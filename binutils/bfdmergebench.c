@@ -0,0 +1,204 @@
+/* A program to make input for timing the merging of SHF_MERGE sections.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+
+   This file is part of the GNU Binutils.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+   MA 02110-1301, USA.  */
+
+/* Usage: bfdmergebench [-n OBJECTS] [-d STRINGS] [-r STRINGS]
+			[-p POOL] DIR
+
+   Write OBJECTS relocatable ELF objects for the default target to
+   DIR/merge0.o, DIR/merge1.o and so on.  Each has a .debug_str
+   section of STRINGS strings and a .rodata.str1.1 section of STRINGS
+   strings, all drawn from one pool of POOL made up strings, so that
+   most strings appear in many objects and some are tails of others.
+   The defaults are 60 objects, 40000 .debug_str strings, 5000
+   .rodata.str1.1 strings and a pool of 400000 strings.  The output
+   depends only on the arguments.
+
+   The time ld spends merging these sections can then be measured
+   with, for example,
+     time ld -e 0 --no-threads -o merged DIR/merge*.o
+     time ld -e 0 --threads -o merged DIR/merge*.o
+   and the two outputs compared with cmp.  */
+
+#include "sysdep.h"
+#include "bfd.h"
+#include "libiberty.h"
+#include "elf-bfd.h"
+
+static void
+die (const char *s)
+{
+  printf ("oops: %s\n", s);
+  exit (1);
+}
+
+/* A small linear congruential generator, so that the output is the
+   same on every host.  */
+
+static unsigned long seed = 1;
+
+static unsigned int
+next_random (void)
+{
+  seed = (seed * 1103515245 + 12345) & 0xffffffff;
+  return (seed >> 16) & 0x7fff;
+}
+
+static char **pool;
+
+/* Fill POOL with COUNT strings of 5 to 44 letters and underscores.
+   Every eighth string is the tail of the string before it.  */
+
+static void
+make_pool (unsigned int count)
+{
+  static const char letters[] = "abcdefghijklmnopqrstuvwxyz_";
+  unsigned int i;
+
+  pool = (char **) xmalloc (count * sizeof (*pool));
+  for (i = 0; i < count; i++)
+    {
+      if (i % 8 == 7 && strlen (pool[i - 1]) > 6)
+	pool[i] = xstrdup (pool[i - 1] + 1 + next_random () % 5);
+      else
+	{
+	  unsigned int len = 5 + next_random () % 40;
+	  unsigned int j;
+
+	  pool[i] = (char *) xmalloc (len + 1);
+	  for (j = 0; j < len; j++)
+	    pool[i][j] = letters[next_random () % (sizeof (letters) - 1)];
+	  pool[i][len] = '\0';
+	}
+    }
+}
+
+/* Add a section called NAME with FLAGS to ABFD, to hold COUNT strings
+   picked from the POOLSIZE strings in the pool.  Return the contents,
+   which are written once all the sections exist.  */
+
+static char *
+add_strings (bfd *abfd, const char *name, flagword flags,
+	     unsigned int count, unsigned int poolsize, asection **psec)
+{
+  asection *sec;
+  char *contents, *p;
+  bfd_size_type size = 0;
+  unsigned int *picks;
+  unsigned int i;
+
+  sec = bfd_make_section_with_flags (abfd, name,
+				     flags | SEC_HAS_CONTENTS | SEC_MERGE
+				     | SEC_STRINGS | SEC_READONLY);
+  if (sec == NULL)
+    die (name);
+  sec->entsize = 1;
+
+  picks = (unsigned int *) xmalloc (count * sizeof (*picks));
+  for (i = 0; i < count; i++)
+    {
+      picks[i] = ((next_random () << 15) | next_random ()) % poolsize;
+      size += strlen (pool[picks[i]]) + 1;
+    }
+
+  contents = p = (char *) xmalloc (size);
+  for (i = 0; i < count; i++)
+    {
+      strcpy (p, pool[picks[i]]);
+      p += strlen (p) + 1;
+    }
+
+  if (!bfd_set_section_size (sec, size))
+    die ("bfd_set_section_size");
+  free (picks);
+  *psec = sec;
+  return contents;
+}
+
+int
+main (int argc, char **argv)
+{
+  unsigned int objects = 60, debug_strings = 40000, rodata_strings = 5000;
+  unsigned int poolsize = 400000;
+  unsigned int i;
+  int arg = 1;
+
+  for (; arg + 1 < argc && argv[arg][0] == '-'; arg += 2)
+    {
+      unsigned int value = atoi (argv[arg + 1]);
+
+      if (strcmp (argv[arg], "-n") == 0)
+	objects = value;
+      else if (strcmp (argv[arg], "-d") == 0)
+	debug_strings = value;
+      else if (strcmp (argv[arg], "-r") == 0)
+	rodata_strings = value;
+      else if (strcmp (argv[arg], "-p") == 0)
+	poolsize = value;
+      else
+	die (argv[arg]);
+    }
+  if (arg + 1 != argc || poolsize < 8)
+    die ("usage: bfdmergebench [-n OBJECTS] [-d STRINGS] [-r STRINGS]"
+	 " [-p POOL] DIR");
+
+  if (bfd_init () != BFD_INIT_MAGIC)
+    die ("bfd_init");
+
+  make_pool (poolsize);
+
+  for (i = 0; i < objects; i++)
+    {
+      char *name = concat (argv[arg], "/merge", NULL);
+      char num[16];
+      asection *debug_sec, *rodata_sec;
+      char *debug, *rodata;
+      bfd *abfd;
+
+      sprintf (num, "%u.o", i);
+      name = reconcat (name, name, num, NULL);
+      abfd = bfd_openw (name, NULL);
+      if (abfd == NULL)
+	die (name);
+      if (!bfd_set_format (abfd, bfd_object)
+	  || bfd_get_flavour (abfd) != bfd_target_elf_flavour)
+	die ("the default target is not ELF");
+      if (!bfd_set_arch_mach (abfd, get_elf_backend_data (abfd)->arch, 0))
+	die ("bfd_set_arch_mach");
+
+      debug = add_strings (abfd, ".debug_str", SEC_DEBUGGING,
+			   debug_strings, poolsize, &debug_sec);
+      rodata = add_strings (abfd, ".rodata.str1.1",
+			    SEC_ALLOC | SEC_LOAD | SEC_DATA,
+			    rodata_strings, poolsize, &rodata_sec);
+
+      if (!bfd_set_symtab (abfd, NULL, 0)
+	  || !bfd_set_section_contents (abfd, debug_sec, debug, 0,
+					bfd_section_size (debug_sec))
+	  || !bfd_set_section_contents (abfd, rodata_sec, rodata, 0,
+					bfd_section_size (rodata_sec))
+	  || !bfd_close (abfd))
+	die (name);
+      free (debug);
+      free (rodata);
+      free (name);
+    }
+
+  return 0;
+}
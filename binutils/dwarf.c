@@ -3568,206 +3568,25 @@ free_debug_information (debug_info *ent)
     }
 }
 
-/* Process the contents of a .debug_info section.
-   If do_loc is TRUE then we are scanning for location lists and dwo tags
-   and we do not want to display anything to the user.
-   If do_types is TRUE, we are processing a .debug_types section instead of
-   a .debug_info section.
-   The information displayed is restricted by the values in DWARF_START_DIE
-   and DWARF_CUTOFF_LEVEL.
-   Returns TRUE upon success.  Otherwise an error or warning message is
-   printed and FALSE is returned.  */
+/* Display the units of SECTION from START up to LIMIT, the first of
+   which is number UNIT, for process_debug_info.  *DO_TYPES is updated
+   from the header of each unit.  Returns zero once all of them have
+   been shown, one if an error stopped the display, and two if the DIE
+   selected by DWARF_START_DIE and its children have been shown.  */
 
-static bool
-process_debug_info (struct dwarf_section * section,
-		    void *file,
-		    enum dwarf_section_display_enum abbrev_sec,
-		    bool do_loc,
-		    bool do_types)
+static int
+process_debug_info_units (struct dwarf_section *section,
+			  enum dwarf_section_display_enum abbrev_sec,
+			  bool do_loc,
+			  bool *do_types,
+			  unsigned char *start,
+			  unsigned char *limit,
+			  unsigned int unit)
 {
-  unsigned char *start = section->start;
-  unsigned char *end = start + section->size;
-  unsigned char *section_begin;
-  unsigned int unit;
-  unsigned int num_units = 0;
-
-  /* First scan the section to get the number of comp units.
-     Length sanity checks are done here.  */
-  for (section_begin = start, num_units = 0; section_begin < end;
-       num_units ++)
-    {
-      uint64_t length;
-
-      /* Read the first 4 bytes.  For a 32-bit DWARF section, this
-	 will be the length.  For a 64-bit DWARF section, it'll be
-	 the escape code 0xffffffff followed by an 8 byte length.  */
-      SAFE_BYTE_GET_AND_INC (length, section_begin, 4, end);
-
-      if (length == 0xffffffff)
-	SAFE_BYTE_GET_AND_INC (length, section_begin, 8, end);
-      else if (length >= 0xfffffff0 && length < 0xffffffff)
-	{
-	  warn (_("Reserved length value (%#" PRIx64 ") found in section %s\n"),
-		length, section->name);
-	  return false;
-	}
-
-      /* Negative values are illegal, they may even cause infinite
-	 looping.  This can happen if we can't accurately apply
-	 relocations to an object file, or if the file is corrupt.  */
-      if (length > (size_t) (end - section_begin))
-	{
-	  warn (_("Corrupt unit length (got %#" PRIx64
-		  " expected at most %#tx) in section %s\n"),
-		length, end - section_begin, section->name);
-	  return false;
-	}
-      section_begin += length;
-    }
-
-  if (num_units == 0)
-    {
-      error (_("No comp units in %s section ?\n"), section->name);
-      return false;
-    }
-
-  if ((do_loc || do_debug_loc || do_debug_ranges || do_debug_info)
-      && num_debug_info_entries == 0
-      && ! do_types)
-    {
-
-      /* Then allocate an array to hold the information.  */
-      debug_information = (debug_info *) cmalloc (num_units,
-						  sizeof (* debug_information));
-      if (debug_information == NULL)
-	{
-	  error (_("Not enough memory for a debug info array of %u entries\n"),
-		 num_units);
-	  alloc_num_debug_info_entries = num_debug_info_entries = 0;
-	  return false;
-	}
-
-      /* PR 17531: file: 92ca3797.
-	 We cannot rely upon the debug_information array being initialised
-	 before it is used.  A corrupt file could easily contain references
-	 to a unit for which information has not been made available.  So
-	 we ensure that the array is zeroed here.  */
-      memset (debug_information, 0, num_units * sizeof (*debug_information));
-
-      alloc_num_debug_info_entries = num_units;
-    }
-
-  if (!do_loc)
-    {
-      load_debug_section_with_follow (str, file);
-      load_debug_section_with_follow (line_str, file);
-      load_debug_section_with_follow (str_dwo, file);
-      load_debug_section_with_follow (str_index, file);
-      load_debug_section_with_follow (str_index_dwo, file);
-      load_debug_section_with_follow (debug_addr, file);
-    }
-
-  load_debug_section_with_follow (abbrev_sec, file);
-  load_debug_section_with_follow (loclists, file);
-  load_debug_section_with_follow (rnglists, file);
-  load_debug_section_with_follow (loclists_dwo, file);
-  load_debug_section_with_follow (rnglists_dwo, file);
-
-  if (debug_displays [abbrev_sec].section.start == NULL)
-    {
-      warn (_("Unable to locate %s section!\n"),
-	    debug_displays [abbrev_sec].section.uncompressed_name);
-      return false;
-    }
-
-  if (!do_loc && dwarf_start_die == 0)
-    introduce (section, false);
-
-  free_all_abbrevs ();
-
-  /* In order to be able to resolve DW_FORM_ref_addr forms we need
-     to load *all* of the abbrevs for all CUs in this .debug_info
-     section.  This does effectively mean that we (partially) read
-     every CU header twice.  */
-  for (section_begin = start; start < end;)
-    {
-      DWARF2_Internal_CompUnit compunit;
-      unsigned char *hdrptr;
-      uint64_t abbrev_base;
-      size_t abbrev_size;
-      uint64_t cu_offset;
-      unsigned int offset_size;
-      struct cu_tu_set *this_set;
-      unsigned char *end_cu;
-
-      hdrptr = start;
-      cu_offset = start - section_begin;
-
-      SAFE_BYTE_GET_AND_INC (compunit.cu_length, hdrptr, 4, end);
-
-      if (compunit.cu_length == 0xffffffff)
-	{
-	  SAFE_BYTE_GET_AND_INC (compunit.cu_length, hdrptr, 8, end);
-	  offset_size = 8;
-	}
-      else
-	offset_size = 4;
-      end_cu = hdrptr + compunit.cu_length;
-
-      SAFE_BYTE_GET_AND_INC (compunit.cu_version, hdrptr, 2, end_cu);
-
-      this_set = find_cu_tu_set_v2 (cu_offset, do_types);
-
-      if (compunit.cu_version < 5)
-	{
-	  compunit.cu_unit_type = DW_UT_compile;
-	  /* Initialize it due to a false compiler warning.  */
-	  compunit.cu_pointer_size = -1;
-	}
-      else
-	{
-	  SAFE_BYTE_GET_AND_INC (compunit.cu_unit_type, hdrptr, 1, end_cu);
-	  do_types = (compunit.cu_unit_type == DW_UT_type);
-
-	  SAFE_BYTE_GET_AND_INC (compunit.cu_pointer_size, hdrptr, 1, end_cu);
-	}
-
-      SAFE_BYTE_GET_AND_INC (compunit.cu_abbrev_offset, hdrptr, offset_size,
-			     end_cu);
-
-      if (compunit.cu_unit_type == DW_UT_split_compile
-	  || compunit.cu_unit_type == DW_UT_skeleton)
-	{
-	  uint64_t dwo_id;
-	  SAFE_BYTE_GET_AND_INC (dwo_id, hdrptr, 8, end_cu);
-	}
-
-      if (this_set == NULL)
-	{
-	  abbrev_base = 0;
-	  abbrev_size = debug_displays [abbrev_sec].section.size;
-	}
-      else
-	{
-	  abbrev_base = this_set->section_offsets [DW_SECT_ABBREV];
-	  abbrev_size = this_set->section_sizes [DW_SECT_ABBREV];
-	}
+  unsigned char *section_begin = section->start;
+  unsigned char *end = section_begin + section->size;
 
-      abbrev_list *list;
-      abbrev_list *free_list;
-      list = find_and_process_abbrev_set (&debug_displays[abbrev_sec].section,
-					  abbrev_base, abbrev_size,
-					  compunit.cu_abbrev_offset,
-					  &free_list);
-      start = end_cu;
-      if (list != NULL && list->first_abbrev != NULL)
-	record_abbrev_list_for_cu (cu_offset, start - section_begin,
-				   list, free_list);
-      else if (free_list != NULL)
-	free_abbrev_list (free_list);
-    }
-
-  for (start = section_begin, unit = 0; start < end; unit++)
+  for (; start < limit; unit++)
     {
       DWARF2_Internal_CompUnit compunit;
       unsigned char *hdrptr;
@@ -3798,7 +3617,7 @@ process_debug_info (struct dwarf_section * section,
 
       SAFE_BYTE_GET_AND_INC (compunit.cu_version, hdrptr, 2, end_cu);
 
-      this_set = find_cu_tu_set_v2 (cu_offset, do_types);
+      this_set = find_cu_tu_set_v2 (cu_offset, *do_types);
 
       if (compunit.cu_version < 5)
 	{
@@ -3809,7 +3628,7 @@ process_debug_info (struct dwarf_section * section,
       else
 	{
 	  SAFE_BYTE_GET_AND_INC (compunit.cu_unit_type, hdrptr, 1, end_cu);
-	  do_types = (compunit.cu_unit_type == DW_UT_type);
+	  *do_types = (compunit.cu_unit_type == DW_UT_type);
 
 	  SAFE_BYTE_GET_AND_INC (compunit.cu_pointer_size, hdrptr, 1, end_cu);
 	}
@@ -3847,7 +3666,7 @@ process_debug_info (struct dwarf_section * section,
 	  compunit.cu_pointer_size = offset_size;
 	}
 
-      if (do_types)
+      if (*do_types)
 	{
 	  SAFE_BYTE_GET_AND_INC (signature, hdrptr, 8, end_cu);
 	  SAFE_BYTE_GET_AND_INC (type_offset, hdrptr, offset_size, end_cu);
@@ -3862,7 +3681,7 @@ process_debug_info (struct dwarf_section * section,
       if ((do_loc || do_debug_loc || do_debug_ranges || do_debug_info)
 	  && num_debug_info_entries == 0
 	  && alloc_num_debug_info_entries > unit
-	  && ! do_types)
+	  && ! *do_types)
 	{
 	  free_debug_information (&debug_information[unit]);
 	  memset (&debug_information[unit], 0, sizeof (*debug_information));
@@ -3893,7 +3712,7 @@ process_debug_info (struct dwarf_section * section,
 	  printf (_("   Abbrev Offset: %#" PRIx64 "\n"),
 		  compunit.cu_abbrev_offset);
 	  printf (_("   Pointer Size:  %d\n"), compunit.cu_pointer_size);
-	  if (do_types)
+	  if (*do_types)
 	    {
 	      printf (_("   Signature:     %#" PRIx64 "\n"), signature);
 	      printf (_("   Type Offset:   %#" PRIx64 "\n"), type_offset);
@@ -4000,7 +3819,7 @@ process_debug_info (struct dwarf_section * section,
 		{
 		  if (list != NULL)
 		    free_abbrev_list (list);
-		  return true;
+		  return 2;
 		}
 	      continue;
 	    }
@@ -4044,7 +3863,7 @@ process_debug_info (struct dwarf_section * section,
 		    die_offset, abbrev_number);
 	      if (list != NULL)
 		free_abbrev_list (list);
-	      return false;
+	      return 1;
 	    }
 
 	  if (!do_loc && do_printing)
@@ -4131,6 +3950,329 @@ process_debug_info (struct dwarf_section * section,
       if (list != NULL)
 	free_abbrev_list (list);
     }
+  return 0;
+}
+
+/* The units of a .debug_info section shared out among worker processes
+   by process_debug_info_in_workers.  */
+
+struct info_units_work
+{
+  struct dwarf_section *section;
+  enum dwarf_section_display_enum abbrev_sec;
+  /* The start of each unit, and the end of the section.  */
+  unsigned char **starts;
+  /* The value of do_types when each unit is reached.  */
+  bool *do_types;
+};
+
+static uint64_t
+info_unit_weight (size_t unit, void *data)
+{
+  struct info_units_work *work = (struct info_units_work *) data;
+
+  return work->starts[unit + 1] - work->starts[unit];
+}
+
+static int
+display_info_units (size_t first, size_t end, void *data)
+{
+  struct info_units_work *work = (struct info_units_work *) data;
+  bool do_types = work->do_types[first];
+
+  return process_debug_info_units (work->section, work->abbrev_sec, false,
+				   &do_types, work->starts[first],
+				   work->starts[end], first);
+}
+
+/* Display the NUM_UNITS units of SECTION with worker processes, each
+   formatting a run of units, for process_debug_info.  Returns as
+   process_debug_info_units does, or -1 if no workers could be used.  */
+
+static int
+process_debug_info_in_workers (struct dwarf_section *section,
+			       enum dwarf_section_display_enum abbrev_sec,
+			       bool *do_types,
+			       unsigned int num_units)
+{
+  struct info_units_work work;
+  unsigned char *start = section->start;
+  unsigned char *end = start + section->size;
+  unsigned int unit;
+  int res;
+
+  /* Find where each unit starts, and replay the changes that reading
+     its header makes to do_types.  */
+  work.section = section;
+  work.abbrev_sec = abbrev_sec;
+  work.starts = (unsigned char **) xmalloc ((num_units + 1)
+					    * sizeof (*work.starts));
+  work.do_types = (bool *) xmalloc (num_units * sizeof (*work.do_types));
+  for (unit = 0; unit < num_units; unit++)
+    {
+      unsigned char *hdrptr = start;
+      uint64_t length;
+      unsigned int version;
+
+      work.starts[unit] = start;
+      work.do_types[unit] = *do_types;
+
+      SAFE_BYTE_GET_AND_INC (length, hdrptr, 4, end);
+      if (length == 0xffffffff)
+	SAFE_BYTE_GET_AND_INC (length, hdrptr, 8, end);
+      start = hdrptr + length;
+
+      SAFE_BYTE_GET_AND_INC (version, hdrptr, 2, start);
+      if (version >= 5)
+	{
+	  unsigned int unit_type;
+
+	  SAFE_BYTE_GET (unit_type, hdrptr, 1, start);
+	  *do_types = unit_type == DW_UT_type;
+	}
+    }
+  work.starts[num_units] = end;
+
+  res = run_in_workers (num_units, info_unit_weight, display_info_units,
+			&work);
+
+  free (work.starts);
+  free (work.do_types);
+  return res;
+}
+
+/* Process the contents of a .debug_info section.
+   If do_loc is TRUE then we are scanning for location lists and dwo tags
+   and we do not want to display anything to the user.
+   If do_types is TRUE, we are processing a .debug_types section instead of
+   a .debug_info section.
+   The information displayed is restricted by the values in DWARF_START_DIE
+   and DWARF_CUTOFF_LEVEL.
+   Returns TRUE upon success.  Otherwise an error or warning message is
+   printed and FALSE is returned.  */
+
+static bool
+process_debug_info (struct dwarf_section * section,
+		    void *file,
+		    enum dwarf_section_display_enum abbrev_sec,
+		    bool do_loc,
+		    bool do_types)
+{
+  unsigned char *start = section->start;
+  unsigned char *end = start + section->size;
+  unsigned char *section_begin;
+  unsigned int num_units = 0;
+  int res;
+
+  /* First scan the section to get the number of comp units.
+     Length sanity checks are done here.  */
+  for (section_begin = start, num_units = 0; section_begin < end;
+       num_units ++)
+    {
+      uint64_t length;
+
+      /* Read the first 4 bytes.  For a 32-bit DWARF section, this
+	 will be the length.  For a 64-bit DWARF section, it'll be
+	 the escape code 0xffffffff followed by an 8 byte length.  */
+      SAFE_BYTE_GET_AND_INC (length, section_begin, 4, end);
+
+      if (length == 0xffffffff)
+	SAFE_BYTE_GET_AND_INC (length, section_begin, 8, end);
+      else if (length >= 0xfffffff0 && length < 0xffffffff)
+	{
+	  warn (_("Reserved length value (%#" PRIx64 ") found in section %s\n"),
+		length, section->name);
+	  return false;
+	}
+
+      /* Negative values are illegal, they may even cause infinite
+	 looping.  This can happen if we can't accurately apply
+	 relocations to an object file, or if the file is corrupt.  */
+      if (length > (size_t) (end - section_begin))
+	{
+	  warn (_("Corrupt unit length (got %#" PRIx64
+		  " expected at most %#tx) in section %s\n"),
+		length, end - section_begin, section->name);
+	  return false;
+	}
+      section_begin += length;
+    }
+
+  if (num_units == 0)
+    {
+      error (_("No comp units in %s section ?\n"), section->name);
+      return false;
+    }
+
+  /* Displaying the units can be shared out among worker processes, as
+     long as they need not fill in debug_information for the sections
+     displayed after this one.  It usually has been already, when
+     looking for links to separate debug info files.  */
+  bool parallel = (!do_loc
+		   && dwarf_start_die == 0
+		   && parallel_workers > 1
+		   && num_units > 1
+		   && (num_debug_info_entries != 0 || do_types));
+
+  if ((do_loc || do_debug_loc || do_debug_ranges || do_debug_info)
+      && num_debug_info_entries == 0
+      && ! do_types)
+    {
+
+      /* Then allocate an array to hold the information.  */
+      debug_information = (debug_info *) cmalloc (num_units,
+						  sizeof (* debug_information));
+      if (debug_information == NULL)
+	{
+	  error (_("Not enough memory for a debug info array of %u entries\n"),
+		 num_units);
+	  alloc_num_debug_info_entries = num_debug_info_entries = 0;
+	  return false;
+	}
+
+      /* PR 17531: file: 92ca3797.
+	 We cannot rely upon the debug_information array being initialised
+	 before it is used.  A corrupt file could easily contain references
+	 to a unit for which information has not been made available.  So
+	 we ensure that the array is zeroed here.  */
+      memset (debug_information, 0, num_units * sizeof (*debug_information));
+
+      alloc_num_debug_info_entries = num_units;
+    }
+
+  if (!do_loc)
+    {
+      load_debug_section_with_follow (str, file);
+      load_debug_section_with_follow (line_str, file);
+      load_debug_section_with_follow (str_dwo, file);
+      load_debug_section_with_follow (str_index, file);
+      load_debug_section_with_follow (str_index_dwo, file);
+      load_debug_section_with_follow (debug_addr, file);
+    }
+
+  /* Worker processes share the file position of the input with each
+     other, so they must find every section they read already loaded.
+     The strings for DW_FORM_GNU_strp_alt are read from a separate
+     file, and with several such files each replaces the last.  */
+  if (parallel
+      && do_follow_links
+      && first_separate_info != NULL
+      && (first_separate_info->next != NULL
+	  || !load_debug_section (separate_debug_str,
+				  first_separate_info->handle)))
+    parallel = false;
+
+  load_debug_section_with_follow (abbrev_sec, file);
+  load_debug_section_with_follow (loclists, file);
+  load_debug_section_with_follow (rnglists, file);
+  load_debug_section_with_follow (loclists_dwo, file);
+  load_debug_section_with_follow (rnglists_dwo, file);
+
+  if (debug_displays [abbrev_sec].section.start == NULL)
+    {
+      warn (_("Unable to locate %s section!\n"),
+	    debug_displays [abbrev_sec].section.uncompressed_name);
+      return false;
+    }
+
+  if (!do_loc && dwarf_start_die == 0)
+    introduce (section, false);
+
+  free_all_abbrevs ();
+
+  /* In order to be able to resolve DW_FORM_ref_addr forms we need
+     to load *all* of the abbrevs for all CUs in this .debug_info
+     section.  This does effectively mean that we (partially) read
+     every CU header twice.  */
+  for (section_begin = start; start < end;)
+    {
+      DWARF2_Internal_CompUnit compunit;
+      unsigned char *hdrptr;
+      uint64_t abbrev_base;
+      size_t abbrev_size;
+      uint64_t cu_offset;
+      unsigned int offset_size;
+      struct cu_tu_set *this_set;
+      unsigned char *end_cu;
+
+      hdrptr = start;
+      cu_offset = start - section_begin;
+
+      SAFE_BYTE_GET_AND_INC (compunit.cu_length, hdrptr, 4, end);
+
+      if (compunit.cu_length == 0xffffffff)
+	{
+	  SAFE_BYTE_GET_AND_INC (compunit.cu_length, hdrptr, 8, end);
+	  offset_size = 8;
+	}
+      else
+	offset_size = 4;
+      end_cu = hdrptr + compunit.cu_length;
+
+      SAFE_BYTE_GET_AND_INC (compunit.cu_version, hdrptr, 2, end_cu);
+
+      this_set = find_cu_tu_set_v2 (cu_offset, do_types);
+
+      if (compunit.cu_version < 5)
+	{
+	  compunit.cu_unit_type = DW_UT_compile;
+	  /* Initialize it due to a false compiler warning.  */
+	  compunit.cu_pointer_size = -1;
+	}
+      else
+	{
+	  SAFE_BYTE_GET_AND_INC (compunit.cu_unit_type, hdrptr, 1, end_cu);
+	  do_types = (compunit.cu_unit_type == DW_UT_type);
+
+	  SAFE_BYTE_GET_AND_INC (compunit.cu_pointer_size, hdrptr, 1, end_cu);
+	}
+
+      SAFE_BYTE_GET_AND_INC (compunit.cu_abbrev_offset, hdrptr, offset_size,
+			     end_cu);
+
+      if (compunit.cu_unit_type == DW_UT_split_compile
+	  || compunit.cu_unit_type == DW_UT_skeleton)
+	{
+	  uint64_t dwo_id;
+	  SAFE_BYTE_GET_AND_INC (dwo_id, hdrptr, 8, end_cu);
+	}
+
+      if (this_set == NULL)
+	{
+	  abbrev_base = 0;
+	  abbrev_size = debug_displays [abbrev_sec].section.size;
+	}
+      else
+	{
+	  abbrev_base = this_set->section_offsets [DW_SECT_ABBREV];
+	  abbrev_size = this_set->section_sizes [DW_SECT_ABBREV];
+	}
+
+      abbrev_list *list;
+      abbrev_list *free_list;
+      list = find_and_process_abbrev_set (&debug_displays[abbrev_sec].section,
+					  abbrev_base, abbrev_size,
+					  compunit.cu_abbrev_offset,
+					  &free_list);
+      start = end_cu;
+      if (list != NULL && list->first_abbrev != NULL)
+	record_abbrev_list_for_cu (cu_offset, start - section_begin,
+				   list, free_list);
+      else if (free_list != NULL)
+	free_abbrev_list (free_list);
+    }
+
+  res = -1;
+  if (parallel)
+    res = process_debug_info_in_workers (section, abbrev_sec, &do_types,
+					 num_units);
+  if (res < 0)
+    res = process_debug_info_units (section, abbrev_sec, do_loc, &do_types,
+				    section_begin, end, 0);
+  if (res == 1)
+    return false;
+  if (res == 2)
+    return true;
 
   /* Set num_debug_info_entries here so that it can be used to check if
      we need to process .debug_loc and .debug_ranges sections.  */
@@ -4911,20 +5053,23 @@ typedef struct
   unsigned int length;
 } File_Entry;
 
-/* Output a decoded representation of the .debug_line section.  */
+/* Output a decoded representation of the line number programs in
+   SECTION from DATA up to LIMIT, for display_debug_lines_decoded.
+   Returns zero once all of them have been shown, one if an error
+   stopped the display, and two if the rest of the section had to be
+   skipped.  */
 
 static int
-display_debug_lines_decoded (struct dwarf_section *  section,
+display_line_tables_decoded (struct dwarf_section *  section,
 			     unsigned char *         start,
 			     unsigned char *         data,
+			     unsigned char *         limit,
 			     unsigned char *         end,
 			     void *                  fileptr)
 {
   static DWARF2_Internal_LineInfo saved_linfo;
 
-  introduce (section, false);
-
-  while (data < end)
+  while (data < limit)
     {
       /* This loop amounts to one iteration per compilation unit.  */
       DWARF2_Internal_LineInfo linfo;
@@ -4949,7 +5094,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 	  if (linfo.li_line_range == 0)
 	    {
 	      warn (_("Partial .debug_line. section encountered without a prior full .debug_line section\n"));
-	      return 0;
+	      return 1;
 	    }
 	  reset_state_machine (linfo.li_default_is_stmt);
 	}
@@ -4959,7 +5104,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 
 	  if ((hdrptr = read_debug_line_header (section, data, end, & linfo,
 						& end_of_sequence)) == NULL)
-	      return 0;
+	      return 1;
 
 	  /* PR 17531: file: 0522b371.  */
 	  if (linfo.li_line_range == 0)
@@ -4979,7 +5124,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 	    {
 	      warn (_("opcode base of %d extends beyond end of section\n"),
 		    linfo.li_opcode_base);
-	      return 0;
+	      return 1;
 	    }
 
 	  if (linfo.li_version >= 5)
@@ -5005,7 +5150,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 	      if (data >= end)
 		{
 		  warn (_("Corrupt directories list\n"));
-		  break;
+		  return 2;
 		}
 
 	      if (n_directories == 0)
@@ -5014,7 +5159,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 		{
 		  warn (_("number of directories (0x%x) exceeds size of section %s\n"),
 			n_directories, section->name);
-		  return 0;
+		  return 1;
 		}
 	      else
 		directory_table = (char **)
@@ -5086,7 +5231,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 	      if (data >= end && n_files > 0)
 		{
 		  warn (_("Corrupt file name list\n"));
-		  break;
+		  return 2;
 		}
 
 	      if (n_files == 0)
@@ -5095,7 +5240,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 		{
 		  warn (_("number of files (0x%x) exceeds size of section %s\n"),
 			n_files, section->name);
-		  return 0;
+		  return 1;
 		}
 	      else
 		file_table = (File_Entry *) xcalloc (n_files,
@@ -5187,7 +5332,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 		    {
 		      warn (_("directory table ends unexpectedly\n"));
 		      n_directories = 0;
-		      break;
+		      return 2;
 		    }
 
 		  /* Go through the directory table again to save the directories.  */
@@ -5227,7 +5372,7 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 		    {
 		      warn (_("file table ends unexpectedly\n"));
 		      n_files = 0;
-		      break;
+		      return 2;
 		    }
 
 		  /* Go through the file table again to save the strings.  */
@@ -5717,7 +5862,125 @@ display_debug_lines_decoded (struct dwarf_section *  section,
       putchar ('\n');
     }
 
-  return 1;
+  if (data > limit && limit < end)
+    {
+      /* The last program ran on into the next one, which is then read
+	 from where it stopped rather than from its start.  Carry on from
+	 there to the end of the section, and stop any other worker.  */
+      int res = display_line_tables_decoded (section, start, data, end, end,
+					     fileptr);
+      return res != 0 ? res : 2;
+    }
+
+  return 0;
+}
+
+/* The line number programs of a .debug_line section shared out among
+   worker processes by display_debug_lines_decoded.  */
+
+struct line_tables_work
+{
+  struct dwarf_section *section;
+  unsigned char *start;
+  void *fileptr;
+  /* The start of each program, and the end of the last one.  */
+  unsigned char **tables;
+};
+
+static uint64_t
+line_table_weight (size_t table, void *data)
+{
+  struct line_tables_work *work = (struct line_tables_work *) data;
+
+  return work->tables[table + 1] - work->tables[table];
+}
+
+static int
+display_line_tables_run (size_t first, size_t end, void *data)
+{
+  struct line_tables_work *work = (struct line_tables_work *) data;
+
+  return display_line_tables_decoded (work->section, work->start,
+				      work->tables[first], work->tables[end],
+				      work->section->start
+				      + work->section->size,
+				      work->fileptr);
+}
+
+/* Output a decoded representation of the .debug_line section.  */
+
+static int
+display_debug_lines_decoded (struct dwarf_section *  section,
+			     unsigned char *         start,
+			     unsigned char *         data,
+			     unsigned char *         end,
+			     void *                  fileptr)
+{
+  struct line_tables_work work;
+  size_t num_tables, max_tables;
+  unsigned char *last;
+  int res;
+
+  introduce (section, false);
+
+  /* Partial .debug_line. sections continue the program of the full
+     section before them, so they are not worth sharing out.  */
+  if (parallel_workers < 2
+      || (startswith (section->name, ".debug_line.")
+	  && strcmp (section->name, ".debug_line.dwo") != 0))
+    return display_line_tables_decoded (section, start, data, end, end,
+					fileptr) != 1;
+
+  /* Find where each program starts, up to the first that has a bad
+     length, which is left with everything after it to be shown here.  */
+  work.section = section;
+  work.start = start;
+  work.fileptr = fileptr;
+  max_tables = 64;
+  work.tables = (unsigned char **) xmalloc (max_tables
+					    * sizeof (*work.tables));
+  num_tables = 0;
+  last = data;
+  while (last < end)
+    {
+      unsigned char *hdrptr = last;
+      uint64_t length;
+
+      SAFE_BYTE_GET_AND_INC (length, hdrptr, 4, end);
+      if (length == 0xffffffff)
+	SAFE_BYTE_GET_AND_INC (length, hdrptr, 8, end);
+      if (length == 0 || length > (size_t) (end - hdrptr))
+	break;
+      if (num_tables + 1 >= max_tables)
+	{
+	  max_tables *= 2;
+	  work.tables = (unsigned char **)
+	    xrealloc (work.tables, max_tables * sizeof (*work.tables));
+	}
+      work.tables[num_tables++] = last;
+      last = hdrptr + length;
+    }
+
+  /* The last program is always shown here, so that it sets what any
+     partial sections after this one start from.  */
+  if (last == end && num_tables > 0)
+    last = work.tables[--num_tables];
+  work.tables[num_tables] = last;
+
+  /* The workers share the file position of the input, so load the
+     section the tables take their strings from before starting them.  */
+  load_debug_section_with_follow (line_str, fileptr);
+
+  res = run_in_workers (num_tables, line_table_weight,
+			display_line_tables_run, &work);
+  free (work.tables);
+  if (res < 0)
+    res = display_line_tables_decoded (section, start, data, end, end,
+				       fileptr);
+  else if (res == 0)
+    res = display_line_tables_decoded (section, start, last, end, end,
+				       fileptr);
+  return res != 1;
 }
 
 static int
@@ -32,6 +32,10 @@
 #include "aout/ar.h"
 #include "elfcomm.h"
 #include <assert.h>
+#include <signal.h>
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
 
 extern char *program_name;
 
@@ -798,3 +802,259 @@ make_qualified_name (struct archive_info * arch,
 
   return name;
 }
+
+/* The number of processes run_in_workers may use at once.  */
+unsigned int parallel_workers = 1;
+
+/* Set parallel_workers from the argument ARG of a --parallel option,
+   or to the number of online processors if ARG is NULL.  Returns FALSE
+   if ARG is not a valid count.  */
+
+bool
+set_parallel_workers (const char *arg)
+{
+  if (arg != NULL)
+    {
+      char *end;
+      unsigned long count = strtoul (arg, &end, 0);
+
+      if (*arg == '\0' || *end != '\0'
+	  || count == 0 || count != (unsigned int) count)
+	return false;
+      parallel_workers = count;
+    }
+  else
+    {
+      long count = 0;
+#ifdef _SC_NPROCESSORS_ONLN
+      count = sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+      parallel_workers = count > 1 ? count : 1;
+    }
+  return true;
+}
+
+#ifdef HAVE_SYS_WAIT_H
+
+/* A run of items handed to one worker process.  */
+
+struct worker_run
+{
+  size_t first, end;	/* The items, FIRST up to but not including END.  */
+  pid_t pid;		/* The worker, or zero once it has finished.  */
+  int status;		/* Its wait status.  */
+  FILE *out;		/* What it wrote to stdout.  */
+  FILE *err;		/* What it wrote to stderr, or NULL if that went
+			   to OUT as well.  */
+};
+
+/* Copy the contents of the temporary file TMP to STREAM and close it.  */
+
+static void
+copy_worker_output (FILE *tmp, FILE *stream)
+{
+  char buf[8192];
+  size_t n;
+
+  if (tmp == NULL)
+    return;
+  rewind (tmp);
+  while ((n = fread (buf, 1, sizeof (buf), tmp)) > 0)
+    fwrite (buf, 1, n, stream);
+  fclose (tmp);
+}
+
+/* Return TRUE if stdout and stderr are the same file.  */
+
+static bool
+same_output_file (void)
+{
+  struct stat out_st, err_st;
+
+  return (fstat (fileno (stdout), &out_st) == 0
+	  && fstat (fileno (stderr), &err_st) == 0
+	  && out_st.st_dev == err_st.st_dev
+	  && out_st.st_ino == err_st.st_ino);
+}
+
+#endif /* HAVE_SYS_WAIT_H */
+
+/* Call FN (FIRST, END, DATA) on runs of the COUNT items that together
+   cover them all, in up to parallel_workers processes at once, and
+   pass on what each run prints in the order of the items, so that the
+   output is the same as that of calling FN (0, COUNT, DATA).  WEIGHT
+   (I, DATA) is the cost of item I, used to share out the work.
+
+   The workers are forked rather than threads, as the callers print as
+   they go and keep their state in globals.  Nothing FN changes in
+   memory is seen by the caller.
+
+   FN returns zero to go on with the items after END, or a value less
+   than WORKER_ERROR to stop after them, in which case the output of the
+   later runs is discarded.  WORKER_ERROR may be added to either to
+   report an error.  Returns the value that stopped the runs, or zero if
+   all of them were done, plus WORKER_ERROR if any run reported an
+   error.  Returns -1 if there is only one worker or one item, or no
+   worker process could be started, in which case nothing has been
+   done and the caller should go through the items itself.  If a worker
+   cannot be started once some runs are done, an error is reported and
+   the runs stop there, as though FN had returned 1 + WORKER_ERROR.  */
+
+int
+run_in_workers (size_t count,
+		uint64_t (*weight) (size_t, void *),
+		int (*fn) (size_t, size_t, void *),
+		void *data)
+{
+#ifdef HAVE_SYS_WAIT_H
+  struct worker_run *runs;
+  size_t nruns, n, i, started, emitted;
+  unsigned int running;
+  uint64_t total, sum;
+  bool one_file;
+  int result, errors;
+
+  if (parallel_workers < 2 || count < 2)
+    return -1;
+
+  /* Cut the items into runs of about the same weight, a few for each
+     worker so that one heavy run does not leave the others idle.  */
+  nruns = (size_t) parallel_workers * 4;
+  if (nruns > count)
+    nruns = count;
+  total = 0;
+  for (i = 0; i < count; i++)
+    total += weight (i, data);
+  runs = (struct worker_run *) xcalloc (nruns, sizeof (*runs));
+  n = 0;
+  sum = 0;
+  for (i = 0; i + 1 < count && n + 1 < nruns; i++)
+    {
+      sum += weight (i, data);
+      if (sum >= total / nruns * (n + 1))
+	{
+	  runs[n].end = i + 1;
+	  runs[++n].first = i + 1;
+	}
+    }
+  runs[n].end = count;
+  nruns = n + 1;
+
+  /* If stdout and stderr go to the same place, have each worker write
+     both to the same temporary file so that they stay interleaved.  */
+  one_file = same_output_file ();
+
+  fflush (stdout);
+  fflush (stderr);
+  result = errors = 0;
+  started = emitted = 0;
+  running = 0;
+  while (emitted < started || (result == 0 && started < nruns))
+    {
+      while (result == 0 && started < nruns && running < parallel_workers)
+	{
+	  struct worker_run *run = &runs[started];
+
+	  run->out = tmpfile ();
+	  run->err = one_file ? NULL : tmpfile ();
+	  run->pid = -1;
+	  if (run->out != NULL && (one_file || run->err != NULL))
+	    run->pid = fork ();
+	  if (run->pid == 0)
+	    {
+	      int status;
+
+	      dup2 (fileno (run->out), fileno (stdout));
+	      dup2 (fileno (run->err ? run->err : run->out), fileno (stderr));
+	      status = fn (run->first, run->end, data);
+	      fflush (stdout);
+	      fflush (stderr);
+	      _exit (status);
+	    }
+	  if (run->pid < 0)
+	    {
+	      if (run->out != NULL)
+		fclose (run->out);
+	      if (run->err != NULL)
+		fclose (run->err);
+	      break;
+	    }
+	  started++;
+	  running++;
+	}
+
+      if (running == 0)
+	{
+	  /* No process could be started, and none is left to wait for.
+	     Running FN here would change the caller's state, so leave
+	     the items to the caller if none has been done.  */
+	  if (started == 0)
+	    result = -1;
+	  else
+	    {
+	      error (_("unable to start a worker process\n"));
+	      result = 1;
+	      errors = WORKER_ERROR;
+	    }
+	  break;
+	}
+
+      int status;
+      pid_t pid = waitpid (-1, &status, 0);
+      if (pid < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  /* Should not happen, but don't wait for ever.  */
+	  error (_("lost track of the worker processes\n"));
+	  result = 1;
+	  break;
+	}
+      for (i = emitted; i < started; i++)
+	if (runs[i].pid == pid)
+	  {
+	    runs[i].pid = 0;
+	    runs[i].status = status;
+	    running--;
+	    break;
+	  }
+
+      /* Pass on the output of the finished runs in order.  */
+      while (emitted < started && runs[emitted].pid == 0)
+	{
+	  struct worker_run *run = &runs[emitted++];
+
+	  if (result != 0)
+	    {
+	      fclose (run->out);
+	      if (run->err != NULL)
+		fclose (run->err);
+	      continue;
+	    }
+	  copy_worker_output (run->out, stdout);
+	  fflush (stdout);
+	  copy_worker_output (run->err, stderr);
+	  fflush (stderr);
+	  if (WIFSIGNALED (run->status))
+	    {
+	      /* Die the way the worker did.  */
+	      signal (WTERMSIG (run->status), SIG_DFL);
+	      raise (WTERMSIG (run->status));
+	    }
+	  errors |= WEXITSTATUS (run->status) & WORKER_ERROR;
+	  result = WEXITSTATUS (run->status) & ~WORKER_ERROR;
+	  if (result != 0)
+	    for (i = emitted; i < started; i++)
+	      if (runs[i].pid != 0)
+		kill (runs[i].pid, SIGKILL);
+	}
+    }
+
+  free (runs);
+  if (result < 0)
+    return result;
+  return result | errors;
+#else
+  return -1;
+#endif
+}
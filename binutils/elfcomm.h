@@ -96,4 +96,19 @@ extern char *make_qualified_name (struct archive_info *,
 				  struct archive_info *,
 				  const char *);
 
+/* The number of worker processes to use, set by --parallel.  */
+extern unsigned int parallel_workers;
+
+/* Set parallel_workers from the argument of a --parallel option.  */
+extern bool set_parallel_workers (const char *);
+
+/* Added to the value returned by the function given to run_in_workers
+   to report an error without stopping.  */
+#define WORKER_ERROR 0x80
+
+/* Call a function on runs of items in worker processes, passing on
+   their output in order.  */
+extern int run_in_workers (size_t, uint64_t (*) (size_t, void *),
+			   int (*) (size_t, size_t, void *), void *);
+
 #endif /* _ELFCOMM_H */
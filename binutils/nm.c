@@ -35,6 +35,7 @@
 #include "coff/internal.h"
 #include "libcoff.h"
 #include "bucomm.h"
+#include "elfcomm.h"
 #include "demanguse.h"
 #include "plugin-api.h"
 #include "plugin.h"
@@ -240,7 +241,8 @@ enum long_option_values
   OPTION_NO_RECURSE_LIMIT,
   OPTION_IFUNC_CHARS,
   OPTION_UNICODE,
-  OPTION_QUIET
+  OPTION_QUIET,
+  OPTION_PARALLEL
 };
 
 static struct option long_options[] =
@@ -260,6 +262,7 @@ static struct option long_options[] =
   {"no-recursion-limit", no_argument, NULL, OPTION_NO_RECURSE_LIMIT},
   {"no-sort", no_argument, 0, 'p'},
   {"numeric-sort", no_argument, 0, 'n'},
+  {"parallel", optional_argument, NULL, OPTION_PARALLEL},
   {"plugin", required_argument, 0, OPTION_PLUGIN},
   {"portability", no_argument, 0, 'P'},
   {"print-armap", no_argument, &print_armap, 1},
@@ -333,6 +336,9 @@ usage (FILE *stream, int status)
   -p, --no-sort          Do not sort the symbols\n"));
   fprintf (stream, _("\
   -P, --portability      Same as --format=posix\n"));
+  fprintf (stream, _("\
+      --parallel[=N]     Use N processes (default: all CPUs) to list the\n\
+                           symbols of archive members\n"));
   fprintf (stream, _("\
   -r, --reverse-sort     Reverse the sense of the sort\n"));
 #if BFD_SUPPORTS_PLUGINS
@@ -1563,18 +1569,83 @@ set_print_width (bfd *file)
   print_format_string = get_print_format ();
 }
 
+/* Display the symbols of ARFILE, a member of the archive FILE.  */
+
+static bool
+display_archive_member (bfd *file, bfd *arfile, void *data ATTRIBUTE_UNUSED)
+{
+  char **matching;
+
+  if (bfd_check_format_matches (arfile, bfd_object, &matching))
+    {
+      set_print_width (arfile);
+      format->print_archive_member (bfd_get_filename (file),
+				    bfd_get_filename (arfile));
+      display_rel_file (arfile, file);
+    }
+  else
+    {
+      bfd_nonfatal (bfd_get_filename (arfile));
+      if (bfd_get_error () == bfd_error_file_ambiguously_recognized)
+	list_matching_formats (matching);
+    }
+
+  free_lineno_cache (arfile);
+  return true;
+}
+
+static uint64_t
+archive_member_weight (size_t i, void *data)
+{
+  return bfd_archive_member_size ((bfd *) data, i);
+}
+
+/* Display the symbols of members FIRST up to END of the archive DATA,
+   in a worker process.  */
+
+static int
+display_archive_members (size_t first, size_t end, void *data)
+{
+  bfd *file = (bfd *) data;
+  unsigned int workers = parallel_workers;
+  int res = 0;
+
+  /* Reopen the archive rather than share its file position with the
+     other workers.  */
+  bfd_cache_close_all ();
+  parallel_workers = 1;
+  if (!bfd_map_over_archive_members (file, first, end,
+				     display_archive_member, NULL))
+    {
+      bfd_nonfatal (bfd_get_filename (file));
+      res = 1;
+    }
+  parallel_workers = workers;
+  return res;
+}
+
 static void
 display_archive (bfd *file)
 {
   bfd *arfile = NULL;
   bfd *last_arfile = NULL;
-  char **matching;
 
   format->print_archive_filename (bfd_get_filename (file));
 
   if (print_armap)
     print_symdef_entry (file);
 
+  /* With --parallel, share out the members among worker processes.  */
+  if (parallel_workers > 1)
+    {
+      size_t count = bfd_archive_member_count (file);
+
+      if (count != (size_t) -1
+	  && run_in_workers (count, archive_member_weight,
+			     display_archive_members, file) >= 0)
+	return;
+    }
+
   for (;;)
     {
       arfile = bfd_openr_next_archived_file (file, arfile);
@@ -1586,23 +1657,10 @@ display_archive (bfd *file)
 	  break;
 	}
 
-      if (bfd_check_format_matches (arfile, bfd_object, &matching))
-	{
-	  set_print_width (arfile);
-	  format->print_archive_member (bfd_get_filename (file),
-					bfd_get_filename (arfile));
-	  display_rel_file (arfile, file);
-	}
-      else
-	{
-	  bfd_nonfatal (bfd_get_filename (arfile));
-	  if (bfd_get_error () == bfd_error_file_ambiguously_recognized)
-	    list_matching_formats (matching);
-	}
+      display_archive_member (file, arfile, NULL);
 
       if (last_arfile != NULL)
 	{
-	  free_lineno_cache (last_arfile);
 	  bfd_close (last_arfile);
 	  if (arfile == last_arfile)
 	    return;
@@ -1611,10 +1669,7 @@ display_archive (bfd *file)
     }
 
   if (last_arfile != NULL)
-    {
-      free_lineno_cache (last_arfile);
-      bfd_close (last_arfile);
-    }
+    bfd_close (last_arfile);
 }
 
 static bool
@@ -2016,6 +2071,10 @@ main (int argc, char **argv)
 	case OPTION_QUIET:
 	  quiet = 1;
 	  break;
+	case OPTION_PARALLEL:
+	  if (!set_parallel_workers (optarg))
+	    fatal (_("invalid number of processes: %s"), optarg);
+	  break;
 	case 'D':
 	  dynamic = 1;
 	  break;
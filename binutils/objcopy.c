@@ -23,6 +23,7 @@
 #include "getopt.h"
 #include "libiberty.h"
 #include "bucomm.h"
+#include "elfcomm.h"
 #include "budbg.h"
 #include "filenames.h"
 #include "fnmatch.h"
@@ -36,6 +37,10 @@
 #include "coff/i386.h"
 #include "coff/pe.h"
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 static bfd_vma pe_file_alignment = (bfd_vma) -1;
 static bfd_vma pe_heap_commit = (bfd_vma) -1;
 static bfd_vma pe_heap_reserve = (bfd_vma) -1;
@@ -176,6 +181,9 @@ static bfd_vma set_start;
 /* Changes to section addresses.  */
 static bfd_vma change_section_address = 0;
 
+/* Whether to warn about section address changes that are never used.  */
+static bool change_warn = true;
+
 /* Filling gaps between sections.  */
 static bool gap_fill_set = false;
 static bfd_byte gap_fill = 0;
@@ -347,6 +355,7 @@ enum command_line_switch
   OPTION_NO_CHANGE_WARNINGS,
   OPTION_ONLY_KEEP_DEBUG,
   OPTION_PAD_TO,
+  OPTION_PARALLEL,
   OPTION_PREFIX_ALLOC_SECTIONS,
   OPTION_PREFIX_SECTIONS,
   OPTION_PREFIX_SYMBOLS,
@@ -402,6 +411,7 @@ static struct option strip_options[] =
   {"output-file", required_argument, 0, 'o'},
   {"output-format", required_argument, 0, 'O'},	/* Obsolete */
   {"output-target", required_argument, 0, 'O'},
+  {"parallel", optional_argument, 0, OPTION_PARALLEL},
   {"preserve-dates", no_argument, 0, 'p'},
   {"remove-section", required_argument, 0, 'R'},
   {"remove-relocations", required_argument, 0, OPTION_REMOVE_RELOCS},
@@ -484,6 +494,7 @@ static struct option copy_options[] =
   {"output-format", required_argument, 0, 'O'},	/* Obsolete */
   {"output-target", required_argument, 0, 'O'},
   {"pad-to", required_argument, 0, OPTION_PAD_TO},
+  {"parallel", optional_argument, 0, OPTION_PARALLEL},
   {"prefix-alloc-sections", required_argument, 0, OPTION_PREFIX_ALLOC_SECTIONS},
   {"prefix-sections", required_argument, 0, OPTION_PREFIX_SECTIONS},
   {"prefix-symbols", required_argument, 0, OPTION_PREFIX_SYMBOLS},
@@ -592,6 +603,8 @@ copy_usage (FILE *stream, int exit_status)
   -U --disable-deterministic-archives\n\
                                    Disable -D behavior (default)\n"));
   fprintf (stream, _("\
+     --parallel[=<number>]         Copy the members of archives in <number>\n\
+                                     processes (default: all CPUs)\n\
   -j --only-section <name>         Only copy section <name> into the output\n\
      --add-gnu-debuglink=<file>    Add section .gnu_debuglink linking to <file>\n\
   -R --remove-section <name>       Remove section <name> from the output\n\
@@ -733,6 +746,8 @@ strip_usage (FILE *stream, int exit_status)
   -U --disable-deterministic-archives\n\
                                    Disable -D behavior (default)\n"));
   fprintf (stream, _("\
+     --parallel[=<number>]         Strip the members of archives in <number>\n\
+                                     processes (default: all CPUs)\n\
   -R --remove-section=<name>       Also remove section <name> from the output\n\
      --remove-relocations <name>   Remove relocations from section <name>\n\
      --strip-section-headers       Strip section headers from the output\n\
@@ -1996,9 +2011,6 @@ copy_unknown_object (bfd *ibfd, bfd *obfd)
       size -= tocopy;
     }
 
-  /* We should at least to be able to read it back when copying an
-     unknown object in an archive.  */
-  chmod (bfd_get_filename (obfd), buf.st_mode | S_IRUSR);
   free (cbuf);
   return true;
 }
@@ -3596,30 +3608,509 @@ copy_object (bfd *ibfd, bfd *obfd, const bfd_arch_info_type *input_arch)
   return true;
 }
 
-/* Read each archive element in turn from IBFD, copy the
-   contents to temp file, and keep the temp file handle.
-   If 'force_output_target' is TRUE then make sure that
-   all elements in the new archive are of the type
-   'output_target'.  */
+/* Give OUTPUT_ELEMENT, the copy of an archive member, the mode of the
+   member, and its modification time too if dates are being preserved,
+   as found in BUF by bfd_stat_arch_elt.  */
+
+static void
+set_copied_member_stat (bfd *output_element, const struct stat *buf)
+{
+  output_element->mode = buf->st_mode;
+  output_element->mode_set = true;
+  if (preserve_dates)
+    {
+      output_element->mtime = buf->st_mtime;
+      output_element->mtime_set = true;
+    }
+}
+
+/* Copy THIS_ELEMENT, a member of an archive, to a new BFD in memory
+   named after it.  If FORCE_OUTPUT_TARGET is TRUE the copy is of type
+   OUTPUT_TARGET, otherwise of the type of THIS_ELEMENT.  Return the
+   copy ready to be added to the output archive, or NULL with status
+   set if it could not be made.  */
+
+static bfd *
+copy_archive_member (bfd *this_element, const char *output_target,
+		     bool force_output_target,
+		     const bfd_arch_info_type *input_arch)
+{
+  const char *name = bfd_get_filename (this_element);
+  bfd *output_element;
+  struct stat buf;
+  int stat_status;
+  bool del = true;
+  bool ok_object;
+
+  /* PR binutils/17533: Do not allow directory traversal
+     outside of the current directory tree by archive members.  */
+  if (! is_valid_archive_path (name))
+    {
+      non_fatal (_("illegal pathname found in archive member: %s"), name);
+      status = 1;
+      return NULL;
+    }
+
+  memset (&buf, 0, sizeof (buf));
+  stat_status = bfd_stat_arch_elt (this_element, &buf);
+  if (preserve_dates && stat_status != 0)
+    non_fatal (_("internal stat error on %s"), name);
+
+  ok_object = bfd_check_format (this_element, bfd_object);
+  if (!ok_object)
+    bfd_nonfatal_message (NULL, this_element, NULL,
+			  _("Unable to recognise the format of file"));
+
+  /* PR binutils/3110: Cope with archives
+     containing multiple target types.  */
+  if (force_output_target || !ok_object)
+    output_element = bfd_openw_memory (name, output_target);
+  else
+    output_element = bfd_openw_memory (name, bfd_get_target (this_element));
+
+  if (output_element == NULL)
+    {
+      bfd_nonfatal_message (name, NULL, NULL, NULL);
+      status = 1;
+      return NULL;
+    }
+
+  if (ok_object)
+    {
+      del = !copy_object (this_element, output_element, input_arch);
+
+      if (del && bfd_get_arch (this_element) == bfd_arch_unknown)
+	/* Try again as an unknown object file.  */
+	ok_object = false;
+    }
+
+  if (!ok_object)
+    del = !copy_unknown_object (this_element, output_element);
+
+  if (!del && !status && !bfd_make_readable (output_element))
+    {
+      bfd_nonfatal_message (name, NULL, NULL, NULL);
+      del = true;
+    }
+
+  if (del || status)
+    {
+      /* Error in new object file. Don't change archive.  */
+      bfd_close_all_done (output_element);
+      status = 1;
+      return NULL;
+    }
+
+  if (stat_status == 0)
+    set_copied_member_stat (output_element, &buf);
+
+  return output_element;
+}
+
+#if defined (HAVE_MMAP) && defined (MAP_ANONYMOUS)
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+/* Return TRUE if copying one member of an archive does not change how
+   the others are copied, or what is done after them, so that the
+   members can be copied in separate processes.  */
+
+static bool
+archive_members_independent (void)
+{
+  struct section_list *p;
+  struct addsym_node *ptr;
+
+  /* Each member would write the same --dump-section files.  */
+  if (dump_sections != NULL)
+    return false;
+
+  /* Whether a --change-section-vma or --change-section-lma was never
+     used depends on all the members.  */
+  if (change_warn)
+    for (p = change_sections; p != NULL; p = p->next)
+      if ((p->context & (SECTION_CONTEXT_SET_VMA | SECTION_CONTEXT_ALTER_VMA
+			 | SECTION_CONTEXT_SET_LMA
+			 | SECTION_CONTEXT_ALTER_LMA)) != 0)
+	return false;
+
+  /* An --add-symbol with before= is only added to the first member
+     that has the other symbol.  */
+  for (ptr = add_sym_list; ptr != NULL; ptr = ptr->next)
+    if (ptr->othersym != NULL)
+      return false;
+
+  return true;
+}
+
+/* What a worker process did with a member of an archive.  */
+
+enum copied_member_state
+{
+  member_not_copied,
+  member_copied,
+  member_too_big
+};
+
+/* Where a worker process leaves the copy of a member of an archive,
+   in memory shared with the parent.  The copy is SIZE octets at
+   OFFSET in the arena, which has ROOM octets set aside for it.  If
+   the copy did not fit, SIZE is the room it needs.  */
+
+struct copied_member
+{
+  size_t offset;
+  size_t room;
+  size_t size;
+  enum copied_member_state state;
+};
+
+/* What copy_archive_members returns to stop the workers.  */
+#define COPY_FAILED 1	/* A member could not be copied.  */
+#define COPY_AGAIN 2	/* A member needs more room.  */
+
+struct archive_copy
+{
+  bfd *ibfd;
+  const char *output_target;
+  bool force_output_target;
+  const bfd_arch_info_type *input_arch;
+  /* The room to set aside for the copy of each member of IBFD.  */
+  uint64_t *room;
+  /* Whether a member was found to need more room.  */
+  bool grew;
+  /* The first member copied by this pass of the workers.  */
+  size_t first;
+  /* The shared memory, starting with one copied_member for each
+     member of IBFD from FIRST on.  */
+  void *arena;
+  size_t arena_size;
+  struct copied_member *members;
+  /* Whether the workers stopped on an error.  */
+  bool failed;
+  /* In a worker, whether a copy did not fit, and where its stdout and
+     stderr were before the first such copy.  */
+  bool too_big;
+  off_t out_pos;
+  off_t err_pos;
+  /* The index of the member being visited.  */
+  size_t next;
+  /* The index after the last member added to the output archive.  */
+  size_t done;
+  /* Where to add the next copy to the output archive.  */
+  bfd **ptr;
+};
+
+static uint64_t
+archive_member_weight (size_t i, void *data)
+{
+  struct archive_copy *ac = (struct archive_copy *) data;
+
+  return bfd_archive_member_size (ac->ibfd, ac->first + i);
+}
+
+/* The room first set aside for the copy of member I of IBFD: twice its
+   size, and some more for small members.  */
+
+static uint64_t
+copied_member_room (bfd *ibfd, size_t i)
+{
+  return 2 * (uint64_t) bfd_archive_member_size (ibfd, i) + 0x10000;
+}
+
+/* Copy THIS_ELEMENT into the shared memory of DATA, in a worker
+   process.  Once a copy does not fit, only note the room needed by it
+   and by the members after it.  */
+
+static bool
+copy_member_in_worker (bfd *ibfd ATTRIBUTE_UNUSED, bfd *this_element,
+		       void *data)
+{
+  struct archive_copy *ac = (struct archive_copy *) data;
+  struct copied_member *m = &ac->members[ac->next++ - ac->first];
+  bfd *output_element;
+  ufile_ptr size;
+
+  if (!ac->too_big)
+    {
+      /* Stdout and stderr are the worker's temporary files.  */
+      fflush (stdout);
+      fflush (stderr);
+      ac->out_pos = lseek (fileno (stdout), 0, SEEK_CUR);
+      ac->err_pos = lseek (fileno (stderr), 0, SEEK_CUR);
+    }
+
+  output_element = copy_archive_member (this_element, ac->output_target,
+					ac->force_output_target,
+					ac->input_arch);
+  if (output_element == NULL)
+    return false;
+
+  size = bfd_get_size (output_element);
+  if (size > m->room)
+    {
+      m->size = size;
+      m->state = member_too_big;
+      ac->too_big = true;
+    }
+  else if (ac->too_big)
+    ;
+  else if (bfd_seek (output_element, 0, SEEK_SET) != 0
+	   || bfd_read ((bfd_byte *) ac->arena + m->offset, size,
+			output_element) != size)
+    {
+      bfd_nonfatal_message (NULL, output_element, NULL, NULL);
+      status = 1;
+    }
+  else
+    {
+      m->size = size;
+      m->state = member_copied;
+    }
+
+  bfd_close (output_element);
+  return status == 0;
+}
+
+/* Copy members FIRST up to END of the members of the archive in DATA
+   from its FIRST on, in a worker process.  */
+
+static int
+copy_archive_members (size_t first, size_t end, void *data)
+{
+  struct archive_copy *ac = (struct archive_copy *) data;
+  bool ok;
+
+  /* Reopen the archive rather than share its file position with the
+     other workers.  */
+  bfd_cache_close_all ();
+  ac->next = ac->first + first;
+  ac->too_big = false;
+  ok = bfd_map_over_archive_members (ac->ibfd, ac->first + first,
+				     ac->first + end,
+				     copy_member_in_worker, ac);
+  if (ac->too_big)
+    {
+      /* The next pass copies the members from the first that did not
+	 fit, so drop what was printed for them.  Should that fail the
+	 messages are merely printed twice.  */
+      fflush (stdout);
+      fflush (stderr);
+      if (ac->out_pos >= 0
+	  && ac->err_pos >= 0
+	  && ftruncate (fileno (stdout), ac->out_pos) == 0
+	  && ftruncate (fileno (stderr), ac->err_pos) == 0)
+	{
+	  lseek (fileno (stdout), ac->out_pos, SEEK_SET);
+	  lseek (fileno (stderr), ac->err_pos, SEEK_SET);
+	}
+      return COPY_AGAIN;
+    }
+  return ok ? 0 : COPY_FAILED;
+}
+
+/* Add the copy of THIS_ELEMENT left by a worker process to the output
+   archive, up to the first member not copied.  After a member that
+   did not fit, only note the room needed by the members.  */
+
+static bool
+add_copied_member (bfd *ibfd ATTRIBUTE_UNUSED, bfd *this_element,
+		   void *data)
+{
+  struct archive_copy *ac = (struct archive_copy *) data;
+  size_t i = ac->next++;
+  struct copied_member *m = &ac->members[i - ac->first];
+  const char *name = bfd_get_filename (this_element);
+  bfd *output_element;
+  struct stat buf;
+
+  if (ac->grew)
+    {
+      if (m->state == member_too_big)
+	ac->room[i] = m->size;
+      return true;
+    }
+
+  switch (m->state)
+    {
+    case member_copied:
+      output_element = bfd_openw_memory (name, ac->output_target);
+      if (output_element == NULL
+	  || bfd_write ((bfd_byte *) ac->arena + m->offset, m->size,
+			output_element) != m->size
+	  || !bfd_make_readable (output_element))
+	{
+	  bfd_nonfatal_message (name, NULL, NULL, NULL);
+	  if (output_element != NULL)
+	    bfd_close_all_done (output_element);
+	  status = 1;
+	  return false;
+	}
+      if (bfd_stat_arch_elt (this_element, &buf) == 0)
+	set_copied_member_stat (output_element, &buf);
+      break;
+
+    case member_too_big:
+      /* Copy it and the members after it again in the next pass,
+	 with the room they need.  */
+      ac->room[i] = m->size;
+      ac->grew = true;
+      return true;
+
+    default:
+      /* Either the worker stopped here after reporting why, or the
+	 member is left for the next pass.  */
+      if (ac->failed)
+	status = 1;
+      return false;
+    }
+
+  *ac->ptr = output_element;
+  ac->ptr = &output_element->archive_next;
+  ac->done = i + 1;
+  return true;
+}
+
+/* Copy the members of the archive in AC from its FIRST up to COUNT in
+   worker processes, each making its copies in memory shared with this
+   process, and add them to the output archive in order, up to the
+   first that could not be copied.  */
+
+static void
+copy_archive_pass (struct archive_copy *ac, size_t count)
+{
+  size_t n = count - ac->first;
+  size_t i, offset;
+  uint64_t total;
+  int res;
+
+  ac->done = ac->first;
+  ac->grew = false;
+  total = (uint64_t) n * sizeof (struct copied_member);
+  for (i = ac->first; i < count; i++)
+    total += ac->room[i];
+  if (total != (size_t) total)
+    return;
+
+  ac->arena_size = total;
+  ac->arena = mmap (NULL, ac->arena_size, PROT_READ | PROT_WRITE,
+		    MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (ac->arena == MAP_FAILED)
+    return;
+
+  ac->members = (struct copied_member *) ac->arena;
+  offset = n * sizeof (struct copied_member);
+  for (i = 0; i < n; i++)
+    {
+      ac->members[i].offset = offset;
+      ac->members[i].room = ac->room[ac->first + i];
+      offset += ac->members[i].room;
+    }
+
+  res = run_in_workers (n, archive_member_weight, copy_archive_members, ac);
+  if (res >= 0)
+    {
+      /* Whatever stopped the workers has been reported already.  */
+      ac->failed = (res & ~WORKER_ERROR) == COPY_FAILED;
+      ac->next = ac->first;
+      bfd_map_over_archive_members (ac->ibfd, ac->first, count,
+				    add_copied_member, ac);
+    }
+
+  munmap (ac->arena, ac->arena_size);
+}
+
+/* Copy THIS_ELEMENT in this process and add the copy to the output
+   archive, for the members the workers left.  */
+
+static bool
+add_member_copy (bfd *ibfd ATTRIBUTE_UNUSED, bfd *this_element, void *data)
+{
+  struct archive_copy *ac = (struct archive_copy *) data;
+  bfd *output_element;
+
+  output_element = copy_archive_member (this_element, ac->output_target,
+					ac->force_output_target,
+					ac->input_arch);
+  if (output_element == NULL)
+    return false;
+
+  *ac->ptr = output_element;
+  ac->ptr = &output_element->archive_next;
+  return true;
+}
+
+/* Copy the members of IBFD in worker processes and add the copies to
+   the list at *PTR in the order of the members.  When the copy of a
+   member turns out bigger than the room set aside for it, that member
+   and the ones after it are copied by another pass with the room they
+   were found to need.  Members the workers cannot copy are copied by
+   this process.  Return FALSE if nothing was done, for example because
+   there is only one member.  */
+
+static bool
+copy_archive_in_workers (bfd *ibfd, bfd ***ptr, const char *output_target,
+			 bool force_output_target,
+			 const bfd_arch_info_type *input_arch)
+{
+  struct archive_copy ac;
+  size_t count, i;
+
+  count = bfd_archive_member_count (ibfd);
+  if (count == (size_t) -1 || count < 2)
+    return false;
+
+  ac.ibfd = ibfd;
+  ac.output_target = output_target;
+  ac.force_output_target = force_output_target;
+  ac.input_arch = input_arch;
+  ac.room = (uint64_t *) xmalloc (count * sizeof (*ac.room));
+  for (i = 0; i < count; i++)
+    ac.room[i] = copied_member_room (ibfd, i);
+  ac.ptr = *ptr;
+
+  /* Go on while each pass adds members or finds how much room one
+     needs.  */
+  ac.first = 0;
+  while (!status && ac.first < count)
+    {
+      copy_archive_pass (&ac, count);
+      if (ac.done == ac.first && !ac.grew)
+	break;
+      ac.first = ac.done;
+    }
+  free (ac.room);
+
+  if (!status && ac.first < count)
+    bfd_map_over_archive_members (ibfd, ac.first, count,
+				  add_member_copy, &ac);
+
+  *ptr = ac.ptr;
+  return true;
+}
+
+#endif /* HAVE_MMAP && MAP_ANONYMOUS */
+
+/* Read each archive element in turn from IBFD, copy it to a new BFD
+   in memory, and add that to the output archive OBFD.  With --parallel
+   the elements are copied by worker processes.  If
+   'force_output_target' is TRUE then make sure that all elements in
+   the new archive are of the type 'output_target'.  */
 
 static void
 copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
 	      bool force_output_target,
 	      const bfd_arch_info_type *input_arch)
 {
-  struct name_list
-    {
-      struct name_list *next;
-      const char *name;
-      bfd *obfd;
-    } *list, *l;
   bfd **ptr = &obfd->archive_head;
   bfd *this_element;
-  char *dir = NULL;
+  bfd *output_element;
+  bfd *next;
+  bool copied = false;
   char *filename;
 
-  list = NULL;
-
   /* PR 24281: It is not clear what should happen when copying a thin archive.
      One part is straight forward - if the output archive is in a different
      directory from the input archive then any relative paths in the library
@@ -3641,12 +4132,6 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
       goto cleanup_and_exit;
     }
 
-  /* Make a temp directory to hold the contents.  */
-  dir = make_tempdir (bfd_get_filename (obfd));
-  if (dir == NULL)
-    fatal (_("cannot create tempdir for archive copying (error: %s)"),
-	   strerror (errno));
-
   if (strip_symbols == STRIP_ALL)
     obfd->has_armap = false;
   else
@@ -3656,8 +4141,6 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
   if (deterministic)
     obfd->flags |= BFD_DETERMINISTIC_OUTPUT;
 
-  this_element = bfd_openr_next_archived_file (ibfd, NULL);
-
   if (!bfd_set_format (obfd, bfd_get_format (ibfd)))
     {
       status = 1;
@@ -3665,139 +4148,39 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
       goto cleanup_and_exit;
     }
 
-  while (!status && this_element != NULL)
-    {
-      char *output_name;
-      bfd *output_element;
-      struct stat buf;
-      int stat_status = 0;
-      bool del = true;
-      bool ok_object;
-
-      /* PR binutils/17533: Do not allow directory traversal
-	 outside of the current directory tree by archive members.  */
-      if (! is_valid_archive_path (bfd_get_filename (this_element)))
-	{
-	  non_fatal (_("illegal pathname found in archive member: %s"),
-		     bfd_get_filename (this_element));
-	  bfd_close (this_element);
-	  status = 1;
-	  goto cleanup_and_exit;
-	}
-
-      /* Create an output file for this member.  */
-      output_name = concat (dir, "/",
-			    bfd_get_filename (this_element), (char *) 0);
-
-      /* If the file already exists, make another temp dir.  */
-      if (stat (output_name, &buf) >= 0)
-	{
-	  char * tmpdir = make_tempdir (output_name);
-
-	  free (output_name);
-	  if (tmpdir == NULL)
-	    {
-	      non_fatal (_("cannot create tempdir for archive copying (error: %s)"),
-			 strerror (errno));
-	      bfd_close (this_element);
-	      status = 1;
-	      goto cleanup_and_exit;
-	    }
-
-	  l = (struct name_list *) xmalloc (sizeof (struct name_list));
-	  l->name = tmpdir;
-	  l->next = list;
-	  l->obfd = NULL;
-	  list = l;
-	  output_name = concat (tmpdir, "/",
-				bfd_get_filename (this_element), (char *) 0);
-	}
-
-      if (preserve_dates)
-	{
-	  memset (&buf, 0, sizeof (buf));
-	  stat_status = bfd_stat_arch_elt (this_element, &buf);
-
-	  if (stat_status != 0)
-	    non_fatal (_("internal stat error on %s"),
-		       bfd_get_filename (this_element));
-	}
+#if defined (HAVE_MMAP) && defined (MAP_ANONYMOUS)
+  if (parallel_workers > 1
+      && !status
+      && archive_members_independent ())
+    copied = copy_archive_in_workers (ibfd, &ptr, output_target,
+				      force_output_target, input_arch);
+#endif
 
-      l = (struct name_list *) xmalloc (sizeof (struct name_list));
-      l->name = output_name;
-      l->next = list;
-      l->obfd = NULL;
-      list = l;
-
-      ok_object = bfd_check_format (this_element, bfd_object);
-      if (!ok_object)
-	bfd_nonfatal_message (NULL, this_element, NULL,
-			      _("Unable to recognise the format of file"));
-
-      /* PR binutils/3110: Cope with archives
-	 containing multiple target types.  */
-      if (force_output_target || !ok_object)
-	output_element = bfd_openw (output_name, output_target);
-      else
-	output_element = bfd_openw (output_name, bfd_get_target (this_element));
+  this_element = NULL;
+  if (!copied)
+    this_element = bfd_openr_next_archived_file (ibfd, NULL);
 
+  while (!status && this_element != NULL)
+    {
+      output_element = copy_archive_member (this_element, output_target,
+					    force_output_target, input_arch);
       if (output_element == NULL)
 	{
-	  bfd_nonfatal_message (output_name, NULL, NULL, NULL);
 	  bfd_close (this_element);
-	  status = 1;
-	  goto cleanup_and_exit;
-	}
-
-      if (ok_object)
-	{
-	  del = !copy_object (this_element, output_element, input_arch);
-
-	  if (del && bfd_get_arch (this_element) == bfd_arch_unknown)
-	    /* Try again as an unknown object file.  */
-	    ok_object = false;
-	}
-
-      if (!ok_object)
-	del = !copy_unknown_object (this_element, output_element);
-
-      if (!(ok_object && !del && !status
-	    ? bfd_close : bfd_close_all_done) (output_element))
-	{
-	  bfd_nonfatal_message (output_name, NULL, NULL, NULL);
-	  /* Error in new object file. Don't change archive.  */
-	  status = 1;
-	}
-
-      if (del)
-	{
-	  unlink (output_name);
-	  status = 1;
+	  break;
 	}
 
-      if (status)
-	bfd_close (this_element);
-      else
-	{
-	  if (preserve_dates && stat_status == 0)
-	    set_times (output_name, &buf);
+      *ptr = output_element;
+      ptr = &output_element->archive_next;
 
-	  /* Open the newly created output file and attach to our list.  */
-	  output_element = bfd_openr (output_name, output_target);
-
-	  l->obfd = output_element;
-
-	  *ptr = output_element;
-	  ptr = &output_element->archive_next;
-
-	  bfd *last_element = this_element;
-	  this_element = bfd_openr_next_archived_file (ibfd, last_element);
-	  bfd_close (last_element);
-	}
+      bfd *last_element = this_element;
+      this_element = bfd_openr_next_archived_file (ibfd, last_element);
+      bfd_close (last_element);
     }
   *ptr = NULL;
 
  cleanup_and_exit:
+  output_element = obfd->archive_head;
   filename = xstrdup (bfd_get_filename (obfd));
   if (!(status == 0 ? bfd_close : bfd_close_all_done) (obfd))
     {
@@ -3816,26 +4199,11 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
     }
   free (filename);
 
-  /* Delete all the files that we opened.  */
-  struct name_list *next;
-  for (l = list; l != NULL; l = next)
-    {
-      if (l->obfd == NULL)
-	rmdir (l->name);
-      else
-	{
-	  bfd_close (l->obfd);
-	  unlink (l->name);
-	}
-      free ((char *) l->name);
-      next = l->next;
-      free (l);
-    }
-
-  if (dir)
+  /* Free the copies of the elements.  */
+  for (; output_element != NULL; output_element = next)
     {
-      rmdir (dir);
-      free (dir);
+      next = output_element->archive_next;
+      bfd_close (output_element);
     }
 }
 
@@ -4476,6 +4844,45 @@ copy_relocations_in_section (bfd *ibfd, sec_ptr isection, void *obfdarg)
     }
 }
 
+/* Copy the contents of ISECTION of IBFD, which are SIZE bytes, to
+   OSECTION of OBFD straight from a view of them, which for a large
+   section is mapped from the file rather than read into a buffer.
+   Return false, leaving the copy to the caller, if the contents are
+   to be changed on the way or can't be viewed.  */
+
+static bool
+copy_section_from_view (bfd *ibfd, sec_ptr isection, bfd *obfd,
+			sec_ptr osection, bfd_size_type size)
+{
+  const bfd_byte *view;
+  bfd_size_type viewsize;
+
+  /* bfd_convert_section_contents changes the contents only when
+     copying between ELF classes.  */
+  if (reverse_bytes
+      || copy_byte >= 0
+      || (bfd_get_flavour (ibfd) == bfd_target_elf_flavour
+	  && bfd_get_flavour (obfd) == bfd_target_elf_flavour
+	  && bfd_get_arch_size (ibfd) != bfd_get_arch_size (obfd)))
+    return false;
+
+  if (!bfd_get_section_view (ibfd, isection, &view, &viewsize))
+    return false;
+  if (view == NULL || viewsize != size)
+    {
+      bfd_release_section_view (ibfd, view);
+      return false;
+    }
+
+  if (!bfd_set_section_contents (obfd, osection, view, 0, size))
+    {
+      status = 1;
+      bfd_nonfatal_message (NULL, obfd, osection, NULL);
+    }
+  bfd_release_section_view (ibfd, view);
+  return true;
+}
+
 /* Copy the data of input section ISECTION of IBFD
    to an output section with the same name in OBFD.  */
 
@@ -4502,6 +4909,9 @@ copy_section (bfd *ibfd, sec_ptr isection, void *obfdarg)
     {
       bfd_byte *memhunk = NULL;
 
+      if (copy_section_from_view (ibfd, isection, obfd, osection, size))
+	return;
+
       if (!bfd_get_full_section_contents (ibfd, isection, &memhunk)
 	  || !bfd_convert_section_contents (ibfd, isection, obfd,
 					    &memhunk, &size))
@@ -4821,6 +5231,10 @@ strip_main (int argc, char *argv[])
 	case OPTION_STRIP_SECTION_HEADERS:
 	  strip_section_headers = true;
 	  break;
+	case OPTION_PARALLEL:
+	  if (!set_parallel_workers (optarg))
+	    fatal (_("invalid number of processes: %s"), optarg);
+	  break;
 	case 's':
 	  strip_symbols = STRIP_ALL;
 	  break;
@@ -5215,7 +5629,6 @@ copy_main (int argc, char *argv[])
   char *input_target = NULL;
   char *output_target = NULL;
   bool show_version = false;
-  bool change_warn = true;
   bool formats_info = false;
   bool use_globalize = false;
   bool use_keep_global = false;
@@ -5294,6 +5707,11 @@ copy_main (int argc, char *argv[])
 	  strip_section_headers = true;
 	  break;
 
+	case OPTION_PARALLEL:
+	  if (!set_parallel_workers (optarg))
+	    fatal (_("invalid number of processes: %s"), optarg);
+	  break;
+
 	case 'S':
 	  strip_symbols = STRIP_ALL;
 	  break;
@@ -6140,6 +6558,7 @@ main (int argc, char *argv[])
   if (bfd_init () != BFD_INIT_MAGIC)
     fatal (_("fatal error: libbfd ABI mismatch"));
   set_default_bfd_target ();
+  bfd_set_compression_threads (0);
 
   if (is_strip < 0)
     {
@@ -414,6 +414,10 @@ usage (FILE *stream, int status)
       --dwarf-start=N            Display DIEs starting at offset N\n"));
       fprintf (stream, _("\
       --dwarf-check              Make additional dwarf consistency checks.\n"));
+      fprintf (stream, _("\
+      --parallel[=N]             Use N processes (default: all CPUs) to disassemble\n\
+                                  and to display .debug_info and decoded\n\
+                                  .debug_line sections and archive members\n"));
 #ifdef ENABLE_LIBCTF
       fprintf (stream, _("\
       --ctf-parent=NAME          Use CTF archive member NAME as the CTF parent\n"));
@@ -475,6 +479,7 @@ enum option_values
     OPTION_DWARF_DEPTH,
     OPTION_DWARF_CHECK,
     OPTION_DWARF_START,
+    OPTION_PARALLEL,
     OPTION_RECURSE_LIMIT,
     OPTION_NO_RECURSE_LIMIT,
     OPTION_INLINES,
@@ -527,6 +532,7 @@ static struct option long_options[]=
   {"no-recurse-limit", no_argument, NULL, OPTION_NO_RECURSE_LIMIT},
   {"no-recursion-limit", no_argument, NULL, OPTION_NO_RECURSE_LIMIT},
   {"no-show-raw-insn", no_argument, &show_raw_insn, -1},
+  {"parallel", optional_argument, NULL, OPTION_PARALLEL},
   {"prefix", required_argument, NULL, OPTION_PREFIX},
   {"prefix-addresses", no_argument, &prefix_addresses, 1},
   {"prefix-strip", required_argument, NULL, OPTION_PREFIX_STRIP},
@@ -1366,22 +1372,48 @@ sym_ok (bool want_section,
   return inf->symbol_is_valid (sorted_syms[place], inf);
 }
 
-/* Locate a symbol given a bfd and a section (from INFO->application_data),
-   and a VMA.  If INFO->application_data->require_sec is TRUE, then always
-   require the symbol to be in the section.  Returns NULL if there is no
-   suitable symbol.  If PLACE is not NULL, then *PLACE is set to the index
-   of the symbol in sorted_syms.  */
+/* The last two symbols found by find_symbol_for_address, each of which
+   is the one for any address in SEC from LOW up to but not including
+   the value of sorted_syms[NEXT], if NEXT is not past the end, given
+   the same WANT_SECTION.  For many processors, only one memory operand
+   can be present at a time, so the cache isn't constantly churned by
+   code doing heavy memory accesses.  Entries are dropped by
+   forget_found_symbols when sorted_syms changes.  */
 
-static asymbol *
-find_symbol_for_address (bfd_vma vma,
-			 struct disassemble_info *inf,
-			 long *place)
+struct found_symbol
+{
+  asection *sec;
+  bool want_section;
+  bool preferred;	/* Whether the symbol was picked for being in SEC
+			   among those with the closest value.  */
+  bfd_vma low;
+  long next;
+  long place;		/* The symbol in sorted_syms, or -1 if none.  */
+};
+
+static struct found_symbol found_symbols[2];
+static unsigned int last_found_symbol;
+
+static void
+forget_found_symbols (void)
 {
-  /* @@ Would it speed things up to cache the last two symbols returned,
-     and maybe their address ranges?  For many processors, only one memory
-     operand can be present at a time, so the 2-entry cache wouldn't be
-     constantly churned by code doing heavy memory accesses.  */
+  found_symbols[0].sec = NULL;
+  found_symbols[1].sec = NULL;
+}
+
+/* Search sorted_syms for the symbol for VMA, for find_symbol_for_address.
+   Returns its index, or -1 if there is no suitable symbol.  Sets
+   *PREFERRED if it was picked for being in the section of INF among
+   the symbols with the closest value, and *GROUP to the first of
+   those symbols.  */
 
+static long
+find_symbol_place (bfd_vma vma,
+		   struct disassemble_info *inf,
+		   bool want_section,
+		   bool *preferred,
+		   long *group)
+{
   /* Indices in `sorted_syms'.  */
   long min = 0;
   long max_count = sorted_symcount;
@@ -1389,17 +1421,11 @@ find_symbol_for_address (bfd_vma vma,
   struct objdump_disasm_info *aux;
   bfd *abfd;
   asection *sec;
-  unsigned int opb;
-  bool want_section;
-  long rel_count;
-
-  if (sorted_symcount < 1)
-    return NULL;
 
   aux = (struct objdump_disasm_info *) inf->application_data;
   abfd = aux->abfd;
   sec = inf->section;
-  opb = inf->octets_per_byte;
+  *preferred = false;
 
   /* Perform a binary search looking for the closest symbol to the
      required value.  We are searching the range (min, max_count].  */
@@ -1429,6 +1455,7 @@ find_symbol_for_address (bfd_vma vma,
 	 && (bfd_asymbol_value (sorted_syms[thisplace])
 	     == bfd_asymbol_value (sorted_syms[thisplace - 1])))
     --thisplace;
+  *group = thisplace;
 
   /* Prefer a symbol in the current section if we have multple symbols
      with the same value, as can occur with overlays or zero size
@@ -1440,12 +1467,8 @@ find_symbol_for_address (bfd_vma vma,
     {
       if (sym_ok (true, abfd, min, sec, inf))
 	{
-	  thisplace = min;
-
-	  if (place != NULL)
-	    *place = thisplace;
-
-	  return sorted_syms[thisplace];
+	  *preferred = true;
+	  return min;
 	}
       ++min;
     }
@@ -1460,12 +1483,6 @@ find_symbol_for_address (bfd_vma vma,
      table.
 
      Also give the target a chance to reject symbols.  */
-  want_section = (aux->require_sec
-		  || ((abfd->flags & HAS_RELOC) != 0
-		      && vma >= bfd_section_vma (sec)
-		      && vma < (bfd_section_vma (sec)
-				+ bfd_section_size (sec) / opb)));
-
   if (! sym_ok (want_section, abfd, thisplace, sec, inf))
     {
       long i;
@@ -1506,7 +1523,99 @@ find_symbol_for_address (bfd_vma vma,
 
       if (! sym_ok (want_section, abfd, thisplace, sec, inf))
 	/* There is no suitable symbol.  */
-	return NULL;
+	return -1;
+    }
+
+  return thisplace;
+}
+
+/* Locate a symbol given a bfd and a section (from INFO->application_data),
+   and a VMA.  If INFO->application_data->require_sec is TRUE, then always
+   require the symbol to be in the section.  Returns NULL if there is no
+   suitable symbol.  If PLACE is not NULL, then *PLACE is set to the index
+   of the symbol in sorted_syms.  */
+
+static asymbol *
+find_symbol_for_address (bfd_vma vma,
+			 struct disassemble_info *inf,
+			 long *place)
+{
+  long thisplace;
+  struct objdump_disasm_info *aux;
+  bfd *abfd;
+  asection *sec;
+  unsigned int opb;
+  bool want_section;
+  bool preferred;
+  long rel_count;
+  struct found_symbol *found;
+
+  if (sorted_symcount < 1)
+    return NULL;
+
+  aux = (struct objdump_disasm_info *) inf->application_data;
+  abfd = aux->abfd;
+  sec = inf->section;
+  opb = inf->octets_per_byte;
+
+  want_section = (aux->require_sec
+		  || ((abfd->flags & HAS_RELOC) != 0
+		      && vma >= bfd_section_vma (sec)
+		      && vma < (bfd_section_vma (sec)
+				+ bfd_section_size (sec) / opb)));
+
+  found = &found_symbols[last_found_symbol];
+  if (found->sec != sec
+      || found->want_section != want_section
+      || vma < found->low
+      || (found->next < sorted_symcount
+	  && vma >= bfd_asymbol_value (sorted_syms[found->next])))
+    found = &found_symbols[last_found_symbol ^ 1];
+
+  if (found->sec == sec
+      && found->want_section == want_section
+      && vma >= found->low
+      && (found->next >= sorted_symcount
+	  || vma < bfd_asymbol_value (sorted_syms[found->next])))
+    {
+      thisplace = found->place;
+      preferred = found->preferred;
+    }
+  else
+    {
+      long group;
+
+      thisplace = find_symbol_place (vma, inf, want_section, &preferred,
+				     &group);
+
+      /* The same symbol will be found for any other address up to the
+	 next symbol value, unless VMA was below the first.  */
+      if (vma >= bfd_asymbol_value (sorted_syms[group]))
+	{
+	  last_found_symbol ^= 1;
+	  found = &found_symbols[last_found_symbol];
+	  found->sec = sec;
+	  found->want_section = want_section;
+	  found->preferred = preferred;
+	  found->low = bfd_asymbol_value (sorted_syms[group]);
+	  found->next = group + 1;
+	  while (found->next < sorted_symcount
+		 && (bfd_asymbol_value (sorted_syms[found->next])
+		     == found->low))
+	    found->next++;
+	  found->place = thisplace;
+	}
+    }
+
+  if (thisplace < 0)
+    return NULL;
+
+  if (preferred)
+    {
+      if (place != NULL)
+	*place = thisplace;
+
+      return sorted_syms[thisplace];
     }
 
   /* If we have not found an exact match for the specified address
@@ -3672,6 +3781,205 @@ disassemble_bytes (struct disassemble_info *inf,
   free (color_buffer);
 }
 
+/* Whether the disassembler for INF shows each instruction the same way
+   whatever came before it, so that a section can be disassembled in
+   pieces.  Many do not: ARM, AArch64, RISC-V, C-SKY and NDS32 track the
+   mapping symbols and IT blocks they have passed, and IA-64, KVX and
+   TI C6X decode bundles or packets.  Only list those known to be
+   safe.  */
+
+static bool
+disassembler_is_stateless (struct disassemble_info *inf)
+{
+  switch (inf->arch)
+    {
+    case bfd_arch_i386:
+      return true;
+    default:
+      return false;
+    }
+}
+
+/* A stretch of a section that disassemble_section shows in one go,
+   usually from one symbol to the next.  */
+
+struct disasm_chunk
+{
+  bfd_vma addr;			/* Its address, sign extended if need be.  */
+  bfd_vma start_offset;		/* Where it starts in the section.  */
+  bfd_vma stop_offset;		/* Where it stops in the section.  */
+  asymbol *sym;			/* The symbol it is shown under, or NULL.  */
+  long place;			/* The index of SYM in sorted_syms.  */
+  long end_place;		/* The end of the other symbols at ADDR which
+				   are shown too, after PLACE.  */
+  long symtab_pos;		/* The symbols at ADDR for the disassembler,
+				   or -1 if there are none.  */
+  long num_symbols;
+  asymbol *jump_sym;		/* The symbol for --visualize-jumps.  */
+  bool insns;			/* Whether to disassemble it, or just dump
+				   the bytes.  */
+  bool skip_relocs;		/* Whether to skip over the relocs below
+				   RELOC_OFFSET first.  */
+  bfd_vma reloc_offset;
+};
+
+/* The chunks of a section that disassemble_chunks shows.  */
+
+struct disasm_section
+{
+  bfd *abfd;
+  asection *section;
+  struct disassemble_info *pinfo;
+  bfd_byte *data;
+  struct disasm_chunk *chunks;
+  size_t count;
+  bfd_vma rel_offset;
+  arelent **rel_pp;		/* The first reloc of the first chunk.  */
+  arelent **rel_ppend;
+};
+
+/* Show chunks FIRST up to but not including END of DS.  *RELPPP is the
+   next reloc to show, and is updated.  */
+
+static void
+disassemble_chunks (struct disasm_section *ds, size_t first, size_t end,
+		    arelent ***relppp)
+{
+  struct disassemble_info *pinfo = ds->pinfo;
+  struct objdump_disasm_info *paux
+    = (struct objdump_disasm_info *) pinfo->application_data;
+  size_t i;
+
+  for (i = first; i < end; i++)
+    {
+      struct disasm_chunk *chunk = &ds->chunks[i];
+      asymbol *sym = chunk->sym;
+      long place;
+
+      if (chunk->symtab_pos >= 0)
+	{
+	  pinfo->symbols = sorted_syms + chunk->symtab_pos;
+	  pinfo->num_symbols = chunk->num_symbols;
+	  pinfo->symtab_pos = chunk->symtab_pos;
+	}
+      else
+	{
+	  pinfo->symbols = NULL;
+	  pinfo->num_symbols = 0;
+	  pinfo->symtab_pos = -1;
+	}
+
+      if (chunk->skip_relocs)
+	while (*relppp < ds->rel_ppend
+	       && (**relppp)->address - ds->rel_offset < chunk->reloc_offset)
+	  ++*relppp;
+
+      if (! prefix_addresses)
+	{
+	  pinfo->fprintf_func (pinfo->stream, "\n");
+	  objdump_print_addr_with_sym (ds->abfd, ds->section, sym,
+				       chunk->addr, pinfo, false);
+	  pinfo->fprintf_func (pinfo->stream, ":\n");
+
+	  for (place = chunk->place + 1; place < chunk->end_place; place++)
+	    if (pinfo->symbol_is_valid (sorted_syms[place], pinfo))
+	      {
+		objdump_print_addr_with_sym (ds->abfd, ds->section,
+					     sorted_syms[place], chunk->addr,
+					     pinfo, false);
+		pinfo->fprintf_func (pinfo->stream, ":\n");
+	      }
+	}
+
+      /* Resolve symbol name.  */
+      sym = chunk->jump_sym;
+      if (visualize_jumps && ds->abfd && sym && sym->name)
+	{
+	  struct disassemble_info di;
+	  SFILE sf;
+
+	  sf.alloc = strlen (sym->name) + 40;
+	  sf.buffer = (char*) xmalloc (sf.alloc);
+	  sf.pos = 0;
+	  disassemble_set_printf
+	    (&di, &sf, (fprintf_ftype) objdump_sprintf,
+	     (fprintf_styled_ftype) objdump_styled_sprintf);
+
+	  objdump_print_symname (ds->abfd, &di, sym);
+
+	  /* Fetch jump information.  */
+	  detected_jumps = disassemble_jumps
+	    (pinfo, paux->disassemble_fn,
+	     chunk->start_offset, chunk->stop_offset,
+	     ds->rel_offset, relppp, ds->rel_ppend);
+
+	  /* Free symbol name.  */
+	  free (sf.buffer);
+	}
+
+      /* Add jumps to output.  */
+      disassemble_bytes (pinfo, paux->disassemble_fn, chunk->insns, ds->data,
+			 chunk->start_offset, chunk->stop_offset,
+			 ds->rel_offset, relppp, ds->rel_ppend);
+
+      /* Free jumps.  */
+      while (detected_jumps)
+	{
+	  detected_jumps = jump_info_free (detected_jumps);
+	}
+    }
+}
+
+/* Return the reloc a single process would be at when it reached
+   chunk CHUNK of DS, unless the last instruction before CHUNK ran on
+   into it.  */
+
+static arelent **
+disasm_chunk_relocs (struct disasm_section *ds, size_t chunk)
+{
+  arelent **rel_pp = ds->rel_pp;
+
+  while (rel_pp < ds->rel_ppend
+	 && ((*rel_pp)->address
+	     < ds->rel_offset + ds->chunks[chunk].start_offset))
+    ++rel_pp;
+  return rel_pp;
+}
+
+static uint64_t
+disasm_chunk_weight (size_t chunk, void *data)
+{
+  struct disasm_section *ds = (struct disasm_section *) data;
+
+  return ds->chunks[chunk].stop_offset - ds->chunks[chunk].start_offset;
+}
+
+/* Show chunks FIRST up to END of the section in DATA in a worker
+   process for disassemble_section.  */
+
+static int
+disassemble_chunks_in_worker (size_t first, size_t end, void *data)
+{
+  struct disasm_section *ds = (struct disasm_section *) data;
+  arelent **rel_pp = disasm_chunk_relocs (ds, first);
+  int res = 0;
+
+  disassemble_chunks (ds, first, end, &rel_pp);
+
+  /* If the last instruction ran on into the next chunk, the next worker
+     will not start from the right reloc.  Carry on here to the end of
+     the section instead, and stop the others.  */
+  if (end < ds->count && rel_pp != disasm_chunk_relocs (ds, end))
+    {
+      disassemble_chunks (ds, end, ds->count, &rel_pp);
+      res = 1;
+    }
+
+  if (exit_status != 0)
+    res |= WORKER_ERROR;
+  return res;
+}
+
 static void
 disassemble_section (bfd *abfd, asection *section, void *inf)
 {
@@ -3680,8 +3988,9 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   struct disassemble_info *pinfo = (struct disassemble_info *) inf;
   struct objdump_disasm_info *paux;
   unsigned int opb = pinfo->octets_per_byte;
-  bfd_byte *data = NULL;
+  const bfd_byte *data;
   bfd_size_type datasize = 0;
+  bfd_size_type viewsize;
   arelent **rel_pp = NULL;
   arelent **rel_ppstart = NULL;
   arelent **rel_ppend;
@@ -3689,6 +3998,9 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   asymbol *sym = NULL;
   long place = 0;
   long rel_count;
+  struct disasm_section ds;
+  size_t max_chunks;
+  int res;
   bfd_vma rel_offset;
   unsigned long addr_offset;
   bool do_print;
@@ -3784,14 +4096,14 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
     }
   rel_ppend = PTR_ADD (rel_pp, rel_count);
 
-  if (!bfd_malloc_and_get_section (abfd, section, &data))
+  if (!bfd_get_section_view (abfd, section, &data, &viewsize))
     {
       non_fatal (_("Reading section %s failed because: %s"),
 		 section->name, bfd_errmsg (bfd_get_error ()));
       return;
     }
 
-  pinfo->buffer = data;
+  pinfo->buffer = (bfd_byte *) data;
   pinfo->buffer_vma = section->vma;
   pinfo->buffer_length = datasize;
   pinfo->section = section;
@@ -3800,6 +4112,7 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   compare_section = section;
   if (sorted_symcount > 1)
     qsort (sorted_syms, sorted_symcount, sizeof (asymbol *), compare_symbols);
+  forget_found_symbols ();
 
   /* Skip over the relocs belonging to addresses below the
      start address.  */
@@ -3824,23 +4137,42 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       && bed->sign_extend_vma)
     sign_adjust = (bfd_vma) 1 << (bed->s->arch_size - 1);
 
-  /* Disassemble a block of instructions up to the address associated with
-     the symbol we have just found.  Then print the symbol and find the
-     next symbol on.  Repeat until we have disassembled the entire section
-     or we have reached the end of the address range we are interested in.  */
+  /* Split the section into chunks, from the address associated with
+     the symbol we have just found up to the next symbol, and so on
+     until we have covered the entire section or reached the end of
+     the address range we are interested in.  */
+  ds.abfd = abfd;
+  ds.section = section;
+  ds.pinfo = pinfo;
+  ds.data = (bfd_byte *) data;
+  ds.rel_offset = rel_offset;
+  ds.rel_pp = rel_pp;
+  ds.rel_ppend = rel_ppend;
+  ds.count = 0;
+  max_chunks = 64;
+  ds.chunks = (struct disasm_chunk *) xmalloc (max_chunks
+					       * sizeof (*ds.chunks));
   do_print = paux->symbol == NULL;
   loop_until = stop_offset_reached;
 
   while (addr_offset < stop_offset)
     {
+      struct disasm_chunk chunk;
       bfd_vma addr;
       asymbol *nextsym;
       bfd_vma nextstop_offset;
-      bool insns;
 
       addr = section->vma + addr_offset;
       addr = ((addr & ((sign_adjust << 1) - 1)) ^ sign_adjust) - sign_adjust;
 
+      chunk.addr = addr;
+      chunk.start_offset = addr_offset;
+      chunk.sym = sym;
+      chunk.place = place;
+      chunk.end_place = place;
+      chunk.skip_relocs = false;
+      chunk.reloc_offset = 0;
+
       if (sym != NULL && bfd_asymbol_value (sym) <= addr)
 	{
 	  int x;
@@ -3851,15 +4183,13 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 	       ++x)
 	    continue;
 
-	  pinfo->symbols = sorted_syms + place;
-	  pinfo->num_symbols = x - place;
-	  pinfo->symtab_pos = place;
+	  chunk.symtab_pos = place;
+	  chunk.num_symbols = x - place;
 	}
       else
 	{
-	  pinfo->symbols = NULL;
-	  pinfo->num_symbols = 0;
-	  pinfo->symtab_pos = -1;
+	  chunk.symtab_pos = -1;
+	  chunk.num_symbols = 0;
 	}
 
       /* If we are only disassembling from a specific symbol,
@@ -3910,10 +4240,8 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 
 		  /* Skip over the relocs belonging to addresses below the
 		     symbol address.  */
-		  const bfd_vma sym_offset = bfd_asymbol_value (sym) - section->vma;
-		  while (rel_pp < rel_ppend &&
-		   (*rel_pp)->address - rel_offset < sym_offset)
-			  ++rel_pp;
+		  chunk.skip_relocs = true;
+		  chunk.reloc_offset = bfd_asymbol_value (sym) - section->vma;
 
 		  if (sym->flags & BSF_FUNCTION)
 		    {
@@ -3945,30 +4273,22 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 	    }
 	}
 
-      if (! prefix_addresses && do_print)
+      /* Find the other symbols at this address that are shown with
+	 --show-all-symbols.  */
+      if (! prefix_addresses && do_print && sym != NULL && show_all_symbols)
 	{
-	  pinfo->fprintf_func (pinfo->stream, "\n");
-	  objdump_print_addr_with_sym (abfd, section, sym, addr,
-				       pinfo, false);
-	  pinfo->fprintf_func (pinfo->stream, ":\n");
-
-	  if (sym != NULL && show_all_symbols)
+	  for (++place; place < sorted_symcount; place++)
 	    {
-	      for (++place; place < sorted_symcount; place++)
-		{
-		  sym = sorted_syms[place];
-		  
-		  if (bfd_asymbol_value (sym) != addr)
-		    break;
-		  if (! pinfo->symbol_is_valid (sym, pinfo))
-		    continue;
-		  if (strcmp (bfd_section_name (sym->section), bfd_section_name (section)) != 0)
-		    break;
-
-		  objdump_print_addr_with_sym (abfd, section, sym, addr, pinfo, false);
-		  pinfo->fprintf_func (pinfo->stream, ":\n");
-		}
-	    }	   
+	      sym = sorted_syms[place];
+
+	      if (bfd_asymbol_value (sym) != addr)
+		break;
+	      if (! pinfo->symbol_is_valid (sym, pinfo))
+		continue;
+	      if (strcmp (bfd_section_name (sym->section), bfd_section_name (section)) != 0)
+		break;
+	    }
+	  chunk.end_place = place;
 	}
 
       if (sym != NULL && bfd_asymbol_value (sym) > addr)
@@ -4020,54 +4340,44 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 	      && (strstr (bfd_asymbol_name (sym), "gcc2_compiled")
 		  == NULL))
 	  || (sym->flags & BSF_FUNCTION) != 0)
-	insns = true;
+	chunk.insns = true;
       else
-	insns = false;
+	chunk.insns = false;
 
       if (do_print)
 	{
-	  /* Resolve symbol name.  */
-	  if (visualize_jumps && abfd && sym && sym->name)
+	  chunk.stop_offset = nextstop_offset;
+	  chunk.jump_sym = sym;
+	  if (ds.count == max_chunks)
 	    {
-	      struct disassemble_info di;
-	      SFILE sf;
-
-	      sf.alloc = strlen (sym->name) + 40;
-	      sf.buffer = (char*) xmalloc (sf.alloc);
-	      sf.pos = 0;
-	      disassemble_set_printf
-		(&di, &sf, (fprintf_ftype) objdump_sprintf,
-		 (fprintf_styled_ftype) objdump_styled_sprintf);
-
-	      objdump_print_symname (abfd, &di, sym);
-
-	      /* Fetch jump information.  */
-	      detected_jumps = disassemble_jumps
-		(pinfo, paux->disassemble_fn,
-		 addr_offset, nextstop_offset,
-		 rel_offset, &rel_pp, rel_ppend);
-
-	      /* Free symbol name.  */
-	      free (sf.buffer);
-	    }
-
-	  /* Add jumps to output.  */
-	  disassemble_bytes (pinfo, paux->disassemble_fn, insns, data,
-			     addr_offset, nextstop_offset,
-			     rel_offset, &rel_pp, rel_ppend);
-
-	  /* Free jumps.  */
-	  while (detected_jumps)
-	    {
-	      detected_jumps = jump_info_free (detected_jumps);
+	      max_chunks *= 2;
+	      ds.chunks = (struct disasm_chunk *)
+		xrealloc (ds.chunks, max_chunks * sizeof (*ds.chunks));
 	    }
+	  ds.chunks[ds.count++] = chunk;
 	}
 
       addr_offset = nextstop_offset;
       sym = nextsym;
     }
 
-  free (data);
+  /* Share the chunks out among worker processes if asked to, unless
+     the output of one depends on what was shown before it, as is the
+     case when the source lines that have already been shown are left
+     out, when only some symbols are shown, or when the disassembler
+     carries state from one instruction to the next.  */
+  res = -1;
+  if (paux->symbol == NULL && !with_line_numbers && !with_source_code
+      && disassembler_is_stateless (pinfo))
+    res = run_in_workers (ds.count, disasm_chunk_weight,
+			  disassemble_chunks_in_worker, &ds);
+  if (res < 0)
+    disassemble_chunks (&ds, 0, ds.count, &rel_pp);
+  else if ((res & WORKER_ERROR) != 0)
+    exit_status = 1;
+
+  free (ds.chunks);
+  bfd_release_section_view (abfd, data);
 
   if (rel_ppstart != NULL)
     free (rel_ppstart);
@@ -4105,6 +4415,7 @@ disassemble_data (bfd *abfd)
       sorted_syms[sorted_symcount] = synthsyms + i;
       ++sorted_symcount;
     }
+  forget_found_symbols ();
 
   init_disassemble_info (&disasm_info, stdout, (fprintf_ftype) fprintf,
 			 (fprintf_styled_ftype) fprintf_styled);
@@ -4210,6 +4521,26 @@ disassemble_data (bfd *abfd)
   disassemble_free_target (&disasm_info);
 }
 
+/* For each debug section whose contents are a view from
+   bfd_get_section_view rather than a buffer of our own, the BFD which
+   the view belongs to.  */
+static bfd *debug_section_view_bfd[max];
+
+/* Free the contents of DEBUG.  */
+
+static void
+free_debug_section_contents (enum dwarf_section_display_enum debug)
+{
+  struct dwarf_section *section = &debug_displays [debug].section;
+
+  if (debug_section_view_bfd[debug] != NULL)
+    bfd_release_section_view (debug_section_view_bfd[debug], section->start);
+  else
+    free (section->start);
+  debug_section_view_bfd[debug] = NULL;
+  section->start = NULL;
+}
+
 static bool
 load_specific_debug_section (enum dwarf_section_display_enum debug,
 			     asection *sec, void *file)
@@ -4226,7 +4557,7 @@ load_specific_debug_section (enum dwarf_section_display_enum debug,
       /* If it is already loaded, do nothing.  */
       if (streq (section->filename, bfd_get_filename (abfd)))
 	return true;
-      free (section->start);
+      free_debug_section_contents (debug);
     }
 
   section->filename = bfd_get_filename (abfd);
@@ -4248,13 +4579,13 @@ load_specific_debug_section (enum dwarf_section_display_enum debug,
       return false;
     }
 
-  section->start = contents = xmalloc (alloced);
-  /* Ensure any string section has a terminating NUL.  */
-  section->start[section->size] = 0;
-
   if ((abfd->flags & (EXEC_P | DYNAMIC)) == 0
       && debug_displays [debug].relocate)
     {
+      section->start = contents = xmalloc (alloced);
+      /* Ensure any string section has a terminating NUL.  */
+      section->start[section->size] = 0;
+
       ret = bfd_simple_get_relocated_section_contents (abfd,
 						       sec,
 						       section->start,
@@ -4282,7 +4613,33 @@ load_specific_debug_section (enum dwarf_section_display_enum debug,
 	}
     }
   else
-    ret = bfd_get_full_section_contents (abfd, sec, &contents);
+    {
+      const bfd_byte *view;
+      bfd_size_type viewsize;
+
+      /* Use the section in place if it ends with a NUL, as then any
+	 string in it is terminated.  Otherwise copy it and add one.  */
+      ret = bfd_get_section_view (abfd, sec, &view, &viewsize);
+      if (ret
+	  && view != NULL
+	  && viewsize == section->size
+	  && view[viewsize - 1] == 0)
+	{
+	  section->start = (unsigned char *) view;
+	  debug_section_view_bfd[debug] = abfd;
+	}
+      else if (ret)
+	{
+	  section->start = contents = xmalloc (alloced);
+	  section->start[section->size] = 0;
+	  if (view != NULL)
+	    {
+	      memcpy (contents, view,
+		      viewsize < section->size ? viewsize : section->size);
+	      bfd_release_section_view (abfd, view);
+	    }
+	}
+    }
 
   if (!ret)
     {
@@ -4357,8 +4714,7 @@ free_debug_section (enum dwarf_section_display_enum debug)
 {
   struct dwarf_section *section = &debug_displays [debug].section;
 
-  free ((char *) section->start);
-  section->start = NULL;
+  free_debug_section_contents (debug);
   section->address = 0;
   section->size = 0;
   free ((char*) section->reloc_info);
@@ -4972,8 +5328,9 @@ dump_target_specific (bfd *abfd)
 static void
 dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 {
-  bfd_byte *data = NULL;
+  const bfd_byte *data;
   bfd_size_type datasize;
+  bfd_size_type viewsize;
   bfd_vma addr_offset;
   bfd_vma start_offset;
   bfd_vma stop_offset;
@@ -5024,7 +5381,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	    (unsigned long) (section->filepos + start_offset));
   printf ("\n");
 
-  if (!bfd_get_full_section_contents (abfd, section, &data))
+  if (!bfd_get_section_view (abfd, section, &data, &viewsize))
     {
       non_fatal (_("Reading section %s failed because: %s"),
 		 section->name, bfd_errmsg (bfd_get_error ()));
@@ -5096,7 +5453,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	}
       putchar ('\n');
     }
-  free (data);
+  bfd_release_section_view (abfd, data);
 }
 
 /* Actually display the various requested regions.  */
@@ -5776,6 +6133,53 @@ display_object_bfd (bfd *abfd)
     list_matching_formats (matching);
 }
 
+static void display_any_bfd (bfd *, int);
+
+/* An archive whose members are shared out among worker processes.  */
+
+struct archive_run
+{
+  bfd *archive;
+  int level;		/* The nesting level of the members.  */
+};
+
+static bool
+display_archive_member (bfd *file ATTRIBUTE_UNUSED, bfd *arfile, void *data)
+{
+  display_any_bfd (arfile, *(int *) data);
+  return true;
+}
+
+static uint64_t
+archive_member_weight (size_t i, void *data)
+{
+  return bfd_archive_member_size (((struct archive_run *) data)->archive, i);
+}
+
+/* Display members FIRST up to END of the archive in DATA in a worker
+   process.  */
+
+static int
+display_archive_members (size_t first, size_t end, void *data)
+{
+  struct archive_run *run = (struct archive_run *) data;
+  unsigned int workers = parallel_workers;
+  int res = 0;
+
+  /* Reopen the archive rather than share its file position with the
+     other workers, and don't start more workers for each member.  */
+  bfd_cache_close_all ();
+  parallel_workers = 1;
+  if (!bfd_map_over_archive_members (run->archive, first, end,
+				     display_archive_member, &run->level))
+    {
+      my_bfd_nonfatal (bfd_get_filename (run->archive));
+      res = 1;
+    }
+  parallel_workers = workers;
+  return res + (exit_status != 0 ? WORKER_ERROR : 0);
+}
+
 static void
 display_any_bfd (bfd *file, int level)
 {
@@ -5803,6 +6207,25 @@ display_any_bfd (bfd *file, int level)
 	printf (_("In nested archive %s:\n"),
 		sanitize_string (bfd_get_filename (file)));
 
+      /* With --parallel, share out the members among worker
+	 processes.  */
+      if (parallel_workers > 1)
+	{
+	  struct archive_run run = { file, level + 1 };
+	  size_t count = bfd_archive_member_count (file);
+	  int res = -1;
+
+	  if (count != (size_t) -1)
+	    res = run_in_workers (count, archive_member_weight,
+				  display_archive_members, &run);
+	  if (res >= 0)
+	    {
+	      if ((res & WORKER_ERROR) != 0)
+		exit_status = 1;
+	      return;
+	    }
+	}
+
       for (;;)
 	{
 	  bfd_set_error (bfd_error_no_error);
@@ -5895,6 +6318,7 @@ main (int argc, char **argv)
   if (bfd_init () != BFD_INIT_MAGIC)
     fatal (_("fatal error: libbfd ABI mismatch"));
   set_default_bfd_target ();
+  bfd_set_compression_threads (0);
 
   while ((c = getopt_long (argc, argv,
 			   "CDE:FGHI:LM:P:RSTU:VW::ab:defghij:lm:prstvwxz",
@@ -6171,6 +6595,10 @@ main (int argc, char **argv)
 	case OPTION_DWARF_CHECK:
 	  dwarf_check = true;
 	  break;
+	case OPTION_PARALLEL:
+	  if (!set_parallel_workers (optarg))
+	    fatal (_("invalid number of processes: %s"), optarg);
+	  break;
 #ifdef ENABLE_LIBCTF
 	case OPTION_CTF:
 	  dump_ctf_section_info = true;
@@ -5543,6 +5543,7 @@ enum long_option_values
   OPTION_DWARF_DEPTH,
   OPTION_DWARF_START,
   OPTION_DWARF_CHECK,
+  OPTION_PARALLEL,
   OPTION_CTF_DUMP,
   OPTION_CTF_PARENT,
   OPTION_CTF_SYMBOLS,
@@ -5607,6 +5608,7 @@ static struct option options[] =
   {"dwarf-depth",      required_argument, 0, OPTION_DWARF_DEPTH},
   {"dwarf-start",      required_argument, 0, OPTION_DWARF_START},
   {"dwarf-check",      no_argument, 0, OPTION_DWARF_CHECK},
+  {"parallel",         optional_argument, 0, OPTION_PARALLEL},
 #ifdef ENABLE_LIBCTF
   {"ctf",	       required_argument, 0, OPTION_CTF_DUMP},
   {"ctf-symbols",      required_argument, 0, OPTION_CTF_SYMBOLS},
@@ -5746,6 +5748,9 @@ usage (FILE * stream)
   --dwarf-depth=N        Do not display DIEs at depth N or greater\n"));
   fprintf (stream, _("\
   --dwarf-start=N        Display DIEs starting at offset N\n"));
+  fprintf (stream, _("\
+  --parallel[=N]         Use N processes (default: all CPUs) to display\n\
+                          .debug_info and decoded .debug_line sections\n"));
 #ifdef ENABLE_LIBCTF
   fprintf (stream, _("\
   --ctf=<number|name>    Display CTF info from section <number|name>\n"));
@@ -6017,6 +6022,16 @@ parse_args (struct dump_data *dumpdata, int argc, char ** argv)
 	case OPTION_DWARF_CHECK:
 	  dwarf_check = true;
 	  break;
+	case OPTION_PARALLEL:
+	  if (!set_parallel_workers (optarg))
+	    {
+	      /* The same message as objdump's, which error does not end
+		 with a newline.  */
+	      error (_("invalid number of processes: %s"), optarg);
+	      fputc ('\n', stderr);
+	      usage (stderr);
+	    }
+	  break;
 	case OPTION_CTF_DUMP:
 	  do_ctf = true;
 	  request_dump (dumpdata, CTF_DUMP);
@@ -33,6 +33,7 @@
 #include "libiberty.h"
 #include "getopt.h"
 #include "bucomm.h"
+#include "elfcomm.h"
 
 #ifndef BSD_DEFAULT
 #define BSD_DEFAULT 1
@@ -71,6 +72,9 @@ static bfd_size_type total_bsssize;
 static bfd_size_type total_datasize;
 static bfd_size_type total_textsize;
 
+/* Set once the Berkeley or GNU column headings have been printed.  */
+static int files_seen = 0;
+
 /* Program exit status.  */
 static int return_code = 0;
 
@@ -95,6 +99,8 @@ usage (FILE *stream, int status)
   -f                                  Ignored.\n\
             --common                  Display total size for *COM* syms\n\
             --target=<bfdname>        Set the binary file format\n\
+            --parallel[=N]            Use N processes (default: all CPUs) for\n\
+                                      the members of archives\n\
             @<file>                   Read options from <file>\n\
   -h|-H|-?  --help                    Display this information\n\
   -v|-V     --version                 Display the program's version\n\
@@ -114,11 +120,13 @@ usage (FILE *stream, int status)
 #define OPTION_FORMAT (200)
 #define OPTION_RADIX (OPTION_FORMAT + 1)
 #define OPTION_TARGET (OPTION_RADIX + 1)
+#define OPTION_PARALLEL (OPTION_TARGET + 1)
 
 static struct option long_options[] =
 {
   {"common", no_argument, &show_common, 1},
   {"format", required_argument, 0, OPTION_FORMAT},
+  {"parallel", optional_argument, 0, OPTION_PARALLEL},
   {"radix", required_argument, 0, OPTION_RADIX},
   {"target", required_argument, 0, OPTION_TARGET},
   {"totals", no_argument, &show_totals, 1},
@@ -181,6 +189,11 @@ main (int argc, char **argv)
 	target = optarg;
 	break;
 
+      case OPTION_PARALLEL:
+	if (!set_parallel_workers (optarg))
+	  fatal (_("invalid number of processes: %s"), optarg);
+	break;
+
       case OPTION_RADIX:
 #ifdef ANSI_LIBRARIES
 	temp = strtol (optarg, NULL, 10);
@@ -365,12 +378,101 @@ display_bfd (bfd *abfd)
   return_code = 3;
 }
 
+static bool
+display_archive_member (bfd *file ATTRIBUTE_UNUSED, bfd *arfile,
+			void *data ATTRIBUTE_UNUSED)
+{
+  display_bfd (arfile);
+  return true;
+}
+
+static uint64_t
+archive_member_weight (size_t i, void *data)
+{
+  return bfd_archive_member_size ((bfd *) data, i);
+}
+
+/* Display stats on members FIRST up to END of the archive DATA in a
+   worker process.  */
+
+static int
+display_archive_members (size_t first, size_t end, void *data)
+{
+  bfd *file = (bfd *) data;
+  int saved_return_code = return_code;
+  int res = 0;
+
+  /* Reopen the archive rather than share its file position with the
+     other workers, and leave the column headings to the worker that
+     shows the first member.  */
+  bfd_cache_close_all ();
+  if (first != 0)
+    files_seen = 1;
+  return_code = 0;
+  if (!bfd_map_over_archive_members (file, first, end,
+				     display_archive_member, NULL))
+    {
+      bfd_nonfatal (bfd_get_filename (file));
+      res = 2;
+    }
+  if (return_code != 0)
+    res += WORKER_ERROR;
+  return_code = saved_return_code;
+  return res;
+}
+
+/* Return TRUE if the first member of the archive FILE is an object,
+   so that showing it prints the column headings.  */
+
+static bool
+first_member_is_object (bfd *file)
+{
+  bfd *arfile = bfd_openr_next_archived_file (file, NULL);
+  bool ret;
+
+  if (arfile == NULL)
+    return false;
+  ret = (!bfd_check_format (arfile, bfd_archive)
+	 && bfd_check_format (arfile, bfd_object));
+  bfd_close (arfile);
+  return ret;
+}
+
 static void
 display_archive (bfd *file)
 {
   bfd *arfile = (bfd *) NULL;
   bfd *last_arfile = (bfd *) NULL;
 
+  /* With --parallel, share out the members among worker processes.
+     The totals are added up as the members are shown, so that can
+     only be done here.  The column headings are printed by the worker
+     that shows the first member, so that must be an object if they
+     have not been printed yet.  */
+  if (parallel_workers > 1
+      && !show_totals
+      && (files_seen != 0 || first_member_is_object (file)))
+    {
+      size_t count = bfd_archive_member_count (file);
+      int res = -1;
+
+      if (count != (size_t) -1)
+	res = run_in_workers (count, archive_member_weight,
+			      display_archive_members, file);
+      if (res >= 0)
+	{
+	  /* The worker that showed the first member printed the
+	     column headings, if there were any to print.  */
+	  if (count != 0)
+	    files_seen = 1;
+	  if ((res & ~WORKER_ERROR) != 0)
+	    return_code = res & ~WORKER_ERROR;
+	  else if ((res & WORKER_ERROR) != 0)
+	    return_code = 3;
+	  return;
+	}
+    }
+
   for (;;)
     {
       bfd_set_error (bfd_error_no_error);
@@ -487,7 +589,6 @@ berkeley_or_gnu_sum (bfd *abfd ATTRIBUTE_UNUSED, sec_ptr sec,
 static void
 print_berkeley_or_gnu_format (bfd *abfd)
 {
-  static int files_seen = 0;
   bfd_size_type total;
   int col_width = (selected_output_format == FORMAT_BERKLEY) ? 7 : 10;
   char sep_char = (selected_output_format == FORMAT_BERKLEY) ? '\t' : ' ';
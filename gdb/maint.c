@@ -855,6 +855,9 @@ update_thread_pool_size ()
     n_threads = std::thread::hardware_concurrency ();
 
   gdb::thread_pool::g_thread_pool->set_thread_count (n_threads);
+
+  /* BFD can decompress large zstd sections in parallel too.  */
+  bfd_set_compression_threads (n_threads > 1 ? n_threads : 1);
 #endif
 }
 
@@ -25,6 +25,7 @@
 #include <cerrno>
 #include <cstring>
 #include <climits>
+#include <algorithm>
 #include <vector>
 #include "libiberty.h"
 #include "filenames.h"
@@ -40,6 +41,8 @@
 #include "archive.h"
 #include "plugin.h"
 #include "incremental.h"
+#include "stringpool.h"
+#include "gold-threads.h"
 
 namespace gold
 {
@@ -327,6 +330,65 @@ Archive::read_armap(off_t start, section_size_type size)
   // This array keeps track of which symbols are for archive elements
   // which we have already included in the link.
   this->armap_checked_.resize(nsyms);
+
+  this->build_armap_index();
+}
+
+// Return the hash code of an armap symbol name.  We stop at an '@',
+// so that all versions of a symbol have the same hash code as the
+// unversioned name used in the symbol table.
+
+size_t
+Archive::armap_name_hash(const char* name)
+{
+  const char* ver = strchr(name, '@');
+  size_t len = ver != NULL ? ver - name : strlen(name);
+  return string_hash<char>(name, len);
+}
+
+// Build the index of the archive map by symbol name.
+
+void
+Archive::build_armap_index()
+{
+  const size_t armap_size = this->armap_.size();
+  this->armap_index_.resize(armap_size);
+  for (size_t i = 0; i < armap_size; ++i)
+    {
+      const char* sym_name = (this->armap_names_.data()
+			      + this->armap_[i].name_offset);
+      this->armap_index_[i] = std::make_pair(Archive::armap_name_hash(sym_name),
+					     i);
+    }
+  std::sort(this->armap_index_.begin(), this->armap_index_.end());
+}
+
+// Set DIRTY for each armap entry which may name one of the symbols
+// of OBJ.  Hash codes may collide, so this may set some entries which
+// are unrelated, which is harmless.
+
+bool
+Archive::mark_armap_entries(const Object* obj, std::vector<bool>* dirty) const
+{
+  const Object::Symbols* syms = obj->get_global_symbols();
+  if (syms == NULL)
+    return false;
+  for (Object::Symbols::const_iterator p = syms->begin();
+       p != syms->end();
+       ++p)
+    {
+      if (*p == NULL)
+	continue;
+      const char* name = (*p)->name();
+      std::pair<size_t, size_t> key(string_hash<char>(name, strlen(name)), 0);
+      for (Armap_index::const_iterator q =
+	     std::lower_bound(this->armap_index_.begin(),
+			      this->armap_index_.end(), key);
+	   q != this->armap_index_.end() && q->first == key.first;
+	   ++q)
+	(*dirty)[q->second] = true;
+    }
+  return true;
 }
 
 // Read the header of an archive member at OFF.  Fail if something
@@ -760,6 +822,56 @@ Archive::read_symbols(off_t off)
   this->members_[off] = member;
 }
 
+// The minimum number of armap entries handled by each thread when
+// deciding in parallel which archive members to include.
+
+static const size_t armap_slice_min = 4096;
+
+// Decide whether to include the members named by the armap entries
+// listed in PENDING, storing the results in DECISIONS.  This only
+// looks up symbols, so slices may run at the same time, as long as
+// nothing changes the symbol table.
+
+class Archive::Classify_armap_entries : public Parallel_function
+{
+ public:
+  Classify_armap_entries(Symbol_table* symtab, Layout* layout,
+			 const Archive* archive,
+			 const std::vector<size_t>& pending,
+			 std::vector<Archive::Should_include>* decisions)
+    : symtab_(symtab), layout_(layout), archive_(archive),
+      pending_(pending), decisions_(decisions)
+  { }
+
+  void
+  run(unsigned int, size_t begin, size_t end)
+  {
+    char* tmpbuf = NULL;
+    size_t tmpbuflen = 0;
+    for (size_t j = begin; j < end; ++j)
+      {
+	const Armap_entry& entry(this->archive_->armap_[this->pending_[j]]);
+	const char* sym_name = (this->archive_->armap_names_.data()
+				+ entry.name_offset);
+	Symbol* sym;
+	std::string why;
+	(*this->decisions_)[j] =
+	  Archive::should_include_member(this->symtab_, this->layout_,
+					 sym_name, &sym, &why, &tmpbuf,
+					 &tmpbuflen);
+      }
+    if (tmpbuf != NULL)
+      free(tmpbuf);
+  }
+
+ private:
+  Symbol_table* symtab_;
+  Layout* layout_;
+  const Archive* archive_;
+  const std::vector<size_t>& pending_;
+  std::vector<Archive::Should_include>* decisions_;
+};
+
 // Select members from the archive and add them to the link.  We walk
 // through the elements in the archive map, and look each one up in
 // the symbol table.  If it exists as a strong undefined symbol, we
@@ -790,8 +902,24 @@ Archive::add_symbols(Symbol_table* symtab, Layout* layout,
   // offset we saw that was present in the seen_offsets_ set.
   off_t last_seen_offset = -1;
 
-  // Track which symbols in the symbol table we've already found to be
-  // defined.
+  // The armap entries which we have not yet checked.  Each pass
+  // drops the entries which it checks, so that later passes only
+  // look at the symbols which were still unknown.
+  std::vector<size_t> pending;
+  pending.reserve(armap_size);
+  for (size_t i = 0; i < armap_size; ++i)
+    if (!this->armap_checked_[i])
+      pending.push_back(i);
+
+  // With a large archive map and --threads, each pass starts by
+  // deciding about all the pending entries in parallel, which only
+  // looks things up in the symbol table.  We then walk the entries
+  // in order as before.  Including a member can only change the
+  // decision for the entries which name one of its symbols, so we
+  // mark those as dirty and decide about them again; the result is
+  // exactly what a serial walk would produce.
+  std::vector<Archive::Should_include> decisions;
+  std::vector<bool> dirty;
 
   char* tmpbuf = NULL;
   size_t tmpbuflen = 0;
@@ -799,10 +927,24 @@ Archive::add_symbols(Symbol_table* symtab, Layout* layout,
   do
     {
       added_new_object = false;
-      for (size_t i = 0; i < armap_size; ++i)
+
+      const size_t pending_size = pending.size();
+      const unsigned int slices = parallel_slice_count(pending_size,
+						       armap_slice_min);
+      bool use_decisions = slices > 1;
+      if (use_decisions)
+	{
+	  decisions.resize(pending_size);
+	  Classify_armap_entries classify(symtab, layout, this, pending,
+					  &decisions);
+	  run_parallel_slices(&classify, pending_size, slices);
+	  dirty.assign(armap_size, false);
+	}
+
+      size_t kept = 0;
+      for (size_t j = 0; j < pending_size; ++j)
 	{
-          if (this->armap_checked_[i])
-            continue;
+	  const size_t i = pending[j];
 	  if (this->armap_[i].file_offset == last_seen_offset)
             {
               this->armap_checked_[i] = true;
@@ -816,18 +958,27 @@ Archive::add_symbols(Symbol_table* symtab, Layout* layout,
 	      continue;
 	    }
 
-	  const char* sym_name = (this->armap_names_.data()
-				  + this->armap_[i].name_offset);
-
-          Symbol* sym;
+          Symbol* sym = NULL;
           std::string why;
-          Archive::Should_include t =
-	    Archive::should_include_member(symtab, layout, sym_name, &sym,
-					   &why, &tmpbuf, &tmpbuflen);
+          Archive::Should_include t;
+	  if (use_decisions
+	      && !dirty[i]
+	      && decisions[j] != Archive::SHOULD_INCLUDE_YES)
+	    t = decisions[j];
+	  else
+	    {
+	      const char* sym_name = (this->armap_names_.data()
+				      + this->armap_[i].name_offset);
+	      t = Archive::should_include_member(symtab, layout, sym_name,
+						 &sym, &why, &tmpbuf,
+						 &tmpbuflen);
+	    }
 
 	  if (t == Archive::SHOULD_INCLUDE_NO
               || t == Archive::SHOULD_INCLUDE_YES)
 	    this->armap_checked_[i] = true;
+	  else
+	    pending[kept++] = i;
 
 	  if (t != Archive::SHOULD_INCLUDE_YES)
 	    continue;
@@ -836,17 +987,28 @@ Archive::add_symbols(Symbol_table* symtab, Layout* layout,
 	  last_seen_offset = this->armap_[i].file_offset;
 	  this->seen_offsets_.insert(last_seen_offset);
 
+	  Object* obj;
 	  if (!this->include_member(symtab, layout, input_objects,
 				    last_seen_offset, mapfile, sym,
-				    why.c_str()))
+				    why.c_str(), &obj))
 	    {
 	      if (tmpbuf != NULL)
 		free(tmpbuf);
 	      return false;
 	    }
 
+	  if (use_decisions
+	      && obj != NULL
+	      && !this->mark_armap_entries(obj, &dirty))
+	    {
+	      // We can't tell what changed, so decide about the rest of
+	      // the entries serially.
+	      use_decisions = false;
+	    }
+
 	  added_new_object = true;
 	}
+      pending.resize(kept);
     }
   while (added_new_object);
 
@@ -866,9 +1028,14 @@ Archive::defines_symbol(Symbol* sym) const
 {
   const char* symname = sym->name();
   size_t symname_len = strlen(symname);
-  size_t armap_size = this->armap_.size();
-  for (size_t i = 0; i < armap_size; ++i)
+  std::pair<size_t, size_t> key(string_hash<char>(symname, symname_len), 0);
+  for (Armap_index::const_iterator p =
+	 std::lower_bound(this->armap_index_.begin(),
+			  this->armap_index_.end(), key);
+       p != this->armap_index_.end() && p->first == key.first;
+       ++p)
     {
+      const size_t i = p->second;
       if (this->armap_checked_[i])
 	continue;
       const char* archive_symname = (this->armap_names_.data()
@@ -917,7 +1084,7 @@ Archive::include_all_members(Symbol_table* symtab, Layout* layout,
            ++p)
         {
           if (!this->include_member(symtab, layout, input_objects, p->first,
-				    mapfile, NULL, "--whole-archive"))
+				    mapfile, NULL, "--whole-archive", NULL))
 	    return false;
           ++Archive::total_members;
         }
@@ -929,7 +1096,7 @@ Archive::include_all_members(Symbol_table* symtab, Layout* layout,
            ++p)
         {
           if (!this->include_member(symtab, layout, input_objects, p->off,
-				    mapfile, NULL, "--whole-archive"))
+				    mapfile, NULL, "--whole-archive", NULL))
 	    return false;
           ++Archive::total_members;
         }
@@ -989,10 +1156,14 @@ class Thin_archive_object_unlocker
 bool
 Archive::include_member(Symbol_table* symtab, Layout* layout,
 			Input_objects* input_objects, off_t off,
-			Mapfile* mapfile, Symbol* sym, const char* why)
+			Mapfile* mapfile, Symbol* sym, const char* why,
+			Object** pobj)
 {
   ++Archive::total_members_loaded;
 
+  if (pobj != NULL)
+    *pobj = NULL;
+
   std::map<off_t, Archive_member>::const_iterator p = this->members_.find(off);
   if (p != this->members_.end())
     {
@@ -1006,6 +1177,8 @@ Archive::include_member(Symbol_table* symtab, Layout* layout,
           obj->layout(symtab, layout, sd);
           obj->add_symbols(symtab, sd, layout);
 	  this->included_member_ = true;
+	  if (pobj != NULL)
+	    *pobj = obj;
         }
       delete sd;
       return true;
@@ -1040,6 +1213,8 @@ Archive::include_member(Symbol_table* symtab, Layout* layout,
     {
       pluginobj->add_symbols(symtab, NULL, layout);
       this->included_member_ = true;
+      if (pobj != NULL)
+	*pobj = obj;
       return true;
     }
 
@@ -1060,6 +1235,8 @@ Archive::include_member(Symbol_table* symtab, Layout* layout,
   }
 
   this->included_member_ = true;
+  if (pobj != NULL)
+    *pobj = obj;
   return true;
 }
 
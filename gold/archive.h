@@ -335,10 +335,11 @@ class Archive : public Library_base
   bool
   include_all_members(Symbol_table*, Layout*, Input_objects*, Mapfile*);
 
-  // Include an archive member in the link.
+  // Include an archive member in the link.  If POBJ is not NULL, set
+  // *POBJ to the object whose symbols were added, or NULL if none were.
   bool
   include_member(Symbol_table*, Layout*, Input_objects*, off_t off,
-		 Mapfile*, Symbol*, const char* why);
+		 Mapfile*, Symbol*, const char* why, Object** pobj);
 
   // Return whether we found this archive by searching a directory.
   bool
@@ -369,6 +370,28 @@ class Archive : public Library_base
     off_t file_offset;
   };
 
+  // An index of the archive map: pairs of the hash code of a symbol
+  // name, ignoring any version, and the index of the entry in armap_,
+  // sorted by hash code.
+  typedef std::vector<std::pair<size_t, size_t> > Armap_index;
+
+  // Decide in parallel whether to include the members named by a
+  // list of armap entries.
+  class Classify_armap_entries;
+
+  // Return the hash code of an armap symbol name, up to any '@'.
+  static size_t
+  armap_name_hash(const char* name);
+
+  // Build armap_index_.
+  void
+  build_armap_index();
+
+  // Set DIRTY for each armap entry which may name a symbol of OBJ.
+  // Return false if we can not tell which symbols OBJ has.
+  bool
+  mark_armap_entries(const Object* obj, std::vector<bool>* dirty) const;
+
   // A simple hash code for off_t values.
   class Seen_hash
   {
@@ -388,6 +411,8 @@ class Archive : public Library_base
   std::vector<Armap_entry> armap_;
   // The names in the archive map.
   std::string armap_names_;
+  // The index of the archive map by symbol name.
+  Armap_index armap_index_;
   // The extended name table.
   std::string extended_names_;
   // Track which symbols in the archive map are for elements which are
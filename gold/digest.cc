@@ -0,0 +1,264 @@
+// digest.cc -- message digests used for build IDs
+
+// Copyright (C) 2023 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cstring>
+
+#include "digest.h"
+
+namespace gold
+{
+
+// SHA-256.
+
+namespace
+{
+
+const uint32_t sha256_k[64] =
+{
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t
+rotr32(uint32_t x, int n)
+{ return (x >> n) | (x << (32 - n)); }
+
+// Process one 64 byte block at P, updating the state H.
+
+void
+sha256_block(uint32_t* h, const unsigned char* p)
+{
+  uint32_t w[64];
+  for (int i = 0; i < 16; ++i)
+    w[i] = ((static_cast<uint32_t>(p[i * 4]) << 24)
+	    | (static_cast<uint32_t>(p[i * 4 + 1]) << 16)
+	    | (static_cast<uint32_t>(p[i * 4 + 2]) << 8)
+	    | static_cast<uint32_t>(p[i * 4 + 3]));
+  for (int i = 16; i < 64; ++i)
+    {
+      uint32_t s0 = (rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18)
+		     ^ (w[i - 15] >> 3));
+      uint32_t s1 = (rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19)
+		     ^ (w[i - 2] >> 10));
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+  uint32_t e = h[4], f = h[5], g = h[6], hh = h[7];
+  for (int i = 0; i < 64; ++i)
+    {
+      uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = hh + s1 + ch + sha256_k[i] + w[i];
+      uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = s0 + maj;
+      hh = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+  h[0] += a;
+  h[1] += b;
+  h[2] += c;
+  h[3] += d;
+  h[4] += e;
+  h[5] += f;
+  h[6] += g;
+  h[7] += hh;
+}
+
+} // End anonymous namespace.
+
+void*
+sha256_buffer(const char* buffer, size_t len, void* resblock)
+{
+  uint32_t h[8] =
+  {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer);
+  size_t left = len;
+  for (; left >= 64; left -= 64, p += 64)
+    sha256_block(h, p);
+
+  // Pad the final block(s) with a one bit, zeroes, and the message
+  // length in bits.
+  unsigned char tail[128];
+  memset(tail, 0, sizeof tail);
+  memcpy(tail, p, left);
+  tail[left] = 0x80;
+  size_t tail_len = left + 1 + 8 <= 64 ? 64 : 128;
+  uint64_t bits = static_cast<uint64_t>(len) * 8;
+  for (int i = 0; i < 8; ++i)
+    tail[tail_len - 1 - i] = static_cast<unsigned char>(bits >> (i * 8));
+  sha256_block(h, tail);
+  if (tail_len == 128)
+    sha256_block(h, tail + 64);
+
+  unsigned char* out = static_cast<unsigned char*>(resblock);
+  for (int i = 0; i < 8; ++i)
+    {
+      out[i * 4] = h[i] >> 24;
+      out[i * 4 + 1] = h[i] >> 16;
+      out[i * 4 + 2] = h[i] >> 8;
+      out[i * 4 + 3] = h[i];
+    }
+  return resblock;
+}
+
+// XXH64.
+
+namespace
+{
+
+const uint64_t xxh_prime1 = 0x9E3779B185EBCA87ULL;
+const uint64_t xxh_prime2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t xxh_prime3 = 0x165667B19E3779F9ULL;
+const uint64_t xxh_prime4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t xxh_prime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t
+rotl64(uint64_t x, int n)
+{ return (x << n) | (x >> (64 - n)); }
+
+inline uint64_t
+read_le64(const unsigned char* p)
+{
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; --i)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+inline uint64_t
+read_le32(const unsigned char* p)
+{
+  return (static_cast<uint64_t>(p[0])
+	  | (static_cast<uint64_t>(p[1]) << 8)
+	  | (static_cast<uint64_t>(p[2]) << 16)
+	  | (static_cast<uint64_t>(p[3]) << 24));
+}
+
+inline uint64_t
+xxh64_round(uint64_t acc, uint64_t input)
+{
+  acc += input * xxh_prime2;
+  acc = rotl64(acc, 31);
+  return acc * xxh_prime1;
+}
+
+inline uint64_t
+xxh64_merge_round(uint64_t acc, uint64_t val)
+{
+  acc ^= xxh64_round(0, val);
+  return acc * xxh_prime1 + xxh_prime4;
+}
+
+} // End anonymous namespace.
+
+void*
+xxhash64_buffer(const char* buffer, size_t len, void* resblock)
+{
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer);
+  const unsigned char* const end = p + len;
+  uint64_t h;
+
+  if (len >= 32)
+    {
+      uint64_t v1 = xxh_prime1 + xxh_prime2;
+      uint64_t v2 = xxh_prime2;
+      uint64_t v3 = 0;
+      uint64_t v4 = 0 - xxh_prime1;
+      const unsigned char* const limit = end - 32;
+      do
+	{
+	  v1 = xxh64_round(v1, read_le64(p));
+	  v2 = xxh64_round(v2, read_le64(p + 8));
+	  v3 = xxh64_round(v3, read_le64(p + 16));
+	  v4 = xxh64_round(v4, read_le64(p + 24));
+	  p += 32;
+	}
+      while (p <= limit);
+
+      h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+      h = xxh64_merge_round(h, v1);
+      h = xxh64_merge_round(h, v2);
+      h = xxh64_merge_round(h, v3);
+      h = xxh64_merge_round(h, v4);
+    }
+  else
+    h = xxh_prime5;
+
+  h += static_cast<uint64_t>(len);
+
+  for (; p + 8 <= end; p += 8)
+    {
+      h ^= xxh64_round(0, read_le64(p));
+      h = rotl64(h, 27) * xxh_prime1 + xxh_prime4;
+    }
+  if (p + 4 <= end)
+    {
+      h ^= read_le32(p) * xxh_prime1;
+      h = rotl64(h, 23) * xxh_prime2 + xxh_prime3;
+      p += 4;
+    }
+  for (; p < end; ++p)
+    {
+      h ^= *p * xxh_prime5;
+      h = rotl64(h, 11) * xxh_prime1;
+    }
+
+  h ^= h >> 33;
+  h *= xxh_prime2;
+  h ^= h >> 29;
+  h *= xxh_prime3;
+  h ^= h >> 32;
+
+  unsigned char* out = static_cast<unsigned char*>(resblock);
+  for (int i = 0; i < 8; ++i)
+    out[i] = static_cast<unsigned char>(h >> (56 - i * 8));
+  return resblock;
+}
+
+} // End namespace gold.
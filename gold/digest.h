@@ -0,0 +1,47 @@
+// digest.h -- message digests used for build IDs   -*- C++ -*-
+
+// Copyright (C) 2023 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#ifndef GOLD_DIGEST_H
+#define GOLD_DIGEST_H
+
+namespace gold
+{
+
+// The digests which libiberty does not provide.  These have the same
+// interface as md5_buffer and sha1_buffer: compute the digest of LEN
+// bytes at BUFFER, store it at RESBLOCK, and return RESBLOCK.
+
+// SHA-256, as specified in FIPS 180-4.  Writes 32 bytes.
+static const size_t SHA256_DIGEST_SIZE = 32;
+
+extern void*
+sha256_buffer(const char* buffer, size_t len, void* resblock);
+
+// XXH64 with a seed of zero.  Writes 8 bytes, most significant byte
+// first, matching the canonical XXH64 representation.
+static const size_t XXHASH64_DIGEST_SIZE = 8;
+
+extern void*
+xxhash64_buffer(const char* buffer, size_t len, void* resblock);
+
+} // End namespace gold.
+
+#endif // !defined(GOLD_DIGEST_H)
@@ -26,6 +26,7 @@
 #include <cstring>
 
 #include "elfcpp.h"
+#include "gold-threads.h"
 #include "parameters.h"
 #include "script.h"
 #include "symtab.h"
@@ -889,6 +890,53 @@ Dynobj::compute_bucket_count(const std::vector<uint32_t>& hashcodes,
   return ret;
 }
 
+// The minimum number of dynamic symbols handled by each thread when
+// building the hash tables in parallel.
+
+static const size_t dynsym_slice_min = 10000;
+
+// Compute the hash codes of the names of a vector of dynamic symbols,
+// for the ELF or the GNU hash table.  When FOR_GNU_HASH_TABLE, also
+// record which symbols go into the GNU hash table.
+
+class Dynsym_hash_function : public Parallel_function
+{
+ public:
+  Dynsym_hash_function(const std::vector<Symbol*>& dynsyms,
+		       uint32_t (*hash)(const char*),
+		       bool for_gnu_hash_table,
+		       std::vector<uint32_t>* hashvals,
+		       std::vector<unsigned char>* hashed)
+    : dynsyms_(dynsyms), hash_(hash), for_gnu_hash_table_(for_gnu_hash_table),
+      hashvals_(hashvals), hashed_(hashed)
+  { }
+
+  void
+  run(unsigned int, size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      {
+	const Symbol* sym = this->dynsyms_[i];
+	if (this->for_gnu_hash_table_
+	    && !sym->needs_dynsym_value()
+	    && (sym->is_undefined()
+		|| sym->is_from_dynobj()
+		|| sym->is_forced_local()))
+	  continue;
+	(*this->hashvals_)[i] = this->hash_(sym->name());
+	if (this->hashed_ != NULL)
+	  (*this->hashed_)[i] = 1;
+      }
+  }
+
+ private:
+  const std::vector<Symbol*>& dynsyms_;
+  uint32_t (*hash_)(const char*);
+  bool for_gnu_hash_table_;
+  std::vector<uint32_t>* hashvals_;
+  std::vector<unsigned char>* hashed_;
+};
+
 // The standard ELF hash function.  This hash function must not
 // change, as the dynamic linker uses it also.
 
@@ -929,8 +977,10 @@ Dynobj::create_elf_hash_table(const std::vector<Symbol*>& dynsyms,
 
   // Get the hash values for all the symbols.
   std::vector<uint32_t> dynsym_hashvals(dynsym_count);
-  for (unsigned int i = 0; i < dynsym_count; ++i)
-    dynsym_hashvals[i] = Dynobj::elf_hash(dynsyms[i]->name());
+  Dynsym_hash_function hash_fn(dynsyms, Dynobj::elf_hash, false,
+			       &dynsym_hashvals, NULL);
+  run_parallel_slices(&hash_fn, dynsym_count,
+		      parallel_slice_count(dynsym_count, dynsym_slice_min));
 
   const unsigned int bucketcount =
     Dynobj::compute_bucket_count(dynsym_hashvals, false);
@@ -1068,6 +1118,16 @@ Dynobj::create_gnu_hash_table(const std::vector<Symbol*>& dynsyms,
 {
   const unsigned int count = dynsyms.size();
 
+  // Decide which symbols go into the hash table, and compute their
+  // hash codes.  This is done in parallel, as it is the part of the
+  // work which looks at every symbol name.
+  std::vector<uint32_t> all_hashvals(count);
+  std::vector<unsigned char> hashed(count);
+  Dynsym_hash_function hash_fn(dynsyms, Dynobj::gnu_hash, true,
+			       &all_hashvals, &hashed);
+  run_parallel_slices(&hash_fn, count,
+		      parallel_slice_count(count, dynsym_slice_min));
+
   // Sort the dynamic symbols into two vectors.  Symbols which we do
   // not want to put into the hash table we store into
   // UNHASHED_DYNSYMS.  Symbols which we do want to store we put into
@@ -1082,20 +1142,17 @@ Dynobj::create_gnu_hash_table(const std::vector<Symbol*>& dynsyms,
 
   std::vector<uint32_t> dynsym_hashvals;
   dynsym_hashvals.reserve(count);
-  
+
   for (unsigned int i = 0; i < count; ++i)
     {
       Symbol* sym = dynsyms[i];
 
-      if (!sym->needs_dynsym_value()
-	  && (sym->is_undefined()
-	      || sym->is_from_dynobj()
-	      || sym->is_forced_local()))
+      if (!hashed[i])
 	unhashed_dynsyms.push_back(sym);
       else
 	{
 	  hashed_dynsyms.push_back(sym);
-	  dynsym_hashvals.push_back(Dynobj::gnu_hash(sym->name()));
+	  dynsym_hashvals.push_back(all_hashvals[i]);
 	}
     }
 
@@ -1171,8 +1228,117 @@ Dynobj::create_gnu_hash_table(const std::vector<Symbol*>& dynsyms,
     gold_unreachable();
 }
 
-// Create the actual data for a GNU hash table.  This is just a copy
-// of the code from the old GNU linker.
+// The first pass over the symbols when creating a GNU hash table.
+// For each slice of the symbols, count the symbols which fall in each
+// bucket, and set the bits of a private copy of the bloom filter.
+
+template<int size>
+class Gnu_hash_count_function : public Parallel_function
+{
+ public:
+  typedef typename elfcpp::Elf_types<size>::Elf_WXword Word;
+
+  Gnu_hash_count_function(const std::vector<uint32_t>& hashvals,
+			  unsigned int bucketcount, uint32_t maskbits,
+			  uint32_t maskwords, uint32_t shift1, uint32_t shift2,
+			  std::vector<std::vector<uint32_t> >* slice_counts,
+			  std::vector<std::vector<Word> >* slice_bitmasks)
+    : hashvals_(hashvals), bucketcount_(bucketcount), maskbits_(maskbits),
+      maskwords_(maskwords), shift1_(shift1), shift2_(shift2),
+      slice_counts_(slice_counts), slice_bitmasks_(slice_bitmasks)
+  { }
+
+  void
+  run(unsigned int slice, size_t begin, size_t end)
+  {
+    std::vector<uint32_t>& counts((*this->slice_counts_)[slice]);
+    std::vector<Word>& bitmask((*this->slice_bitmasks_)[slice]);
+    counts.resize(this->bucketcount_);
+    bitmask.resize(this->maskwords_);
+
+    const uint32_t mask = (1U << this->shift1_) - 1U;
+    for (size_t i = begin; i < end; ++i)
+      {
+	uint32_t hashval = this->hashvals_[i];
+	++counts[hashval % this->bucketcount_];
+
+	unsigned int val = ((hashval >> this->shift1_)
+			    & ((this->maskbits_ >> this->shift1_) - 1));
+	bitmask[val] |= (static_cast<Word>(1U)) << (hashval & mask);
+	bitmask[val] |= ((static_cast<Word>(1U))
+			 << ((hashval >> this->shift2_) & mask));
+      }
+  }
+
+ private:
+  const std::vector<uint32_t>& hashvals_;
+  unsigned int bucketcount_;
+  uint32_t maskbits_;
+  uint32_t maskwords_;
+  uint32_t shift1_;
+  uint32_t shift2_;
+  std::vector<std::vector<uint32_t> >* slice_counts_;
+  std::vector<std::vector<Word> >* slice_bitmasks_;
+};
+
+// The second pass over the symbols when creating a GNU hash table.
+// Each slice writes the hash chain entries for its symbols starting
+// at the per-bucket positions computed from the counts of the first
+// pass, so the symbols of a bucket stay in their original order.
+
+template<bool big_endian>
+class Gnu_hash_chain_function : public Parallel_function
+{
+ public:
+  Gnu_hash_chain_function(const std::vector<Symbol*>& hashed_dynsyms,
+			  const std::vector<uint32_t>& hashvals,
+			  const std::vector<uint32_t>& bucket_ends,
+			  uint32_t symindx, unsigned char* chains,
+			  std::vector<std::vector<uint32_t> >* slice_indx)
+    : hashed_dynsyms_(hashed_dynsyms), hashvals_(hashvals),
+      bucket_ends_(bucket_ends), symindx_(symindx), chains_(chains),
+      slice_indx_(slice_indx)
+  { }
+
+  void
+  run(unsigned int slice, size_t begin, size_t end)
+  {
+    std::vector<uint32_t>& indx((*this->slice_indx_)[slice]);
+    const unsigned int bucketcount = this->bucket_ends_.size();
+    for (size_t i = begin; i < end; ++i)
+      {
+	uint32_t hashval = this->hashvals_[i];
+	unsigned int bucket = hashval % bucketcount;
+	uint32_t symindex = indx[bucket];
+	++indx[bucket];
+
+	uint32_t val = hashval & ~ 1U;
+	if (symindex + 1 == this->bucket_ends_[bucket])
+	  {
+	    // Last element terminates the chain.
+	    val |= 1;
+	  }
+	elfcpp::Swap<32, big_endian>::writeval(this->chains_
+					       + (symindex - this->symindx_) * 4,
+					       val);
+
+	this->hashed_dynsyms_[i]->set_dynsym_index(symindex);
+      }
+  }
+
+ private:
+  const std::vector<Symbol*>& hashed_dynsyms_;
+  const std::vector<uint32_t>& hashvals_;
+  const std::vector<uint32_t>& bucket_ends_;
+  uint32_t symindx_;
+  unsigned char* chains_;
+  std::vector<std::vector<uint32_t> >* slice_indx_;
+};
+
+// Create the actual data for a GNU hash table.  This started as a
+// copy of the code from the old GNU linker.  The buckets are assigned
+// with a counting sort and the bloom filter is built in shards, both
+// split among threads when there are many symbols.
 
 template<int size, bool big_endian>
 void
@@ -1235,7 +1401,6 @@ Dynobj::sized_create_gnu_hash_table(
 	maskbitslog2 = 6;
       shift1 = 6;
     }
-  uint32_t mask = (1U << shift1) - 1U;
   uint32_t shift2 = maskbitslog2;
   uint32_t maskbits = 1U << maskbitslog2;
   uint32_t maskwords = 1U << (maskbitslog2 - shift1);
@@ -1244,19 +1409,39 @@ Dynobj::sized_create_gnu_hash_table(
   std::vector<Word> bitmask(maskwords);
   std::vector<uint32_t> counts(bucketcount);
   std::vector<uint32_t> indx(bucketcount);
+  std::vector<uint32_t> bucket_ends(bucketcount);
   uint32_t symindx = unhashed_dynsym_count;
 
-  // Count the number of times each hash bucket is used.
-  for (unsigned int i = 0; i < nsyms; ++i)
-    ++counts[dynsym_hashvals[i] % bucketcount];
-
+  // Count the number of times each hash bucket is used by each slice
+  // of the symbols, and build the bloom filter.
+  const unsigned int slices = parallel_slice_count(nsyms, dynsym_slice_min);
+  std::vector<std::vector<uint32_t> > slice_indx(slices);
+  std::vector<std::vector<Word> > slice_bitmasks(slices);
+  Gnu_hash_count_function<size> count_fn(dynsym_hashvals, bucketcount,
+					 maskbits, maskwords, shift1, shift2,
+					 &slice_indx, &slice_bitmasks);
+  run_parallel_slices(&count_fn, nsyms, slices);
+
+  // Turn the counts into the index of the first symbol of each bucket
+  // for each slice.
   unsigned int cnt = symindx;
   for (unsigned int i = 0; i < bucketcount; ++i)
     {
       indx[i] = cnt;
-      cnt += counts[i];
+      for (unsigned int j = 0; j < slices; ++j)
+	{
+	  uint32_t c = slice_indx[j][i];
+	  slice_indx[j][i] = cnt;
+	  cnt += c;
+	}
+      counts[i] = cnt - indx[i];
+      bucket_ends[i] = cnt;
     }
 
+  for (unsigned int j = 0; j < slices; ++j)
+    for (unsigned int i = 0; i < maskwords; ++i)
+      bitmask[i] |= slice_bitmasks[j][i];
+
   unsigned int hashlen = (4 + bucketcount + nsyms) * 4;
   hashlen += maskbits / 8;
   unsigned char* phash = new unsigned char[hashlen];
@@ -1276,29 +1461,10 @@ Dynobj::sized_create_gnu_hash_table(
       p += 4;
     }
 
-  for (unsigned int i = 0; i < nsyms; ++i)
-    {
-      Symbol* sym = hashed_dynsyms[i];
-      uint32_t hashval = dynsym_hashvals[i];
-
-      unsigned int bucket = hashval % bucketcount;
-      unsigned int val = ((hashval >> shift1)
-			  & ((maskbits >> shift1) - 1));
-      bitmask[val] |= (static_cast<Word>(1U)) << (hashval & mask);
-      bitmask[val] |= (static_cast<Word>(1U)) << ((hashval >> shift2) & mask);
-      val = hashval & ~ 1U;
-      if (counts[bucket] == 1)
-	{
-	  // Last element terminates the chain.
-	  val |= 1;
-	}
-      elfcpp::Swap<32, big_endian>::writeval(p + (indx[bucket] - symindx) * 4,
-					     val);
-      --counts[bucket];
-
-      sym->set_dynsym_index(indx[bucket]);
-      ++indx[bucket];
-    }
+  Gnu_hash_chain_function<big_endian> chain_fn(hashed_dynsyms,
+					       dynsym_hashvals, bucket_ends,
+					       symindx, p, &slice_indx);
+  run_parallel_slices(&chain_fn, nsyms, slices);
 
   p = phash + 16;
   for (unsigned int i = 0; i < maskwords; ++i)
@@ -1094,6 +1094,16 @@ Input_file::find_file(const Dirsearch& dirpath, int* pindex,
 bool
 Input_file::open(const Dirsearch& dirpath, const Task* task, int* pindex)
 {
+  // A file added by a plugin may already be in memory.
+  if (this->input_argument_->contents() != NULL)
+    {
+      this->found_name_ = this->input_argument_->name();
+      this->format_ = FORMAT_ELF;
+      return this->file_.open(task, this->found_name_,
+			      this->input_argument_->contents(),
+			      this->input_argument_->contents_size());
+    }
+
   std::string name;
   if (!Input_file::find_file(dirpath, pindex, this->input_argument_,
 			     &this->is_in_sysroot_, &this->found_name_, &name))
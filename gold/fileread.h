@@ -216,6 +216,15 @@ class File_read
   static void
   record_file_read(const std::string& name);
 
+  // Return whether the contents of the file were provided in memory,
+  // in which case there is no file descriptor.
+  bool
+  contents_in_memory() const
+  {
+    return (this->whole_file_view_ != NULL
+	    && this->whole_file_view_->is_permanent_view());
+  }
+
   // Return the open file descriptor (for plugins).
   int
   descriptor()
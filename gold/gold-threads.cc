@@ -23,6 +23,8 @@
 #include "gold.h"
 
 #include <cstring>
+#include <vector>
+#include <unistd.h>
 
 #ifdef ENABLE_THREADS
 #include <pthread.h>
@@ -447,4 +449,104 @@ Initialize_lock::do_run_once(void*)
   *this->pplock_ = new Lock();
 }
 
+// Parallel slices.
+
+unsigned int
+parallel_slice_count(size_t count, size_t min_per_slice)
+{
+#ifndef ENABLE_THREADS
+  return 1;
+#else
+  if (!parameters->options_valid() || !parameters->options().threads())
+    return 1;
+
+  unsigned int threads = parameters->options().thread_count();
+  if (threads == 0)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+      long online = sysconf(_SC_NPROCESSORS_ONLN);
+      threads = online > 0 ? static_cast<unsigned int>(online) : 1;
+#else
+      threads = 1;
+#endif
+    }
+
+  if (min_per_slice == 0)
+    min_per_slice = 1;
+  size_t max_slices = count / min_per_slice;
+  if (max_slices < threads)
+    threads = max_slices;
+  return threads == 0 ? 1 : threads;
+#endif
+}
+
+#ifdef ENABLE_THREADS
+
+// A slice being run on a separate thread.
+
+struct Parallel_slice
+{
+  Parallel_function* pf;
+  unsigned int slice;
+  size_t begin;
+  size_t end;
+};
+
+// Passed to pthread_create.
+
+extern "C"
+{
+
+static void*
+parallel_slice_body(void* arg)
+{
+  Parallel_slice* ps = static_cast<Parallel_slice*>(arg);
+  ps->pf->run(ps->slice, ps->begin, ps->end);
+  return NULL;
+}
+
+}
+
+#endif // defined(ENABLE_THREADS)
+
+void
+run_parallel_slices(Parallel_function* pf, size_t count, unsigned int slices)
+{
+  if (slices <= 1 || count <= 1)
+    {
+      pf->run(0, 0, count);
+      return;
+    }
+
+#ifndef ENABLE_THREADS
+  for (unsigned int i = 0; i < slices; ++i)
+    pf->run(i, parallel_slice_begin(count, slices, i),
+	    parallel_slice_begin(count, slices, i + 1));
+#else
+  // Slice 0 runs on this thread.
+  std::vector<Parallel_slice> ps(slices);
+  std::vector<pthread_t> tids(slices);
+  for (unsigned int i = 0; i < slices; ++i)
+    {
+      ps[i].pf = pf;
+      ps[i].slice = i;
+      ps[i].begin = parallel_slice_begin(count, slices, i);
+      ps[i].end = parallel_slice_begin(count, slices, i + 1);
+    }
+  for (unsigned int i = 1; i < slices; ++i)
+    {
+      int err = pthread_create(&tids[i], NULL, parallel_slice_body, &ps[i]);
+      if (err != 0)
+	gold_fatal(_("pthread_create failed: %s"), strerror(err));
+    }
+  parallel_slice_body(&ps[0]);
+  for (unsigned int i = 1; i < slices; ++i)
+    {
+      int err = pthread_join(tids[i], NULL);
+      if (err != 0)
+	gold_fatal(_("pthread_join failed: %s"), strerror(err));
+    }
+#endif
+}
+
 } // End namespace gold.
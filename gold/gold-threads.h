@@ -262,6 +262,57 @@ class Initialize_lock : public Once
   Lock** const pplock_;
 };
 
+// A function which can be run over disjoint slices of a range of
+// indexes, possibly on several threads at once.  This is an abstract
+// parent class; any actual use will involve a child of this.  The
+// child must produce the same result however the range is sliced.
+
+class Parallel_function
+{
+ public:
+  Parallel_function()
+  { }
+
+  virtual
+  ~Parallel_function()
+  { }
+
+  // Handle the indexes from BEGIN up to but not including END.  SLICE
+  // is the number of the slice, counting from zero in index order.
+  virtual void
+  run(unsigned int slice, size_t begin, size_t end) = 0;
+
+ private:
+  // This class can not be copied.
+  Parallel_function(const Parallel_function&);
+  Parallel_function& operator=(const Parallel_function&);
+};
+
+// Return the number of slices to use when running a Parallel_function
+// over COUNT indexes, giving each slice at least MIN_PER_SLICE
+// indexes.  This is 1 unless --threads was used.
+
+extern unsigned int
+parallel_slice_count(size_t count, size_t min_per_slice);
+
+// Split the indexes from 0 up to COUNT into SLICES contiguous slices
+// of nearly equal size, and call PF->run for each slice.  The slices
+// run on separate threads if threads are enabled.  This returns after
+// all the slices have been run.
+
+extern void
+run_parallel_slices(Parallel_function* pf, size_t count, unsigned int slices);
+
+// Return the first index of slice SLICE when splitting COUNT indexes
+// into SLICES slices as run_parallel_slices does.
+
+inline size_t
+parallel_slice_begin(size_t count, unsigned int slices, unsigned int slice)
+{
+  size_t extra = count % slices;
+  return (count / slices) * slice + (slice < extra ? slice : extra);
+}
+
 } // End namespace gold.
 
 #endif // !defined(GOLD_THREADS_H)
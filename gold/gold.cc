@@ -46,6 +46,7 @@
 #include "icf.h"
 #include "incremental.h"
 #include "timer.h"
+#include "reloc_cache.h"
 
 namespace gold
 {
@@ -811,6 +812,21 @@ queue_final_tasks(const General_options& options,
 
   bool any_postprocessing_sections = layout->any_postprocessing_sections();
 
+  // Set up the relocation cache now that the symbol values and the
+  // output section addresses are final.
+  if (options.user_set_relocation_cache())
+    {
+      if (!Relocation_cache::is_usable())
+	gold_warning(_("--relocation-cache ignored for this link"));
+      else
+	{
+	  Relocation_cache* cache =
+	    new Relocation_cache(options.relocation_cache());
+	  cache->compute_link_fingerprint(symtab, layout);
+	  layout->set_relocation_cache(cache);
+	}
+    }
+
   // Use a blocker to wait until all the input sections have been
   // written out.
   Task_token* input_sections_blocker = NULL;
@@ -886,7 +902,11 @@ queue_final_tasks(const General_options& options,
     }
 
   // Create tasks for tree-style build ID computation, if necessary.
-  if (strcmp(options.build_id(), "tree") == 0)
+  const Build_id_hasher* build_id_hasher_p =
+    (options.user_set_build_id()
+     ? build_id_hasher(options.build_id())
+     : NULL);
+  if (build_id_hasher_p != NULL && build_id_hasher_p->tree)
     {
       // Queue a task to compute the build id.  This will be blocked by
       // FINAL_BLOCKER, and will in turn schedule the task to close
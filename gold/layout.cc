@@ -59,6 +59,8 @@
 #include "descriptors.h"
 #include "plugin.h"
 #include "incremental.h"
+#include "digest.h"
+#include "reloc_cache.h"
 #include "layout.h"
 
 namespace gold
@@ -242,17 +244,44 @@ Free_list::print_stats()
 	  program_name, Free_list::num_allocate_visits);
 }
 
-// A Hash_task computes the MD5 checksum of an array of char.
+// The ways of hashing the output file for a --build-id style.  The
+// "tree" style hashes each chunk with MD5 and the chunk hashes with
+// SHA-1; the newer styles use the same digest for both.
+
+static const Build_id_hasher build_id_hashers[] =
+{
+  { "md5", md5_buffer, 128 / 8, md5_buffer, 128 / 8, false },
+  { "sha1", sha1_buffer, 160 / 8, sha1_buffer, 160 / 8, false },
+  { "tree", md5_buffer, 128 / 8, sha1_buffer, 160 / 8, true },
+  { "sha256", sha256_buffer, SHA256_DIGEST_SIZE,
+    sha256_buffer, SHA256_DIGEST_SIZE, true },
+  { "xxhash", xxhash64_buffer, XXHASH64_DIGEST_SIZE,
+    xxhash64_buffer, XXHASH64_DIGEST_SIZE, true },
+};
+
+const Build_id_hasher*
+build_id_hasher(const char* style)
+{
+  const size_t count = sizeof build_id_hashers / sizeof build_id_hashers[0];
+  for (size_t i = 0; i < count; ++i)
+    if (strcmp(style, build_id_hashers[i].style) == 0)
+      return &build_id_hashers[i];
+  return NULL;
+}
+
+// A Hash_task computes the checksum of an array of char, using the
+// chunk hash of a Build_id_hasher.
 
 class Hash_task : public Task
 {
  public:
   Hash_task(Output_file* of,
+	    Build_id_hash_function hash,
 	    size_t offset,
 	    size_t size,
 	    unsigned char* dst,
 	    Task_token* final_blocker)
-    : of_(of), offset_(offset), size_(size), dst_(dst),
+    : of_(of), hash_(hash), offset_(offset), size_(size), dst_(dst),
       final_blocker_(final_blocker)
   { }
 
@@ -261,7 +290,7 @@ class Hash_task : public Task
   {
     const unsigned char* iv =
 	this->of_->get_input_view(this->offset_, this->size_);
-    md5_buffer(reinterpret_cast<const char*>(iv), this->size_, this->dst_);
+    this->hash_(reinterpret_cast<const char*>(iv), this->size_, this->dst_);
     this->of_->free_input_view(this->offset_, this->size_, iv);
   }
 
@@ -280,6 +309,7 @@ class Hash_task : public Task
 
  private:
   Output_file* of_;
+  const Build_id_hash_function hash_;
   const size_t offset_;
   const size_t size_;
   unsigned char* const dst_;
@@ -468,6 +498,7 @@ Layout::Layout(int number_of_input_files, Script_options* script_options)
     section_ordering_specified_(false),
     unique_segment_for_sections_specified_(false),
     incremental_inputs_(NULL),
+    relocation_cache_(NULL),
     record_output_section_data_from_script_(false),
     lto_slim_object_(false),
     script_output_section_data_list_(),
@@ -3452,10 +3483,9 @@ Layout::create_build_id()
   // set DESC to the note descriptor contents.
   size_t descsz;
   std::string desc;
-  if (strcmp(style, "md5") == 0)
-    descsz = 128 / 8;
-  else if ((strcmp(style, "sha1") == 0) || (strcmp(style, "tree") == 0))
-    descsz = 160 / 8;
+  const Build_id_hasher* hasher = build_id_hasher(style);
+  if (hasher != NULL)
+    descsz = hasher->final_hash_size;
   else if (strcmp(style, "uuid") == 0)
     {
 #ifndef __MINGW32__
@@ -5962,29 +5992,27 @@ Layout::write_build_id(Output_file* of, unsigned char* array_of_hashes,
   unsigned char* ov = of->get_output_view(this->build_id_note_->offset(),
 					  this->build_id_note_->data_size());
 
+  const Build_id_hasher* hasher =
+    build_id_hasher(parameters->options().build_id());
+  gold_assert(hasher != NULL);
+
   if (array_of_hashes == NULL)
     {
+      // If we get here with a tree style then the output must be too
+      // small for chunking, and we hash the whole file with the final
+      // hash in that case.
       const size_t output_file_size = this->output_file_size();
       const unsigned char* iv = of->get_input_view(0, output_file_size);
-      const char* style = parameters->options().build_id();
-
-      // If we get here with style == "tree" then the output must be
-      // too small for chunking, and we use SHA-1 in that case.
-      if ((strcmp(style, "sha1") == 0) || (strcmp(style, "tree") == 0))
-	sha1_buffer(reinterpret_cast<const char*>(iv), output_file_size, ov);
-      else if (strcmp(style, "md5") == 0)
-	md5_buffer(reinterpret_cast<const char*>(iv), output_file_size, ov);
-      else
-	gold_unreachable();
-
+      hasher->final_hash(reinterpret_cast<const char*>(iv), output_file_size,
+			 ov);
       of->free_input_view(0, output_file_size, iv);
     }
   else
     {
       // Non-overlapping substrings of the output file have been hashed.
-      // Compute SHA-1 hash of the hashes.
-      sha1_buffer(reinterpret_cast<const char*>(array_of_hashes),
-		  size_of_hashes, ov);
+      // Compute the final hash of the hashes.
+      hasher->final_hash(reinterpret_cast<const char*>(array_of_hashes),
+			 size_of_hashes, ov);
       delete[] array_of_hashes;
     }
 
@@ -6070,6 +6098,9 @@ Layout::print_stats() const
        p != this->section_list_.end();
        ++p)
     (*p)->print_merge_stats();
+
+  if (this->relocation_cache_ != NULL)
+    this->relocation_cache_->print_stats();
 }
 
 // Write_sections_task methods.
@@ -6186,7 +6217,8 @@ Write_after_input_sections_task::run(Workqueue*)
 
 // Build IDs can be computed as a "flat" sha1 or md5 of a string of bytes,
 // or as a "tree" where each chunk of the string is hashed and then those
-// hashes are put into a (much smaller) string which is hashed with sha1.
+// hashes are put into a (much smaller) string which is hashed again.
+// The "tree", "sha256" and "xxhash" styles use a tree for large outputs.
 // We compute a checksum over the entire file because that is simplest.
 
 void
@@ -6200,24 +6232,27 @@ Build_id_task_runner::run(Workqueue* workqueue, const Task*)
   unsigned char* array_of_hashes = NULL;
   size_t size_of_hashes = 0;
 
-  if (strcmp(this->options_->build_id(), "tree") == 0
-      && this->options_->build_id_chunk_size_for_treehash() > 0
+  const Build_id_hasher* hasher = build_id_hasher(this->options_->build_id());
+  gold_assert(hasher != NULL && hasher->tree);
+
+  if (this->options_->build_id_chunk_size_for_treehash() > 0
       && filesize > 0
       && (filesize >= this->options_->build_id_min_file_size_for_treehash()))
     {
-      static const size_t MD5_OUTPUT_SIZE_IN_BYTES = 16;
+      const size_t hash_size = hasher->chunk_hash_size;
       const size_t chunk_size =
 	  this->options_->build_id_chunk_size_for_treehash();
       const size_t num_hashes = ((filesize - 1) / chunk_size) + 1;
       post_hash_tasks_blocker->add_blockers(num_hashes);
-      size_of_hashes = num_hashes * MD5_OUTPUT_SIZE_IN_BYTES;
+      size_of_hashes = num_hashes * hash_size;
       array_of_hashes = new unsigned char[size_of_hashes];
       unsigned char *dst = array_of_hashes;
       for (size_t i = 0, src_offset = 0; i < num_hashes;
-	   i++, dst += MD5_OUTPUT_SIZE_IN_BYTES, src_offset += chunk_size)
+	   i++, dst += hash_size, src_offset += chunk_size)
 	{
 	  size_t size = std::min(chunk_size, filesize - src_offset);
 	  workqueue->queue(new Hash_task(of,
+					 hasher->chunk_hash,
 					 src_offset,
 					 size,
 					 dst,
@@ -44,6 +44,7 @@ class Incremental_inputs;
 class Incremental_binary;
 class Input_objects;
 class Mapfile;
+class Relocation_cache;
 class Symbol_table;
 class Output_section_data;
 class Output_section;
@@ -944,6 +945,17 @@ class Layout
   incremental_inputs() const
   { return this->incremental_inputs_; }
 
+  // Return the cache of relocated section contents.  NULL unless
+  // --relocation-cache was used.
+  Relocation_cache*
+  relocation_cache() const
+  { return this->relocation_cache_; }
+
+  // Set the cache of relocated section contents.
+  void
+  set_relocation_cache(Relocation_cache* relocation_cache)
+  { this->relocation_cache_ = relocation_cache; }
+
   // For the target-specific code to add dynamic tags which are common
   // to most targets.
   void
@@ -1498,6 +1510,8 @@ class Layout
   // In incremental build, holds information check the inputs and build the
   // .gnu_incremental_inputs section.
   Incremental_inputs* incremental_inputs_;
+  // The cache of relocated section contents, or NULL.
+  Relocation_cache* relocation_cache_;
   // Whether we record output section data created in script
   bool record_output_section_data_from_script_;
   // Set if this is a slim LTO object not loaded with a compiler plugin
@@ -1680,8 +1694,32 @@ class Write_after_input_sections_task : public Task
   Task_token* final_blocker_;
 };
 
+// How the output file is hashed to compute a --build-id STYLE.  When
+// TREE is true and the output is large enough, each chunk of the file
+// is hashed with CHUNK_HASH in parallel and FINAL_HASH is applied to
+// the concatenated chunk hashes.  Otherwise FINAL_HASH is applied to
+// the whole file.  The functions have the interface of md5_buffer.
+
+typedef void* (*Build_id_hash_function)(const char*, size_t, void*);
+
+struct Build_id_hasher
+{
+  const char* style;
+  Build_id_hash_function chunk_hash;
+  size_t chunk_hash_size;
+  Build_id_hash_function final_hash;
+  size_t final_hash_size;
+  bool tree;
+};
+
+// Return the hasher for STYLE, or NULL if the build ID for STYLE is
+// not computed from the contents of the output file.
+
+extern const Build_id_hasher*
+build_id_hasher(const char* style);
+
 // This task function handles computation of the build id.
-// When using --build-id=tree, it schedules the tasks that
+// When using a tree style, it schedules the tasks that
 // compute the hashes for each chunk of the file. This task
 // cannot run until we have finalized the size of the output
 // file, after the completion of Write_after_input_sections_task.
@@ -2706,6 +2706,10 @@ class Sized_relobj_file : public Sized_relobj<size, big_endian>
   write_sections(const Layout*, const unsigned char* pshdrs, Output_file*,
 		 Views*);
 
+  // Compute the fingerprint of this object for the relocation cache.
+  void
+  compute_relocation_cache_fingerprint(const unsigned char* pshdrs);
+
   // Relocate the sections in the output file.
   void
   relocate_sections(const Symbol_table* symtab, const Layout* layout,
@@ -2913,6 +2917,10 @@ class Sized_relobj_file : public Sized_relobj<size, big_endian>
   std::vector<Deferred_layout> deferred_layout_relocs_;
   // Pointer to the list of output views; valid only during do_relocate().
   const Views* output_views_;
+  // The fingerprint of this object for the relocation cache; empty if
+  // the sections of this object can not be cached.  Valid only during
+  // do_relocate().
+  std::string relocation_cache_fingerprint_;
 };
 
 // A class to manage the list of all objects.
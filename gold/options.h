@@ -724,12 +724,13 @@ class General_options
 
   DEFINE_uint64(build_id_chunk_size_for_treehash,
 		options::TWO_DASHES, '\0', 2 << 20,
-		N_("Chunk size for '--build-id=tree'"), N_("SIZE"));
+		N_("Chunk size for tree-style build IDs"), N_("SIZE"));
 
   DEFINE_uint64(build_id_min_file_size_for_treehash, options::TWO_DASHES,
 		'\0', 40 << 20,
-		N_("Minimum output file size for '--build-id=tree' to work"
-		   " differently than '--build-id=sha1'"), N_("SIZE"));
+		N_("Minimum output file size for '--build-id=tree',"
+		   " '--build-id=sha256' and '--build-id=xxhash' to hash"
+		   " chunks of the output in parallel"), N_("SIZE"));
 
   DEFINE_bool(Bdynamic, options::ONE_DASH, '\0', true,
 	      N_("-l searches for shared libraries"), NULL);
@@ -1204,6 +1205,10 @@ class General_options
 	      N_("Relax branches on certain targets"),
 	      N_("Do not relax branches"));
 
+  DEFINE_string(relocation_cache, options::TWO_DASHES, '\0', NULL,
+		N_("Cache relocated section contents in DIR (experimental)"),
+		N_("DIR"));
+
   DEFINE_string(retain_symbols_file, options::TWO_DASHES, '\0', NULL,
 		N_("keep only symbols listed in this file"), N_("FILE"));
 
@@ -2036,7 +2041,8 @@ class Input_file_argument
   //         command line, such as --whole-archive.
   Input_file_argument()
     : name_(), type_(INPUT_FILE_TYPE_FILE), extra_search_path_(""),
-      just_symbols_(false), options_(), arg_serial_(0)
+      just_symbols_(false), options_(), arg_serial_(0), contents_(NULL),
+      contents_size_(0)
   { }
 
   Input_file_argument(const char* name, Input_file_type type,
@@ -2044,7 +2050,8 @@ class Input_file_argument
 		      bool just_symbols,
 		      const Position_dependent_options& options)
     : name_(name), type_(type), extra_search_path_(extra_search_path),
-      just_symbols_(just_symbols), options_(options), arg_serial_(0)
+      just_symbols_(just_symbols), options_(options), arg_serial_(0),
+      contents_(NULL), contents_size_(0)
   { }
 
   // You can also pass in a General_options instance instead of a
@@ -2056,7 +2063,8 @@ class Input_file_argument
 		      bool just_symbols,
 		      const General_options& options)
     : name_(name), type_(type), extra_search_path_(extra_search_path),
-      just_symbols_(just_symbols), options_(options), arg_serial_(0)
+      just_symbols_(just_symbols), options_(options), arg_serial_(0),
+      contents_(NULL), contents_size_(0)
   { }
 
   const char*
@@ -2108,6 +2116,27 @@ class Input_file_argument
   arg_serial() const
   { return this->arg_serial_; }
 
+  // Provide the contents of the file in memory, so that it is not
+  // read from the file system.  This is used for files added by
+  // plugins.  The contents are not copied.
+  void
+  set_contents(const unsigned char* contents, off_t size)
+  {
+    this->contents_ = contents;
+    this->contents_size_ = size;
+  }
+
+  // Return the contents of the file, or NULL if it should be read
+  // from the file system.
+  const unsigned char*
+  contents() const
+  { return this->contents_; }
+
+  // Return the size of the contents.
+  off_t
+  contents_size() const
+  { return this->contents_size_; }
+
  private:
   // We use std::string, not const char*, here for convenience when
   // using script files, so that we do not have to preserve the string
@@ -2119,6 +2148,10 @@ class Input_file_argument
   Position_dependent_options options_;
   // A unique index for this file argument in the argument list.
   unsigned int arg_serial_;
+  // The contents of the file, if they were provided in memory.
+  const unsigned char* contents_;
+  // The size of contents_.
+  off_t contents_size_;
 };
 
 // A file or library, or a group, from the command line.
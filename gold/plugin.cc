@@ -125,6 +125,9 @@ add_input_file(const char *pathname);
 static enum ld_plugin_status
 add_input_library(const char *pathname);
 
+static enum ld_plugin_status
+add_input_buffer(const void *buffer, size_t size, const char *name);
+
 static enum ld_plugin_status
 set_extra_library_path(const char *path);
 
@@ -223,7 +226,7 @@ Plugin::load()
   sscanf(ver, "%d.%d", &major, &minor);
 
   // Allocate and populate a transfer vector.
-  const int tv_fixed_size = 31;
+  const int tv_fixed_size = 32;
 
   int tv_size = this->args_.size() + tv_fixed_size;
   ld_plugin_tv* tv = new ld_plugin_tv[tv_size];
@@ -312,6 +315,10 @@ Plugin::load()
   tv[i].tv_tag = LDPT_ADD_INPUT_LIBRARY;
   tv[i].tv_u.tv_add_input_library = add_input_library;
 
+  ++i;
+  tv[i].tv_tag = LDPT_ADD_INPUT_BUFFER;
+  tv[i].tv_u.tv_add_input_buffer = add_input_buffer;
+
   ++i;
   tv[i].tv_tag = LDPT_SET_EXTRA_LIBRARY_PATH;
   tv[i].tv_u.tv_set_extra_library_path = set_extra_library_path;
@@ -488,6 +495,9 @@ class Plugin_recorder
   void
   replacement_file(const char* name, bool is_lib);
 
+  void
+  replacement_buffer(const char* name, const void* buffer, size_t size);
+
   void
   record_symbols(const Object* obj, int nsyms,
 		 const struct ld_plugin_symbol* syms);
@@ -630,6 +640,30 @@ Plugin_recorder::replacement_file(const char* name, bool is_lib)
   fprintf(this->logfile_, "\n");
 }
 
+void
+Plugin_recorder::replacement_buffer(const char* name, const void* buffer,
+				    size_t size)
+{
+  fprintf(this->logfile_, "REPLACEMENT: %s(memory)", name);
+  char counter[10];
+  const char* basename = lbasename(name);
+  snprintf(counter, sizeof(counter), "%05d", this->file_count_);
+  ++this->file_count_;
+  std::string outname(this->tempdir_);
+  outname.append("/");
+  outname.append(counter);
+  outname.append("-");
+  outname.append(basename);
+  FILE* out = fopen(outname.c_str(), "wb");
+  if (out != NULL)
+    {
+      bool ok = fwrite(buffer, 1, size, out) == size;
+      if (fclose(out) == 0 && ok)
+	fprintf(this->logfile_, " -> %s", outname.c_str());
+    }
+  fprintf(this->logfile_, "\n");
+}
+
 void
 Plugin_recorder::record_symbols(const Object* obj, int nsyms,
 				const struct ld_plugin_symbol* syms)
@@ -747,7 +781,10 @@ Plugin_manager::claim_file(Input_file* input_file, off_t offset,
   unsigned int handle = this->objects_.size();
   this->input_file_ = input_file;
   this->plugin_input_file_.name = input_file->filename().c_str();
-  this->plugin_input_file_.fd = input_file->file().descriptor();
+  // A file added by a plugin from memory has no descriptor.
+  this->plugin_input_file_.fd = (input_file->file().contents_in_memory()
+				 ? -1
+				 : input_file->file().descriptor());
   this->plugin_input_file_.offset = offset;
   this->plugin_input_file_.filesize = filesize;
   this->plugin_input_file_.handle = reinterpret_cast<void*>(handle);
@@ -1201,6 +1238,50 @@ Plugin_manager::add_input_file(const char* pathname, bool is_lib)
   return LDPS_OK;
 }
 
+// Add a new input file whose contents are in memory.  The file is
+// read through a Read_symbols task like any other, so with --threads
+// the files added by a plugin are read in parallel, while their
+// symbols are still added in the order in which they were added.
+
+ld_plugin_status
+Plugin_manager::add_input_buffer(const void* buffer, size_t size,
+				 const char* name)
+{
+  if (buffer == NULL || name == NULL)
+    return LDPS_ERR;
+
+  Input_file_argument file(name,
+			   Input_file_argument::INPUT_FILE_TYPE_FILE,
+			   "",
+			   false,
+			   this->options_);
+  file.set_contents(static_cast<const unsigned char*>(buffer), size);
+  Input_argument* input_argument = new Input_argument(file);
+  Task_token* next_blocker = new Task_token(true);
+  next_blocker->add_blocker();
+  if (parameters->incremental())
+    gold_error(_("input files added by plug-ins in --incremental mode not "
+		 "supported yet"));
+
+  if (this->recorder_ != NULL)
+    this->recorder_->replacement_buffer(name, buffer, size);
+
+  this->workqueue_->queue_soon(new Read_symbols(this->input_objects_,
+						this->symtab_,
+						this->layout_,
+						this->dirpath_,
+						0,
+						this->mapfile_,
+						input_argument,
+						NULL,
+						NULL,
+						this->this_blocker_,
+						next_blocker));
+  this->this_blocker_ = next_blocker;
+  this->any_added_ = true;
+  return LDPS_OK;
+}
+
 // Class Pluginobj.
 
 Pluginobj::Pluginobj(const std::string& name, Input_file* input_file,
@@ -1933,6 +2014,16 @@ add_input_library(const char* pathname)
   return parameters->options().plugins()->add_input_file(pathname, true);
 }
 
+// Add a new input file generated by a plugin, held in memory.
+
+static enum ld_plugin_status
+add_input_buffer(const void* buffer, size_t size, const char* name)
+{
+  gold_assert(parameters->options().has_plugins());
+  return parameters->options().plugins()->add_input_buffer(buffer, size,
+							    name);
+}
+
 // Set the extra library path to be used by libraries added via
 // add_input_library
 
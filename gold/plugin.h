@@ -301,6 +301,10 @@ class Plugin_manager
   ld_plugin_status
   add_input_file(const char* pathname, bool is_lib);
 
+  // Add a new input file whose contents are in memory.
+  ld_plugin_status
+  add_input_buffer(const void* buffer, size_t size, const char* name);
+
   // Set the extra library path.
   ld_plugin_status
   set_extra_library_path(const char* path);
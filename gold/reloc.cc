@@ -35,6 +35,8 @@
 #include "icf.h"
 #include "compressed_output.h"
 #include "incremental.h"
+#include "reloc_cache.h"
+#include "md5.h"
 
 namespace gold
 {
@@ -626,6 +628,10 @@ Sized_relobj_file<size, big_endian>::do_relocate(const Symbol_table* symtab,
   };
   Set_output_views set_output_views(&this->output_views_, &views);
 
+  this->relocation_cache_fingerprint_.clear();
+  if (layout->relocation_cache() != NULL)
+    this->compute_relocation_cache_fingerprint(pshdrs);
+
   // Apply relocations.
 
   this->relocate_sections(symtab, layout, pshdrs, of, &views);
@@ -660,6 +666,132 @@ Sized_relobj_file<size, big_endian>::do_relocate(const Symbol_table* symtab,
 			    layout->symtab_section_offset());
 }
 
+// Append the GOT offsets of a local symbol to a buffer, for the
+// relocation cache fingerprint.
+
+class Local_got_offset_appender : public Got_offset_list::Visitor
+{
+ public:
+  Local_got_offset_appender(std::string* buf)
+    : buf_(buf)
+  { }
+
+  void
+  visit(unsigned int got_type, unsigned int got_offset, uint64_t addend)
+  {
+    this->buf_->append(reinterpret_cast<const char*>(&got_type),
+		       sizeof got_type);
+    this->buf_->append(reinterpret_cast<const char*>(&got_offset),
+		       sizeof got_offset);
+    this->buf_->append(reinterpret_cast<const char*>(&addend),
+		       sizeof addend);
+  }
+
+ private:
+  std::string* buf_;
+};
+
+// Compute the fingerprint of this object for the relocation cache.
+// This covers everything specific to this object which relocation
+// may depend upon and which the link fingerprint does not: the final
+// values of the local symbols, their GOT and PLT entries, the global
+// symbols which the relocations refer to, the relocations themselves,
+// and where discarded COMDAT sections went.  If we can not describe
+// the object this way, we leave the fingerprint empty, and its
+// sections are not cached.
+
+template<int size, bool big_endian>
+void
+Sized_relobj_file<size, big_endian>::compute_relocation_cache_fingerprint(
+    const unsigned char* pshdrs)
+{
+  // Split stack adjustments depend upon the callees, and a local
+  // symbol in a merged section has no single value.
+  if (this->uses_split_stack())
+    return;
+  for (typename Local_values::const_iterator p = this->local_values_.begin();
+       p != this->local_values_.end();
+       ++p)
+    if (!p->has_output_value())
+      return;
+
+  std::string buf;
+  unsigned int nlocals = this->local_values_.size();
+  for (unsigned int i = 0; i < nlocals; ++i)
+    {
+      Address value = this->local_values_[i].value(this, 0);
+      buf.append(reinterpret_cast<const char*>(&value), sizeof value);
+      if (this->local_has_plt_offset(i))
+	{
+	  unsigned int plt_offset = this->local_plt_offset(i);
+	  buf.append(reinterpret_cast<const char*>(&plt_offset),
+		     sizeof plt_offset);
+	}
+    }
+  Local_got_offset_appender appender(&buf);
+  this->for_all_local_got_entries(&appender);
+
+  // The values of the global symbols are covered by the link
+  // fingerprint; here we only need to know which ones we refer to.
+  for (typename Symbols::const_iterator p = this->symbols_.begin();
+       p != this->symbols_.end();
+       ++p)
+    {
+      if (*p == NULL)
+	buf.push_back('\0');
+      else
+	{
+	  buf.append((*p)->name());
+	  buf.push_back('\0');
+	  if ((*p)->version() != NULL)
+	    buf.append((*p)->version());
+	  buf.push_back('\0');
+	}
+    }
+
+  unsigned int shnum = this->shnum();
+  const unsigned char* ps = pshdrs + This::shdr_size;
+  for (unsigned int i = 1; i < shnum; ++i, ps += This::shdr_size)
+    {
+      typename This::Shdr shdr(ps);
+      unsigned int sh_type = shdr.get_sh_type();
+      if (sh_type != elfcpp::SHT_REL && sh_type != elfcpp::SHT_RELA)
+	continue;
+      section_size_type sh_size = shdr.get_sh_size();
+      const unsigned char* prelocs = this->get_view(shdr.get_sh_offset(),
+						    sh_size, true, false);
+      buf.append(reinterpret_cast<const char*>(prelocs), sh_size);
+
+      // A relocation in a debugging section against a discarded
+      // COMDAT section is resolved to the kept section.
+      unsigned int info = this->adjust_shndx(shdr.get_sh_info());
+      if (info < shnum)
+	{
+	  typename This::Shdr data_shdr(pshdrs + info * This::shdr_size);
+	  buf.append(reinterpret_cast<const char*>(&info), sizeof info);
+	  uint64_t flags = data_shdr.get_sh_flags();
+	  buf.append(reinterpret_cast<const char*>(&flags), sizeof flags);
+	}
+    }
+  for (typename Kept_comdat_section_table::const_iterator p =
+	 this->kept_comdat_sections_.begin();
+       p != this->kept_comdat_sections_.end();
+       ++p)
+    {
+      std::string name(this->section_name(p->first));
+      bool found;
+      Address value = this->map_to_kept_section(p->first, name, &found);
+      buf.append(reinterpret_cast<const char*>(&p->first), sizeof p->first);
+      buf.append(reinterpret_cast<const char*>(&value), sizeof value);
+      buf.push_back(found ? '\1' : '\0');
+    }
+
+  unsigned char digest[Relocation_cache::key_size];
+  md5_buffer(buf.data(), buf.size(), digest);
+  this->relocation_cache_fingerprint_.assign(
+      reinterpret_cast<const char*>(digest), sizeof digest);
+}
+
 // Sort a Read_multiple vector by file offset.
 struct Read_multiple_compare
 {
@@ -1000,11 +1132,41 @@ Sized_relobj_file<size, big_endian>::relocate_section_range(
 	rr = this->relocatable_relocs(i);
       relinfo.rr = rr;
 
+      // See if the relocated contents of this section are in the
+      // relocation cache.
+      Relocation_cache* cache = layout->relocation_cache();
+      unsigned char cache_key[Relocation_cache::key_size];
+      bool use_cache = (cache != NULL
+			&& !this->relocation_cache_fingerprint_.empty()
+			&& output_offset != invalid_address
+			&& reloc_map == NULL
+			&& rr == NULL
+			&& !(*pviews)[index].is_postprocessing_view);
+      if (use_cache)
+	{
+	  cache->compute_key(this->relocation_cache_fingerprint_, address,
+			     sh_type, prelocs, sh_size, view, view_size,
+			     cache_key);
+	  if (cache->lookup(cache_key, view, view_size))
+	    continue;
+	}
+
       if (!parameters->options().relocatable())
 	{
+	  // Diagnostics are not replayed from the cache, so only keep
+	  // views that were relocated without any.  The counts are
+	  // global, so a diagnostic from another thread just costs us
+	  // this cache entry.
+	  const Errors* errors = parameters->errors();
+	  const int error_count = errors->error_count();
+	  const int warning_count = errors->warning_count();
 	  target->relocate_section(&relinfo, sh_type, prelocs, reloc_count, os,
 				   output_offset == invalid_address,
 				   view, address, view_size, reloc_map);
+	  if (use_cache
+	      && errors->error_count() == error_count
+	      && errors->warning_count() == warning_count)
+	    cache->store(cache_key, view, view_size);
 	  if (parameters->options().emit_relocs())
 	    target->relocate_relocs(&relinfo, sh_type, prelocs, reloc_count,
 				    os, output_offset,
@@ -0,0 +1,444 @@
+// reloc_cache.cc -- cache relocated section contents for gold
+
+// Copyright (C) 2023 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "md5.h"
+
+#include "../bfd/bfdver.h"
+#include "parameters.h"
+#include "options.h"
+#include "target.h"
+#include "symtab.h"
+#include "object.h"
+#include "output.h"
+#include "layout.h"
+#include "digest.h"
+#include "gold-threads.h"
+#include "reloc_cache.h"
+
+// O_BINARY is only defined on some systems.
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+namespace gold
+{
+
+// Accumulate hashes of an unordered set of records, such as the
+// symbols in the symbol table, so that the result does not depend on
+// the order in which they are visited.
+
+class Unordered_fingerprint
+{
+ public:
+  Unordered_fingerprint()
+    : sum_(0), xor_(0), count_(0)
+  { }
+
+  // Add the record in BUF.
+  void
+  add(const std::string& buf)
+  {
+    unsigned char h[XXHASH64_DIGEST_SIZE];
+    xxhash64_buffer(buf.data(), buf.size(), h);
+    uint64_t v = 0;
+    for (size_t i = 0; i < XXHASH64_DIGEST_SIZE; ++i)
+      v = (v << 8) | h[i];
+    this->sum_ += v;
+    this->xor_ ^= v * 0x9E3779B97F4A7C15ULL;
+    ++this->count_;
+  }
+
+  // Add the result to an MD5 context.
+  void
+  finish(md5_ctx* ctx) const
+  {
+    md5_process_bytes(&this->sum_, sizeof this->sum_, ctx);
+    md5_process_bytes(&this->xor_, sizeof this->xor_, ctx);
+    md5_process_bytes(&this->count_, sizeof this->count_, ctx);
+  }
+
+ private:
+  uint64_t sum_;
+  uint64_t xor_;
+  uint64_t count_;
+};
+
+// Append the raw bytes of V to BUF.
+
+template<typename T>
+static inline void
+append_value(std::string* buf, T v)
+{
+  buf->append(reinterpret_cast<const char*>(&v), sizeof v);
+}
+
+// Append a string and its terminating null to BUF.
+
+static inline void
+append_string(std::string* buf, const char* s)
+{
+  if (s != NULL)
+    buf->append(s);
+  buf->push_back('\0');
+}
+
+// Append the GOT offsets of a symbol to a buffer.
+
+class Got_offset_appender : public Got_offset_list::Visitor
+{
+ public:
+  Got_offset_appender(std::string* buf)
+    : buf_(buf)
+  { }
+
+  void
+  visit(unsigned int got_type, unsigned int got_offset, uint64_t addend)
+  {
+    append_value(this->buf_, got_type);
+    append_value(this->buf_, got_offset);
+    append_value(this->buf_, addend);
+  }
+
+ private:
+  std::string* buf_;
+};
+
+// Add the state of a global symbol which relocation may depend upon to
+// an Unordered_fingerprint.
+
+template<int size>
+class Symbol_fingerprinter
+{
+ public:
+  Symbol_fingerprinter(Unordered_fingerprint* fp)
+    : fp_(fp), buf_()
+  { }
+
+  void
+  operator()(Sized_symbol<size>* sym)
+  {
+    std::string& buf(this->buf_);
+    buf.clear();
+    append_string(&buf, sym->name());
+    append_string(&buf, sym->version());
+    append_value(&buf, static_cast<uint64_t>(sym->value()));
+    append_value(&buf, static_cast<uint64_t>(sym->symsize()));
+    unsigned int flags = ((sym->type() << 24)
+			  | (sym->binding() << 16)
+			  | (sym->visibility() << 8)
+			  | (sym->is_defined() ? 1 : 0)
+			  | (sym->is_undefined() ? 2 : 0)
+			  | (sym->is_from_dynobj() ? 4 : 0)
+			  | (sym->is_forced_local() ? 8 : 0)
+			  | (sym->needs_dynsym_entry() ? 16 : 0)
+			  | (sym->has_dynsym_index() ? 32 : 0));
+    append_value(&buf, flags);
+    append_value(&buf, sym->nonvis());
+    if (sym->has_plt_offset())
+      append_value(&buf, sym->plt_offset());
+    if (sym->has_dynsym_index())
+      append_value(&buf, sym->dynsym_index());
+    const Got_offset_list* got = sym->got_offset_list();
+    if (got != NULL)
+      {
+	Got_offset_appender appender(&buf);
+	got->for_all_got_offsets(&appender);
+      }
+    this->fp_->add(buf);
+  }
+
+ private:
+  Unordered_fingerprint* fp_;
+  std::string buf_;
+};
+
+// Class Relocation_cache.
+
+Relocation_cache::Relocation_cache(const char* dirname)
+  : dirname_(dirname), enabled_(true), lock_(new Lock()),
+    hits_(0), misses_(0), stores_(0)
+{
+  memset(this->link_fingerprint_, 0, key_size);
+  if (::mkdir(dirname, 0777) < 0 && errno != EEXIST)
+    {
+      gold_warning(_("cannot create relocation cache directory %s: %s"),
+		   dirname, strerror(errno));
+      this->enabled_ = false;
+    }
+}
+
+Relocation_cache::~Relocation_cache()
+{
+  delete this->lock_;
+}
+
+// Return whether the cache can be used for this link.
+
+bool
+Relocation_cache::is_usable()
+{
+  const General_options& options(parameters->options());
+  return (!options.relocatable()
+	  && !options.emit_relocs()
+	  && !parameters->incremental()
+	  && !parameters->target().may_relax());
+}
+
+// Compute the fingerprint of the link.
+
+void
+Relocation_cache::compute_link_fingerprint(const Symbol_table* symtab,
+					   const Layout* layout)
+{
+  if (parameters->target().get_size() == 32)
+    {
+#if defined(HAVE_TARGET_32_LITTLE) || defined(HAVE_TARGET_32_BIG)
+      this->sized_compute_link_fingerprint<32>(symtab, layout);
+#else
+      gold_unreachable();
+#endif
+    }
+  else if (parameters->target().get_size() == 64)
+    {
+#if defined(HAVE_TARGET_64_LITTLE) || defined(HAVE_TARGET_64_BIG)
+      this->sized_compute_link_fingerprint<64>(symtab, layout);
+#else
+      gold_unreachable();
+#endif
+    }
+  else
+    gold_unreachable();
+}
+
+template<int size>
+void
+Relocation_cache::sized_compute_link_fingerprint(const Symbol_table* symtab,
+						 const Layout* layout)
+{
+  md5_ctx ctx;
+  md5_init_ctx(&ctx);
+
+  // The linker version and the kind of output.
+  std::string buf;
+  append_string(&buf, BFD_VERSION_STRING);
+  append_string(&buf, get_version_string());
+  const Target& target(parameters->target());
+  append_value(&buf, target.machine_code());
+  append_value(&buf, target.get_size());
+  append_value(&buf, target.is_big_endian());
+  const General_options& options(parameters->options());
+  append_value(&buf, options.shared());
+  append_value(&buf, options.pie());
+  append_value(&buf, parameters->options().output_is_position_independent());
+  md5_process_bytes(buf.data(), buf.size(), &ctx);
+
+  // The output sections.
+  const Layout::Section_list& sections(layout->section_list());
+  for (Layout::Section_list::const_iterator p = sections.begin();
+       p != sections.end();
+       ++p)
+    {
+      const Output_section* os = *p;
+      buf.clear();
+      append_string(&buf, os->name());
+      append_value(&buf, static_cast<uint64_t>(os->is_address_valid()
+					       ? os->address()
+					       : -1ULL));
+      append_value(&buf, static_cast<uint64_t>(os->is_offset_valid()
+					       ? os->offset()
+					       : -1ULL));
+      append_value(&buf, static_cast<uint64_t>(os->is_data_size_valid()
+					       ? os->data_size()
+					       : -1ULL));
+      md5_process_bytes(buf.data(), buf.size(), &ctx);
+    }
+
+  // The global symbols, in whatever order the symbol table holds them.
+  Unordered_fingerprint symbols;
+  symtab->for_all_symbols<size>(Symbol_fingerprinter<size>(&symbols));
+  symbols.finish(&ctx);
+
+  md5_finish_ctx(&ctx, this->link_fingerprint_);
+}
+
+// Compute the key for a section.
+
+void
+Relocation_cache::compute_key(const std::string& object_fingerprint,
+			      uint64_t address, unsigned int sh_type,
+			      const unsigned char* prelocs, size_t relocs_size,
+			      const unsigned char* view,
+			      section_size_type view_size,
+			      unsigned char* key) const
+{
+  md5_ctx ctx;
+  md5_init_ctx(&ctx);
+  md5_process_bytes(this->link_fingerprint_, key_size, &ctx);
+  md5_process_bytes(object_fingerprint.data(), object_fingerprint.size(),
+		    &ctx);
+  md5_process_bytes(&address, sizeof address, &ctx);
+  md5_process_bytes(&sh_type, sizeof sh_type, &ctx);
+  uint64_t sizes[2];
+  sizes[0] = relocs_size;
+  sizes[1] = view_size;
+  md5_process_bytes(sizes, sizeof sizes, &ctx);
+  md5_process_bytes(prelocs, relocs_size, &ctx);
+  md5_process_bytes(view, view_size, &ctx);
+  md5_finish_ctx(&ctx, key);
+}
+
+// Return the name of the file which holds KEY.
+
+std::string
+Relocation_cache::filename(const unsigned char* key) const
+{
+  static const char hex[] = "0123456789abcdef";
+  std::string name(this->dirname_);
+  name += '/';
+  for (size_t i = 0; i < key_size; ++i)
+    {
+      name += hex[key[i] >> 4];
+      name += hex[key[i] & 0xf];
+    }
+  return name;
+}
+
+// Look up KEY, copying the cached contents to VIEW.
+
+bool
+Relocation_cache::lookup(const unsigned char* key, unsigned char* view,
+			 section_size_type view_size)
+{
+  if (!this->enabled_)
+    return false;
+
+  bool found = false;
+  std::string name(this->filename(key));
+  int o = ::open(name.c_str(), O_RDONLY | O_BINARY);
+  if (o >= 0)
+    {
+      struct stat st;
+      if (::fstat(o, &st) == 0
+	  && st.st_size == static_cast<off_t>(view_size))
+	{
+	  // Read into a temporary buffer, so that a short read does not
+	  // leave VIEW half overwritten.
+	  unsigned char* buf = new unsigned char[view_size];
+	  section_size_type got = 0;
+	  while (got < view_size)
+	    {
+	      ssize_t r = ::read(o, buf + got, view_size - got);
+	      if (r <= 0)
+		break;
+	      got += r;
+	    }
+	  if (got == view_size)
+	    {
+	      memcpy(view, buf, view_size);
+	      found = true;
+	    }
+	  delete[] buf;
+	}
+      ::close(o);
+    }
+
+  Hold_lock hl(*this->lock_);
+  if (found)
+    ++this->hits_;
+  else
+    ++this->misses_;
+  return found;
+}
+
+// Store the relocated contents in VIEW under KEY.  We write to a
+// temporary file and rename it, so that links running at the same
+// time never see a partial entry.
+
+void
+Relocation_cache::store(const unsigned char* key, const unsigned char* view,
+			section_size_type view_size)
+{
+  if (!this->enabled_)
+    return;
+
+  std::string name(this->filename(key));
+  char suffix[64];
+  snprintf(suffix, sizeof suffix, ".tmp%ld.%p",
+	   static_cast<long>(getpid()), static_cast<const void*>(view));
+  std::string tmpname(name + suffix);
+
+  int o = ::open(tmpname.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY,
+		 0666);
+  bool ok = o >= 0;
+  section_size_type written = 0;
+  while (ok && written < view_size)
+    {
+      ssize_t w = ::write(o, view + written, view_size - written);
+      if (w <= 0)
+	ok = false;
+      else
+	written += w;
+    }
+  if (o >= 0 && ::close(o) < 0)
+    ok = false;
+  if (ok && ::rename(tmpname.c_str(), name.c_str()) < 0)
+    ok = false;
+
+  if (!ok)
+    {
+      int err = errno;
+      ::unlink(tmpname.c_str());
+      Hold_lock hl(*this->lock_);
+      if (this->enabled_)
+	{
+	  gold_warning(_("cannot write relocation cache entry %s: %s"),
+		       name.c_str(), strerror(err));
+	  this->enabled_ = false;
+	}
+      return;
+    }
+
+  Hold_lock hl(*this->lock_);
+  ++this->stores_;
+}
+
+// Print statistics to stderr.
+
+void
+Relocation_cache::print_stats() const
+{
+  fprintf(stderr, _("%s: relocation cache hits: %u\n"),
+	  program_name, this->hits_);
+  fprintf(stderr, _("%s: relocation cache misses: %u\n"),
+	  program_name, this->misses_);
+  fprintf(stderr, _("%s: relocation cache stores: %u\n"),
+	  program_name, this->stores_);
+}
+
+} // End namespace gold.
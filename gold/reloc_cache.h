@@ -0,0 +1,131 @@
+// reloc_cache.h -- cache relocated section contents for gold   -*- C++ -*-
+
+// Copyright (C) 2023 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#ifndef GOLD_RELOC_CACHE_H
+#define GOLD_RELOC_CACHE_H
+
+#include <string>
+
+namespace gold
+{
+
+class Lock;
+class Symbol_table;
+class Layout;
+
+// A content addressed cache of relocated input sections, enabled by
+// --relocation-cache=DIR.  When the same binary is linked repeatedly
+// with mostly identical inputs, the relocated contents of unchanged
+// input sections are copied from the cache rather than being
+// relocated again.
+
+// The key of a cached section is a hash of everything that the
+// relocated contents depend upon: the section contents and its
+// relocations, its output address, a fingerprint of the object which
+// covers its local symbol values and GOT and PLT entries, and a
+// fingerprint of the link which covers the final values and GOT and
+// PLT entries of all global symbols and the addresses of all output
+// sections.  Any change in layout or symbol resolution thus changes
+// the key, and the section is relocated again.
+
+class Relocation_cache
+{
+ public:
+  // The size of a cache key and of a fingerprint.
+  static const size_t key_size = 16;
+
+  Relocation_cache(const char* dirname);
+
+  ~Relocation_cache();
+
+  // Return whether the cache can be used for this link.  It can not
+  // be used for relocatable or incremental links, with
+  // --emit-relocs, or when the target may relax sections or add
+  // stubs, since then the relocated contents depend on more than the
+  // key describes.
+  static bool
+  is_usable();
+
+  // Compute the fingerprint of the link.  This must be called after
+  // the final symbol values and output section addresses are known,
+  // and before any section is relocated.
+  void
+  compute_link_fingerprint(const Symbol_table*, const Layout*);
+
+  // Compute the key for a section.  OBJECT_FINGERPRINT is the
+  // fingerprint of the object holding the section.  ADDRESS is the
+  // output address of the section, and VIEW holds its contents before
+  // relocation.  PRELOCS holds the relocations, of type SH_TYPE.
+  // The key is stored in KEY, which must have KEY_SIZE bytes.
+  void
+  compute_key(const std::string& object_fingerprint, uint64_t address,
+	      unsigned int sh_type, const unsigned char* prelocs,
+	      size_t relocs_size, const unsigned char* view,
+	      section_size_type view_size, unsigned char* key) const;
+
+  // Look up KEY.  If found, copy the relocated contents to VIEW and
+  // return true.
+  bool
+  lookup(const unsigned char* key, unsigned char* view,
+	 section_size_type view_size);
+
+  // Store the relocated contents in VIEW under KEY.
+  void
+  store(const unsigned char* key, const unsigned char* view,
+	section_size_type view_size);
+
+  // Print statistics to stderr.
+  void
+  print_stats() const;
+
+ private:
+  // This class can not be copied.
+  Relocation_cache(const Relocation_cache&);
+  Relocation_cache& operator=(const Relocation_cache&);
+
+  // Return the name of the file which holds KEY.
+  std::string
+  filename(const unsigned char* key) const;
+
+  template<int size>
+  void
+  sized_compute_link_fingerprint(const Symbol_table*, const Layout*);
+
+  // The cache directory.
+  std::string dirname_;
+  // The fingerprint of the link.
+  unsigned char link_fingerprint_[key_size];
+  // Whether the cache is still usable.  We stop using it after an
+  // error writing to it.
+  bool enabled_;
+  // Protects the fields below.
+  Lock* lock_;
+  // The number of sections found in the cache.
+  unsigned int hits_;
+  // The number of sections not found in the cache.
+  unsigned int misses_;
+  // The number of sections written to the cache.
+  unsigned int stores_;
+};
+
+} // End namespace gold.
+
+#endif // !defined(GOLD_RELOC_CACHE_H)
@@ -0,0 +1,87 @@
+#!/bin/sh
+
+# build_id_digest_test.sh -- check --build-id=sha256 against sha256sum
+
+# Copyright (C) 2023 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# --build-id=sha256 is the SHA-256 of the output file with the
+# build-id descriptor still zero.  When the file is hashed in chunks
+# it is instead the SHA-256 of the concatenated SHA-256s of the
+# chunks.  Recompute both with sha256sum and compare them with the
+# build-id that readelf reports.  build_id_digest_test_whole is
+# hashed as a whole; build_id_digest_test_tree in 4096-byte chunks.
+
+LC_ALL=C
+export LC_ALL
+
+if ! sha256sum /dev/null > /dev/null 2>&1; then
+  echo "sha256sum not available; skipping test"
+  exit 77
+fi
+
+# Convert a string of hex digits on stdin to binary.
+unhex()
+{
+  awk '{
+    for (i = 1; i < length($0); i += 2)
+      printf "%c", (index("0123456789abcdef", substr($0, i, 1)) - 1) * 16 \
+		   + index("0123456789abcdef", substr($0, i + 1, 1)) - 1
+  }'
+}
+
+# Write a copy of $1 to $2 with the build-id descriptor cleared,
+# reading the section headers and notes from $1.stdout.
+clear_build_id()
+{
+  off=`sed -n -e 's/^.*\.note\.gnu\.build-id *NOTE *[0-9a-f]* *\([0-9a-f]*\) .*$/\1/p' $1.stdout`
+  if test -z "$off"; then
+    echo "no .note.gnu.build-id in $1"
+    exit 1
+  fi
+  cp $1 $2
+  # The descriptor follows the 12-byte note header and "GNU\0".
+  dd if=/dev/zero of=$2 bs=1 seek=$((0x$off + 16)) count=32 \
+     conv=notrunc 2> /dev/null
+}
+
+check()
+{
+  want=`sed -n -e 's/^.*Build ID: *\([0-9a-f]*\).*$/\1/p' $1.stdout`
+  if test "$want" != "$2"; then
+    echo "build-id of $1 is $want"
+    echo "expected $2"
+    exit 1
+  fi
+}
+
+clear_build_id build_id_digest_test_whole build_id_digest_test.tmp
+check build_id_digest_test_whole \
+  `sha256sum < build_id_digest_test.tmp | cut -c1-64`
+
+clear_build_id build_id_digest_test_tree build_id_digest_test.tmp
+rm -f build_id_digest_test.chunk.*
+split -b 4096 -a 4 build_id_digest_test.tmp build_id_digest_test.chunk.
+check build_id_digest_test_tree \
+  `for f in build_id_digest_test.chunk.*; do
+     sha256sum < $f | cut -c1-64
+   done | tr -d '\n' | unhex | sha256sum | cut -c1-64`
+
+rm -f build_id_digest_test.tmp build_id_digest_test.chunk.*
+exit 0
@@ -0,0 +1,109 @@
+// digest_unittest.cc -- test sha256_buffer and xxhash64_buffer
+
+// Copyright (C) 2023 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "digest.h"
+
+#include "test.h"
+
+namespace gold_testsuite
+{
+
+using namespace gold;
+
+// Return the digest of LEN bytes at BUFFER as a hex string.
+
+static std::string
+hex_digest(void* (*hash)(const char*, size_t, void*), size_t digest_size,
+	   const char* buffer, size_t len)
+{
+  unsigned char digest[64];
+  hash(buffer, len, digest);
+  std::string ret;
+  for (size_t i = 0; i < digest_size; ++i)
+    {
+      char buf[3];
+      snprintf(buf, sizeof buf, "%02x", digest[i]);
+      ret += buf;
+    }
+  return ret;
+}
+
+static std::string
+sha256(const std::string& s)
+{
+  return hex_digest(sha256_buffer, SHA256_DIGEST_SIZE, s.data(), s.size());
+}
+
+static std::string
+xxhash64(const std::string& s)
+{
+  return hex_digest(xxhash64_buffer, XXHASH64_DIGEST_SIZE, s.data(),
+		    s.size());
+}
+
+// The SHA-256 vectors are from FIPS 180-4; the million 'a' string
+// crosses many blocks.
+
+bool
+Sha256_test(Test_report*)
+{
+  CHECK(sha256("")
+	== "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  CHECK(sha256("abc")
+	== "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  CHECK(sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")
+	== "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  CHECK(sha256(std::string(1000000, 'a'))
+	== "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+  return true;
+}
+
+// The XXH64 vectors are from the reference implementation.  The
+// short strings take the tail paths only; the longer ones go through
+// the 32-byte stripe loop as well.
+
+bool
+Xxhash64_test(Test_report*)
+{
+  CHECK(xxhash64("") == "ef46db3751d8e999");
+  CHECK(xxhash64("a") == "d24ec4f1a98c6e5b");
+  CHECK(xxhash64("abc") == "44bc2cf5ad770999");
+  CHECK(xxhash64("Nobody inspects the spammish repetition")
+	== "fbcea83c8a378bf1");
+
+  std::string bytes;
+  for (int i = 0; i < 4 * 256; ++i)
+    bytes += static_cast<char>(i & 0xff);
+  bytes += "xyz";
+  CHECK(xxhash64(bytes) == "e146cb31b65bc21a");
+  return true;
+}
+
+Register_test sha256_register("SHA256", Sha256_test);
+Register_test xxhash64_register("XXHASH64", Xxhash64_test);
+
+} // End namespace gold_testsuite.
@@ -52,6 +52,18 @@ struct sym_info
 static struct claimed_file* first_claimed_file = NULL;
 static struct claimed_file* last_claimed_file = NULL;
 
+/* With the option "add_input_buffer", the new input files are read
+   into memory and added with the add_input_buffer interface.  The
+   buffers are freed by the cleanup hook.  */
+
+struct input_buffer
+{
+  void* data;
+  struct input_buffer* next;
+};
+
+static struct input_buffer* first_input_buffer = NULL;
+
 static ld_plugin_register_claim_file register_claim_file_hook = NULL;
 static ld_plugin_register_all_symbols_read register_all_symbols_read_hook = NULL;
 static ld_plugin_register_cleanup register_cleanup_hook = NULL;
@@ -60,6 +72,7 @@ static ld_plugin_get_symbols get_symbols = NULL;
 static ld_plugin_get_symbols get_symbols_v2 = NULL;
 static ld_plugin_get_symbols get_symbols_v3 = NULL;
 static ld_plugin_add_input_file add_input_file = NULL;
+static ld_plugin_add_input_buffer add_input_buffer = NULL;
 static ld_plugin_message message = NULL;
 static ld_plugin_get_input_file get_input_file = NULL;
 static ld_plugin_release_input_file release_input_file = NULL;
@@ -83,6 +96,8 @@ enum ld_plugin_status all_symbols_read_hook(void);
 enum ld_plugin_status cleanup_hook(void);
 
 static void parse_readelf_line(char*, struct sym_info*);
+static int use_input_buffers(void);
+static enum ld_plugin_status add_new_input_buffer(const char*);
 
 enum ld_plugin_status
 onload(struct ld_plugin_tv *tv)
@@ -163,6 +178,9 @@ onload(struct ld_plugin_tv *tv)
 	case LDPT_GET_WRAP_SYMBOLS:
 	  get_wrap_symbols = *entry->tv_u.tv_get_wrap_symbols;
 	  break;
+	case LDPT_ADD_INPUT_BUFFER:
+	  add_input_buffer = *entry->tv_u.tv_add_input_buffer;
+	  break;
         default:
           break;
         }
@@ -622,6 +640,12 @@ all_symbols_read_hook(void)
         }
       p[1] = 'o';
       p[2] = '\0';
+      if (use_input_buffers())
+        {
+          if (add_new_input_buffer(buf) != LDPS_OK)
+            return LDPS_ERR;
+          continue;
+        }
       (*message)(LDPL_INFO, "%s: adding new input file", buf);
       (*add_input_file)(buf);
     }
@@ -632,10 +656,71 @@ all_symbols_read_hook(void)
 enum ld_plugin_status
 cleanup_hook(void)
 {
+  while (first_input_buffer != NULL)
+    {
+      struct input_buffer* next = first_input_buffer->next;
+      free(first_input_buffer->data);
+      free(first_input_buffer);
+      first_input_buffer = next;
+    }
+
   (*message)(LDPL_INFO, "cleanup hook called");
   return LDPS_OK;
 }
 
+/* Return whether the new input files should be added from memory.  */
+
+static int
+use_input_buffers(void)
+{
+  int i;
+
+  for (i = 0; i < nopts; ++i)
+    if (strcmp(opts[i], "add_input_buffer") == 0)
+      return 1;
+  return 0;
+}
+
+/* Read the file NAME into memory and add it with add_input_buffer.  */
+
+static enum ld_plugin_status
+add_new_input_buffer(const char* name)
+{
+  FILE* f;
+  long size;
+  struct input_buffer* ib;
+
+  if (add_input_buffer == NULL)
+    {
+      fprintf(stderr, "tv_add_input_buffer interface missing\n");
+      return LDPS_ERR;
+    }
+
+  f = fopen(name, "rb");
+  if (f == NULL
+      || fseek(f, 0, SEEK_END) != 0
+      || (size = ftell(f)) < 0
+      || fseek(f, 0, SEEK_SET) != 0)
+    {
+      (*message)(LDPL_FATAL, "%s: can't read new input file", name);
+      return LDPS_ERR;
+    }
+
+  ib = malloc(sizeof *ib);
+  ib->data = malloc(size);
+  if (fread(ib->data, 1, size, f) != (size_t) size)
+    {
+      (*message)(LDPL_FATAL, "%s: can't read new input file", name);
+      return LDPS_ERR;
+    }
+  fclose(f);
+  ib->next = first_input_buffer;
+  first_input_buffer = ib;
+
+  (*message)(LDPL_INFO, "%s: adding new input buffer", name);
+  return (*add_input_buffer)(ib->data, size, name);
+}
+
 static void
 parse_readelf_line(char* p, struct sym_info* info)
 {
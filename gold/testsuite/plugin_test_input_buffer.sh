@@ -0,0 +1,44 @@
+#!/bin/sh
+
+# plugin_test_input_buffer.sh -- a test case for the plugin API.
+
+# Copyright (C) 2023 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+
+# This file goes with plugin_test.c, a simple plug-in library that
+# exercises the basic interfaces.  Here it adds the new input files
+# from memory with the add_input_buffer interface.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check plugin_test_input_buffer.err "option: add_input_buffer"
+check plugin_test_input_buffer.err "two_file_test_1.o.syms: claim file hook called"
+check plugin_test_input_buffer.err "two_file_test_1.o: adding new input buffer"
+check plugin_test_input_buffer.err "two_file_test_1b.o: adding new input buffer"
+check plugin_test_input_buffer.err "two_file_test_2.o: adding new input buffer"
+check plugin_test_input_buffer.err "cleanup hook called"
+
+exit 0
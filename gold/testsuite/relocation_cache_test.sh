@@ -0,0 +1,46 @@
+#!/bin/sh
+
+# relocation_cache_test.sh -- a test case for --relocation-cache
+
+# Copyright (C) 2023 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# undef_symbol_main.o and undef_symbol.o are linked twice with the
+# same --relocation-cache directory.  The undefined reference to 'a'
+# is only diagnosed while relocating, so a section relocated with an
+# error must not be stored in the cache: the second link has to fail
+# just like the first.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected error in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual error output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check relocation_cache_test_1.err "error: undefined reference to 'a'"
+check relocation_cache_test_2.err "error: undefined reference to 'a'"
+
+exit 0
@@ -733,6 +733,10 @@ struct bfd_link_info
   /* The maximum cache size.  Backend can use cache_size and and
      max_cache_size to decide if keep_memory should be honored.  */
   bfd_size_type max_cache_size;
+
+  /* The number of threads the linker may use, or 0 or 1 to do all
+     the work on the calling thread.  */
+  unsigned int threads;
 };
 
 /* Some forward-definitions used by some callbacks.  */
@@ -877,6 +881,11 @@ struct bfd_link_callbacks
      the output BFD named .ctf or a name beginning with ".ctf.".  */
   void (*emit_ctf)
     (void);
+  /* This callback is called at the start, when START is TRUE, and at
+     the end of a phase of the link named PHASE.  ABFD is the input bfd
+     the phase works on, or NULL.  It may be NULL.  */
+  void (*trace_phase)
+    (const char *phase, bfd *abfd, bool start);
 };
 
 /* The linker builds link_order structures which tell the code how to
@@ -344,6 +344,16 @@ typedef
 enum ld_plugin_status
 (*ld_plugin_add_input_file) (const char *pathname);
 
+/* The linker's interface for adding a compiled input file which is
+   held in memory, so that it need not be written to a temporary file.
+   NAME is used in diagnostics and in the map file.  The SIZE bytes at
+   BUFFER must remain valid until the cleanup hook has been called.  */
+
+typedef
+enum ld_plugin_status
+(*ld_plugin_add_input_buffer) (const void *buffer, size_t size,
+                               const char *name);
+
 /* The linker's interface for adding a library that should be searched.  */
 
 typedef
@@ -568,7 +578,8 @@ enum ld_plugin_tag
   LDPT_GET_WRAP_SYMBOLS,
   LDPT_ADD_SYMBOLS_V2,
   LDPT_GET_API_VERSION,
-  LDPT_REGISTER_CLAIM_FILE_HOOK_V2
+  LDPT_REGISTER_CLAIM_FILE_HOOK_V2,
+  LDPT_ADD_INPUT_BUFFER
 };
 
 /* The plugin transfer vector.  */
@@ -606,6 +617,7 @@ struct ld_plugin_tv
     ld_plugin_register_new_input tv_register_new_input;
     ld_plugin_get_wrap_symbols tv_get_wrap_symbols;
     ld_plugin_get_api_version tv_get_api_version;
+    ld_plugin_add_input_buffer tv_add_input_buffer;
   } tv_u;
 };
 
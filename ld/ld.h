@@ -74,6 +74,10 @@
    discarded.  */
 #define DISCARD_SECTION_NAME "/DISCARD/"
 
+/* The size of the stdio buffer used for map files, which are written
+   a few bytes at a time.  */
+#define MAP_FILE_BUFFER_SIZE (1024 * 1024)
+
 /* A file name list.  */
 typedef struct name_list
 {
@@ -289,6 +293,12 @@ typedef struct
   char *map_filename;
   FILE *map_file;
 
+  /* The file for --map-json, if any.  */
+  char *map_json_filename;
+
+  /* The file for --time-trace, if any.  */
+  char *time_trace_filename;
+
   char *dependency_file;
 
   unsigned int split_by_reloc;
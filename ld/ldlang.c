@@ -93,6 +93,7 @@ static void print_statement_list (lang_statement_union_type *,
 				  lang_output_section_statement_type *);
 static void print_statements (void);
 static void print_input_section (asection *, bool);
+static void free_map_locals (void);
 static bool lang_one_common (struct bfd_link_hash_entry *, void *);
 static void lang_record_phdrs (void);
 static void lang_do_version_exports_section (void);
@@ -405,18 +406,14 @@ add_matching_section (lang_wild_statement_type *ptr,
   new_section->input_stmt = file;
 }
 
-/* Process section S (from input file FILE) in relation to wildcard
-   statement PTR.  We already know that a prefix of the name of S matches
-   some wildcard in PTR's wildcard list.  Here we check if the filename
-   matches as well (if it's specified) and if any of the wildcards in fact
-   does match.  */
+/* Return true if input file FILE is one that wildcard statement PTR
+   applies to: if the filename matches (if it's specified) and FILE
+   isn't excluded.  */
 
-static void
-walk_wild_section_match (lang_wild_statement_type *ptr,
-			 lang_input_statement_type *file,
-			 asection *s)
+static bool
+walk_wild_file_match (lang_wild_statement_type *ptr,
+		      lang_input_statement_type *file)
 {
-  struct wildcard_list *sec;
   const char *file_spec = ptr->filename;
   char *p;
 
@@ -426,12 +423,12 @@ walk_wild_section_match (lang_wild_statement_type *ptr,
   else if ((p = archive_path (file_spec)) != NULL)
     {
       if (!input_statement_is_archive_path (file_spec, p, file))
-	return;
+	return false;
     }
   else if (wildcardp (file_spec))
     {
       if (fnmatch (file_spec, file->filename, 0) != 0)
-	return;
+	return false;
     }
   else
     {
@@ -458,12 +455,24 @@ walk_wild_section_match (lang_wild_statement_type *ptr,
 	       && filename_cmp (arch_is->local_sym_name, file_spec) == 0)
 	;
       else
-	return;
+	return false;
     }
 
   /* If filename is excluded we're done.  */
-  if (walk_wild_file_in_exclude_list (ptr->exclude_name_list, file))
-    return;
+  return !walk_wild_file_in_exclude_list (ptr->exclude_name_list, file);
+}
+
+/* Process section S (from input file FILE) in relation to wildcard
+   statement PTR.  We already know that a prefix of the name of S matches
+   some wildcard in PTR's wildcard list, and that PTR applies to FILE.
+   Here we check if any of the wildcards in fact does match.  */
+
+static void
+walk_wild_section_match (lang_wild_statement_type *ptr,
+			 lang_input_statement_type *file,
+			 asection *s)
+{
+  struct wildcard_list *sec;
 
   /* Check section name against each wildcard spec.  If there's no
      wildcard all sections match.  */
@@ -924,6 +933,14 @@ analyze_walk_wild_section_handler (lang_wild_statement_type *ptr)
   insert_prefix_tree (ptr);
 }
 
+/* Counters for resolve_wild_sections, bumped for each input file and
+   each section it looks at.  A wild statement records the values
+   current when it last saw a file or section, so that the work of
+   matching the file name is done only once per file, and so that a
+   statement reached through more than one of its patterns is only
+   processed once per section.  */
+static unsigned long resolve_file_visit, resolve_section_visit;
+
 /* Match all sections from FILE against the global prefix tree,
    and record them into each wild statement that has a match.  */
 
@@ -935,12 +952,14 @@ resolve_wild_sections (lang_input_statement_type *file)
   if (file->flags.just_syms)
     return;
 
+  ++resolve_file_visit;
   for (s = file->the_bfd->sections; s != NULL; s = s->next)
     {
       const char *sname = bfd_section_name (s);
       char c = 1;
       struct prefixtree *t = ptroot;
       //printf (" YYY consider %s of %s\n", sname, file->the_bfd->filename);
+      ++resolve_section_visit;
       do
 	{
 	  if (t->stmt)
@@ -948,7 +967,18 @@ resolve_wild_sections (lang_input_statement_type *file)
 	      struct wild_stmt_list *sl;
 	      for (sl = t->stmt; sl; sl = sl->next)
 		{
-		  walk_wild_section_match (sl->stmt, file, s);
+		  lang_wild_statement_type *stmt = sl->stmt;
+
+		  if (stmt->section_visit == resolve_section_visit)
+		    continue;
+		  stmt->section_visit = resolve_section_visit;
+		  if (stmt->file_visit != resolve_file_visit)
+		    {
+		      stmt->file_visit = resolve_file_visit;
+		      stmt->file_match = walk_wild_file_match (stmt, file);
+		    }
+		  if (stmt->file_match)
+		    walk_wild_section_match (stmt, file, s);
 		  //printf ("   ZZZ maybe place into %p\n", sl->stmt);
 		}
 	    }
@@ -2369,6 +2399,8 @@ lang_map (void)
 
   ldemul_extra_map_file_text (link_info.output_bfd, &link_info,
 			      config.map_file);
+
+  free_map_locals ();
 }
 
 static bool
@@ -2403,6 +2435,354 @@ sort_def_symbol (struct bfd_link_hash_entry *hash_entry,
   return true;
 }
 
+/* The link map written by --map-json.  lang_map_json_start gathers
+   the layout of the output file, then formats and writes it on
+   another thread with --threads while the text map and cross
+   reference table are printed.  lang_map_json_finish waits for it.  */
+
+struct json_map_symbol
+{
+  unsigned int section_id;
+  bfd_vma value;
+  const char *name;
+};
+
+struct json_map_input
+{
+  asection *section;
+  bfd_vma addr;
+};
+
+struct json_map_output
+{
+  asection *section;
+  /* The input sections of this output section, in address order.  */
+  size_t first_input;
+  size_t input_count;
+};
+
+static struct
+{
+  FILE *file;
+  struct json_map_output *outputs;
+  size_t output_count, output_alloc;
+  struct json_map_input *inputs;
+  size_t input_count, input_alloc;
+  struct json_map_input *discarded;
+  size_t discarded_count, discarded_alloc;
+  struct json_map_symbol *symbols;
+  size_t symbol_count, symbol_alloc;
+  struct bfd_parallel_work *work;
+} json_map;
+
+static void
+json_map_add_input (struct json_map_input **list, size_t *count,
+		    size_t *alloc, asection *sec, bfd_vma addr)
+{
+  if (*count == *alloc)
+    {
+      *alloc = *alloc * 2 + 64;
+      *list = xrealloc (*list, *alloc * sizeof (**list));
+    }
+  (*list)[*count].section = sec;
+  (*list)[*count].addr = addr;
+  ++*count;
+}
+
+/* Record the output sections and their input sections found in the
+   statement list S, in the order the text map shows them.  */
+
+static void
+json_map_gather (lang_statement_union_type *s,
+		 lang_output_section_statement_type *os)
+{
+  for (; s != NULL; s = s->header.next)
+    switch (s->header.type)
+      {
+      case lang_output_section_statement_enum:
+	if (s->output_section_statement.bfd_section != NULL
+	    && &s->output_section_statement != abs_output_section)
+	  {
+	    struct json_map_output *out;
+
+	    if (json_map.output_count == json_map.output_alloc)
+	      {
+		json_map.output_alloc = json_map.output_alloc * 2 + 16;
+		json_map.outputs
+		  = xrealloc (json_map.outputs,
+			      json_map.output_alloc * sizeof (*out));
+	      }
+	    out = &json_map.outputs[json_map.output_count++];
+	    out->section = s->output_section_statement.bfd_section;
+	    out->first_input = json_map.input_count;
+	    json_map_gather (s->output_section_statement.children.head,
+			     &s->output_section_statement);
+	    json_map.outputs[json_map.output_count - 1].input_count
+	      = json_map.input_count - out->first_input;
+	  }
+	break;
+      case lang_wild_statement_enum:
+	json_map_gather (s->wild_statement.children.head, os);
+	break;
+      case lang_group_statement_enum:
+	json_map_gather (s->group_statement.children.head, os);
+	break;
+      case lang_constructors_statement_enum:
+	json_map_gather (constructor_list.head, os);
+	break;
+      case lang_input_section_enum:
+	{
+	  asection *i = s->input_section.section;
+
+	  if (os != NULL
+	      && os->bfd_section != NULL
+	      && i->output_section == os->bfd_section)
+	    json_map_add_input (&json_map.inputs, &json_map.input_count,
+				&json_map.input_alloc, i,
+				i->output_section->vma + i->output_offset);
+	}
+	break;
+      default:
+	break;
+      }
+}
+
+static bool
+json_map_gather_symbol (struct bfd_link_hash_entry *h,
+			void *info ATTRIBUTE_UNUSED)
+{
+  if ((h->type == bfd_link_hash_defined
+       || h->type == bfd_link_hash_defweak)
+      && h->u.def.section->owner != link_info.output_bfd
+      && h->u.def.section->owner != NULL
+      && h->u.def.section->output_section != NULL)
+    {
+      struct json_map_symbol *sym;
+
+      if (json_map.symbol_count == json_map.symbol_alloc)
+	{
+	  json_map.symbol_alloc = json_map.symbol_alloc * 2 + 1024;
+	  json_map.symbols = xrealloc (json_map.symbols,
+				       json_map.symbol_alloc * sizeof (*sym));
+	}
+      sym = &json_map.symbols[json_map.symbol_count++];
+      sym->section_id = h->u.def.section->id;
+      sym->value = h->u.def.value;
+      sym->name = h->root.string;
+    }
+  return true;
+}
+
+static int
+json_map_symbol_cmp (const void *a, const void *b)
+{
+  const struct json_map_symbol *l = (const struct json_map_symbol *) a;
+  const struct json_map_symbol *r = (const struct json_map_symbol *) b;
+
+  if (l->section_id != r->section_id)
+    return l->section_id < r->section_id ? -1 : 1;
+  if (l->value != r->value)
+    return l->value < r->value ? -1 : 1;
+  return strcmp (l->name, r->name);
+}
+
+/* Write S to the JSON map as a string.  */
+
+static void
+json_map_string (const char *s)
+{
+  print_json_string (json_map.file, s);
+}
+
+/* Write the name of the file containing input section SEC.  */
+
+static void
+json_map_file_name (asection *sec)
+{
+  bfd *abfd = sec->owner;
+
+  if (abfd->my_archive != NULL
+      && !bfd_is_thin_archive (abfd->my_archive))
+    {
+      char *name = concat (bfd_get_filename (abfd->my_archive), "(",
+			   bfd_get_filename (abfd), ")", NULL);
+      json_map_string (name);
+      free (name);
+    }
+  else
+    json_map_string (bfd_get_filename (abfd));
+}
+
+static void
+json_map_vma (const char *key, bfd_vma value)
+{
+  fprintf (json_map.file, ", \"%s\": %" PRIu64, key, (uint64_t) value);
+}
+
+/* Format and write the JSON map.  This runs on its own thread, so it
+   only reads what lang_map_json_start gathered and the fields of the
+   sections and BFDs that it points to, which no longer change.  */
+
+static void
+json_map_write (void *data ATTRIBUTE_UNUSED, size_t item ATTRIBUTE_UNUSED)
+{
+  FILE *f = json_map.file;
+  size_t o, i;
+
+  qsort (json_map.symbols, json_map.symbol_count, sizeof (*json_map.symbols),
+	 json_map_symbol_cmp);
+
+  fputs ("{\n\"output\": ", f);
+  json_map_string (bfd_get_filename (link_info.output_bfd));
+  fputs (",\n\"target\": ", f);
+  json_map_string (bfd_get_target (link_info.output_bfd));
+  fputs (",\n\"sections\": [", f);
+  for (o = 0; o < json_map.output_count; o++)
+    {
+      struct json_map_output *out = &json_map.outputs[o];
+
+      fputs (o == 0 ? "\n{\"name\": " : ",\n{\"name\": ", f);
+      json_map_string (out->section->name);
+      json_map_vma ("address", out->section->vma);
+      json_map_vma ("load_address", out->section->lma);
+      json_map_vma ("size", out->section->size);
+      fputs (", \"inputs\": [", f);
+
+      for (i = out->first_input; i < out->first_input + out->input_count; i++)
+	{
+	  struct json_map_input *in = &json_map.inputs[i];
+	  size_t lo, hi, s;
+
+	  fputs (i == out->first_input ? "\n  {\"file\": " : ",\n  {\"file\": ",
+		 f);
+	  json_map_file_name (in->section);
+	  fputs (", \"section\": ", f);
+	  json_map_string (in->section->name);
+	  json_map_vma ("address", in->addr);
+	  json_map_vma ("size", in->section->size);
+
+	  /* Find the symbols defined in this section.  */
+	  lo = 0;
+	  hi = json_map.symbol_count;
+	  while (lo < hi)
+	    {
+	      size_t mid = lo + (hi - lo) / 2;
+
+	      if (json_map.symbols[mid].section_id < in->section->id)
+		lo = mid + 1;
+	      else
+		hi = mid;
+	    }
+	  if (lo < json_map.symbol_count
+	      && json_map.symbols[lo].section_id == in->section->id)
+	    {
+	      fputs (", \"symbols\": [", f);
+	      for (s = lo;
+		   (s < json_map.symbol_count
+		    && json_map.symbols[s].section_id == in->section->id);
+		   s++)
+		{
+		  fputs (s == lo ? "{\"name\": " : ", {\"name\": ", f);
+		  json_map_string (json_map.symbols[s].name);
+		  json_map_vma ("address",
+				in->addr + json_map.symbols[s].value);
+		  putc ('}', f);
+		}
+	      putc (']', f);
+	    }
+	  putc ('}', f);
+	}
+      fputs ("]}", f);
+    }
+
+  fputs ("],\n\"discarded\": [", f);
+  for (i = 0; i < json_map.discarded_count; i++)
+    {
+      struct json_map_input *in = &json_map.discarded[i];
+
+      fputs (i == 0 ? "\n{\"file\": " : ",\n{\"file\": ", f);
+      json_map_file_name (in->section);
+      fputs (", \"section\": ", f);
+      json_map_string (in->section->name);
+      json_map_vma ("size", in->section->size);
+      putc ('}', f);
+    }
+  fputs ("]\n}\n", f);
+}
+
+/* Open the --map-json file and gather what goes in it, then start
+   writing it.  */
+
+void
+lang_map_json_start (void)
+{
+  unsigned int threads;
+
+  if (strcmp (config.map_json_filename, "-") == 0)
+    json_map.file = stdout;
+  else
+    {
+      json_map.file = fopen (config.map_json_filename, FOPEN_WT);
+      if (json_map.file == NULL)
+	{
+	  bfd_set_error (bfd_error_system_call);
+	  einfo (_("%F%P: cannot open map file %s: %E\n"),
+		 config.map_json_filename);
+	}
+      setvbuf (json_map.file, NULL, _IOFBF, MAP_FILE_BUFFER_SIZE);
+    }
+
+  json_map_gather (statement_list.head, NULL);
+  bfd_link_hash_traverse (link_info.hash, json_map_gather_symbol, NULL);
+
+  LANG_FOR_EACH_INPUT_STATEMENT (file)
+    {
+      asection *s;
+
+      if ((file->the_bfd->flags & (BFD_LINKER_CREATED | DYNAMIC)) != 0
+	  || file->flags.just_syms)
+	continue;
+
+      for (s = file->the_bfd->sections; s != NULL; s = s->next)
+	if ((s->output_section == NULL
+	     || s->output_section->owner != link_info.output_bfd)
+	    && (s->flags & (SEC_LINKER_CREATED | SEC_KEEP)) == 0)
+	  json_map_add_input (&json_map.discarded, &json_map.discarded_count,
+			      &json_map.discarded_alloc, s, 0);
+    }
+
+  /* Don't share stdout with the text map.  */
+  threads = link_info.threads > 1 && json_map.file != stdout ? 1 : 0;
+  json_map.work = bfd_parallel_start (threads, 1, json_map_write, NULL);
+}
+
+/* Wait for the --map-json file to be written, and close it.  */
+
+void
+lang_map_json_finish (void)
+{
+  bool failed;
+
+  bfd_parallel_finish (json_map.work);
+  json_map.work = NULL;
+
+  if (json_map.file == stdout)
+    failed = fflush (stdout) != 0;
+  else
+    failed = ferror (json_map.file) | fclose (json_map.file);
+  if (failed)
+    {
+      bfd_set_error (bfd_error_system_call);
+      einfo (_("%F%P: error writing map file %s: %E\n"),
+	     config.map_json_filename);
+    }
+
+  free (json_map.outputs);
+  free (json_map.inputs);
+  free (json_map.discarded);
+  free (json_map.symbols);
+}
+
 /* Initialize an output section.  */
 
 static void
@@ -3082,11 +3462,13 @@ load_symbols (lang_input_statement_type *entry,
 
 	      /* Potentially, the add_archive_element hook may have set a
 		 substitute BFD for us.  */
+	      time_trace_begin ("add symbols", subsbfd);
 	      if (!bfd_link_add_symbols (subsbfd, &link_info))
 		{
 		  einfo (_("%F%P: %pB: error adding symbols: %E\n"), member);
 		  loaded = false;
 		}
+	      time_trace_end ("add symbols");
 	    }
 
 	  entry->flags.loaded = loaded;
@@ -3095,10 +3477,12 @@ load_symbols (lang_input_statement_type *entry,
       break;
     }
 
+  time_trace_begin ("add symbols", entry->the_bfd);
   if (bfd_link_add_symbols (entry->the_bfd, &link_info))
     entry->flags.loaded = true;
   else
     einfo (_("%F%P: %pB: error adding symbols: %E\n"), entry->the_bfd);
+  time_trace_end ("add symbols");
 
   return entry->flags.loaded;
 }
@@ -4879,6 +5263,150 @@ ld_is_local_symbol (asymbol * sym)
   return false;
 }
 
+/* The local symbols of the output file printed by --print-map-locals,
+   sorted by section, address and then symbol table order.  */
+
+struct map_local_symbol
+{
+  asection *section;
+  bfd_vma addr;
+  long index;
+  asymbol *sym;
+};
+
+static asymbol **map_local_symtab;
+static struct map_local_symbol *map_locals;
+static long map_local_count = -1;
+
+static int
+map_local_symbol_cmp (const void *a, const void *b)
+{
+  const struct map_local_symbol *l = (const struct map_local_symbol *) a;
+  const struct map_local_symbol *r = (const struct map_local_symbol *) b;
+
+  if (l->section->index != r->section->index)
+    return l->section->index < r->section->index ? -1 : 1;
+  if (l->addr != r->addr)
+    return l->addr < r->addr ? -1 : 1;
+  if (l->index != r->index)
+    return l->index < r->index ? -1 : 1;
+  return 0;
+}
+
+static int
+map_local_symbol_index_cmp (const void *a, const void *b)
+{
+  const struct map_local_symbol *l = *(const struct map_local_symbol **) a;
+  const struct map_local_symbol *r = *(const struct map_local_symbol **) b;
+
+  return l->index < r->index ? -1 : l->index > r->index;
+}
+
+/* Read the symbol table of the output file once, keeping the local
+   symbols that the map shows.  */
+
+static void
+init_map_locals (void)
+{
+  long storage_needed, number_of_symbols, j;
+
+  map_local_count = 0;
+
+  /* FIXME: This call is not working for non-ELF based targets.
+     Find out why.  */
+  storage_needed = bfd_get_symtab_upper_bound (link_info.output_bfd);
+  if (storage_needed <= 0)
+    return;
+
+  map_local_symtab = xmalloc (storage_needed);
+  number_of_symbols = bfd_canonicalize_symtab (link_info.output_bfd,
+					       map_local_symtab);
+  if (number_of_symbols <= 0)
+    return;
+
+  map_locals = xmalloc (number_of_symbols * sizeof (*map_locals));
+  for (j = 0; j < number_of_symbols; j++)
+    {
+      asymbol *sym = map_local_symtab[j];
+
+      if ((sym->flags & BSF_LOCAL) != 0
+	  && sym->section->owner == link_info.output_bfd
+	  && ld_is_local_symbol (sym))
+	{
+	  struct map_local_symbol *l = &map_locals[map_local_count++];
+
+	  l->section = sym->section;
+	  l->addr = sym->value + sym->section->vma;
+	  l->index = j;
+	  l->sym = sym;
+	}
+    }
+  qsort (map_locals, map_local_count, sizeof (*map_locals),
+	 map_local_symbol_cmp);
+}
+
+static void
+free_map_locals (void)
+{
+  free (map_locals);
+  free (map_local_symtab);
+  map_locals = NULL;
+  map_local_symtab = NULL;
+  map_local_count = -1;
+}
+
+/* Print the local symbols of output section SEC with addresses from
+   START up to END, in symbol table order.  */
+
+static void
+print_local_symbols (asection *sec, bfd_vma start, bfd_vma end)
+{
+  struct map_local_symbol key, **found;
+  size_t lo, hi, n, j;
+
+  if (map_local_count < 0)
+    init_map_locals ();
+
+  /* Find the first symbol in SEC at or after START.  */
+  key.section = sec;
+  key.addr = start;
+  key.index = -1;
+  lo = 0;
+  hi = map_local_count;
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if (map_local_symbol_cmp (&map_locals[mid], &key) < 0)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  for (hi = lo;
+       (hi < (size_t) map_local_count
+	&& map_locals[hi].section == sec
+	&& map_locals[hi].addr < end);
+       hi++)
+    ;
+  n = hi - lo;
+  if (n == 0)
+    return;
+
+  found = xmalloc (n * sizeof (*found));
+  for (j = 0; j < n; j++)
+    found[j] = &map_locals[lo + j];
+  qsort (found, n, sizeof (*found), map_local_symbol_index_cmp);
+
+  for (j = 0; j < n; j++)
+    {
+      print_spaces (SECTION_NAME_MAP_LENGTH);
+      minfo ("0x%V        (local) %s\n", found[j]->addr,
+	     bfd_asymbol_name (found[j]->sym));
+    }
+  free (found);
+}
+
 /* Print information about an input section to the map file.  */
 
 static void
@@ -4936,42 +5464,7 @@ print_input_section (asection *i, bool is_discarded)
 	print_dot = addr + TO_ADDR (size);
 
       if (config.print_map_locals)
-	{
-	  long  storage_needed;
-
-	  /* FIXME: It would be better to cache this table, rather
-	     than recreating it for each output section.  */
-	  /* FIXME: This call is not working for non-ELF based targets.
-	     Find out why.  */
-	  storage_needed = bfd_get_symtab_upper_bound (link_info.output_bfd);
-	  if (storage_needed > 0)
-	    {
-	      asymbol **  symbol_table;
-	      long        number_of_symbols;
-	      long        j;
-
-	      symbol_table = xmalloc (storage_needed);
-	      number_of_symbols = bfd_canonicalize_symtab (link_info.output_bfd, symbol_table);
-
-	      for (j = 0; j < number_of_symbols; j++)
-		{
-		  asymbol *     sym = symbol_table[j];
-		  bfd_vma       sym_addr = sym->value + i->output_section->vma;
-		  
-		  if (sym->section == i->output_section
-		      && (sym->flags & BSF_LOCAL) != 0
-		      && sym_addr >= addr
-		      && sym_addr < print_dot
-		      && ld_is_local_symbol (sym))
-		    {
-		      print_spaces (SECTION_NAME_MAP_LENGTH);
-		      minfo ("0x%V        (local) %s\n", sym_addr, bfd_asymbol_name (sym));
-		    }
-		}
-
-	      free (symbol_table);
-	    }
-	}
+	print_local_symbols (i->output_section, addr, print_dot);
     }
 }
 
@@ -7782,6 +8275,20 @@ lang_find_relro_sections (void)
     link_info.relro = false;
 }
 
+/* Return the total size of the output sections, for the relaxation
+   statistics printed by --stats.  */
+
+static bfd_size_type
+output_sections_size (void)
+{
+  bfd_size_type size = 0;
+  asection *s;
+
+  for (s = link_info.output_bfd->sections; s != NULL; s = s->next)
+    size += s->size;
+  return size;
+}
+
 /* Relax all sections until bfd_relax_section gives up.  */
 
 void
@@ -7800,6 +8307,15 @@ lang_relax_sections (bool need_layout)
 	{
 	  /* Keep relaxing until bfd_relax_section gives up.  */
 	  bool relax_again;
+	  long start_time = 0;
+	  bfd_size_type start_size = 0;
+
+	  time_trace_begin ("relax pass", NULL);
+	  if (config.stats)
+	    {
+	      start_time = get_run_time ();
+	      start_size = output_sections_size ();
+	    }
 
 	  link_info.relax_trip = -1;
 	  do
@@ -7825,6 +8341,24 @@ lang_relax_sections (bool need_layout)
 	    }
 	  while (relax_again);
 
+	  if (config.stats)
+	    {
+	      long run_time = get_run_time () - start_time;
+	      bfd_size_type end_size = output_sections_size ();
+
+	      fprintf (stderr, _("%s: relaxation pass %d: %d trips,"
+				 " %ld.%06ld seconds,"
+				 " output sections %s%" PRIu64 " bytes\n"),
+		       program_name, link_info.relax_pass,
+		       link_info.relax_trip + 1,
+		       run_time / 1000000, run_time % 1000000,
+		       end_size > start_size ? "+" : "-",
+		       (uint64_t) (end_size > start_size
+				   ? end_size - start_size
+				   : start_size - end_size));
+	    }
+	  time_trace_end ("relax pass");
+
 	  link_info.relax_pass++;
 	}
       need_layout = true;
@@ -8110,7 +8644,9 @@ lang_process (void)
   /* Create a bfd for each input file.  */
   current_target = default_target;
   lang_statement_iteration++;
+  time_trace_begin ("open inputs", NULL);
   open_input_bfds (statement_list.head, NULL, OPEN_BFD_NORMAL);
+  time_trace_end ("open inputs");
 
   /* Now that open_input_bfds has processed assignments and provide
      statements we can give values to symbolic origin/length now.  */
@@ -8134,9 +8670,11 @@ lang_process (void)
       /* We need to manipulate all three chains in synchrony.  */
       files = file_chain;
       inputfiles = input_file_chain;
+      time_trace_begin ("plugin all symbols read", NULL);
       if (plugin_call_all_symbols_read ())
 	einfo (_("%F%P: %s: plugin reported error after all symbols read\n"),
 	       plugin_error_plugin ());
+      time_trace_end ("plugin all symbols read");
       link_info.lto_all_symbols_read = true;
       /* Open any newly added files, updating the file chains.  */
       plugin_undefs = link_info.hash->undefs_tail;
@@ -8145,7 +8683,9 @@ lang_process (void)
 	last_os = ((lang_output_section_statement_type *)
 		   ((char *) lang_os_list.tail
 		    - offsetof (lang_output_section_statement_type, next)));
+      time_trace_begin ("open plugin inputs", NULL);
       open_input_bfds (*added.tail, last_os, OPEN_BFD_NORMAL);
+      time_trace_end ("open plugin inputs");
       if (plugin_undefs == link_info.hash->undefs_tail)
 	plugin_undefs = NULL;
       /* Restore the global list pointer now they have all been added.  */
@@ -8255,7 +8795,9 @@ lang_process (void)
   lang_add_gc_name (link_info.init_function);
   lang_add_gc_name (link_info.fini_function);
 
+  time_trace_begin ("after open", NULL);
   ldemul_after_open ();
+  time_trace_end ("after open");
   if (config.map_file != NULL)
     lang_print_asneeded ();
 
@@ -8294,14 +8836,18 @@ lang_process (void)
   resolve_wilds ();
 
   /* Remove unreferenced sections if asked to.  */
+  time_trace_begin ("gc sections", NULL);
   lang_gc_sections ();
+  time_trace_end ("gc sections");
 
   lang_mark_undefineds ();
 
   /* Check relocations.  */
+  time_trace_begin ("check relocs", NULL);
   lang_check_relocs ();
 
   ldemul_after_check_relocs ();
+  time_trace_end ("check relocs");
 
   /* There might have been new sections created (e.g. as result of
      checking relocs to need a .got, or suchlike), so to properly order
@@ -8316,6 +8862,7 @@ lang_process (void)
 
   /* Run through the contours of the script and attach input sections
      to the correct output sections.  */
+  time_trace_begin ("map sections", NULL);
   lang_statement_iteration++;
   map_input_to_output_sections (statement_list.head, NULL, NULL);
 
@@ -8327,6 +8874,7 @@ lang_process (void)
 
   /* Find any sections not attached explicitly and handle them.  */
   lang_place_orphans ();
+  time_trace_end ("map sections");
 
   if (!bfd_link_relocatable (&link_info))
     {
@@ -8336,7 +8884,9 @@ lang_process (void)
 	 sections, so that GCed sections are not merged, but before
 	 assigning dynamic symbols, since removing whole input sections
 	 is hard then.  */
+      time_trace_begin ("merge sections", NULL);
       bfd_merge_sections (link_info.output_bfd, &link_info);
+      time_trace_end ("merge sections");
 
       /* Look for a text section and set the readonly attribute in it.  */
       found = bfd_get_section_by_name (link_info.output_bfd, ".text");
@@ -8374,7 +8924,9 @@ lang_process (void)
 
   /* Do anything special before sizing sections.  This is where ELF
      and other back-ends size dynamic sections.  */
+  time_trace_begin ("size dynamic sections", NULL);
   ldemul_before_allocation ();
+  time_trace_end ("size dynamic sections");
 
   /* We must record the program headers before we try to fix the
      section positions, since they will affect SIZEOF_HEADERS.  */
@@ -8385,11 +8937,15 @@ lang_process (void)
     lang_find_relro_sections ();
 
   /* Size up the sections.  */
+  time_trace_begin ("size sections", NULL);
   lang_size_sections (NULL, !RELAXATION_ENABLED);
+  time_trace_end ("size sections");
 
   /* See if anything special should be done now we know how big
      everything is.  This is where relaxation is done.  */
+  time_trace_begin ("relax", NULL);
   ldemul_after_allocation ();
+  time_trace_end ("relax");
 
   /* Fix any __start, __stop, .startof. or .sizeof. symbols.  */
   lang_finalize_start_stop ();
@@ -8487,6 +9043,9 @@ lang_add_wild (struct wildcard_spec *filespec,
     }
   new_stmt->section_list = section_list;
   new_stmt->keep_sections = keep_sections;
+  new_stmt->file_visit = 0;
+  new_stmt->section_visit = 0;
+  new_stmt->file_match = false;
   lang_list_init (&new_stmt->children);
   lang_list_init (&new_stmt->matching_sections);
   analyze_walk_wild_section_handler (new_stmt);
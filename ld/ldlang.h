@@ -402,6 +402,12 @@ struct lang_wild_statement_struct
 
   lang_section_bst_type *tree, **rightmost;
   struct flag_info *section_flag_list;
+
+  /* Used by resolve_wild_sections to match the file name only once per
+     input file, and to process the statement only once per section.  */
+  unsigned long file_visit;
+  unsigned long section_visit;
+  bool file_match;
 };
 
 typedef struct lang_address_statement_struct
@@ -555,6 +561,10 @@ extern void lang_memory_region_alias
   (const char *, const char *);
 extern void lang_map
   (void);
+extern void lang_map_json_start
+  (void);
+extern void lang_map_json_finish
+  (void);
 extern void lang_set_flags
   (lang_memory_region_type *, const char *, int);
 extern void lang_add_output
@@ -63,6 +63,7 @@ enum option_values
   OPTION_SORT_COMMON,
   OPTION_SORT_SECTION,
   OPTION_STATS,
+  OPTION_TIME_TRACE,
   OPTION_SYMBOLIC,
   OPTION_SYMBOLIC_FUNCTIONS,
   OPTION_TASK_LINK,
@@ -143,6 +144,8 @@ enum option_values
   OPTION_WARN_ALTERNATE_EM,
   OPTION_REDUCE_MEMORY_OVERHEADS,
   OPTION_MAX_CACHE_SIZE,
+  OPTION_THREADS,
+  OPTION_NO_THREADS,
 #if BFD_SUPPORTS_PLUGINS
   OPTION_PLUGIN,
   OPTION_PLUGIN_OPT,
@@ -162,6 +165,7 @@ enum option_values
   OPTION_NO_PRINT_MAP_DISCARDED,
   OPTION_PRINT_MAP_LOCALS,
   OPTION_NO_PRINT_MAP_LOCALS,
+  OPTION_MAP_JSON,
   OPTION_NON_CONTIGUOUS_REGIONS,
   OPTION_NON_CONTIGUOUS_REGIONS_WARNINGS,
   OPTION_DEPENDENCY_FILE,
@@ -51,6 +51,13 @@
 
 #include <string.h>
 
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
 #ifndef TARGET_SYSTEM_ROOT
 #define TARGET_SYSTEM_ROOT ""
 #endif
@@ -132,6 +139,7 @@ static void unattached_reloc
 static bool notice
   (struct bfd_link_info *, struct bfd_link_hash_entry *,
    struct bfd_link_hash_entry *, bfd *, asection *, bfd_vma, flagword);
+static void time_trace_phase (const char *, bfd *, bool);
 
 static struct bfd_link_callbacks link_callbacks =
 {
@@ -153,7 +161,8 @@ static struct bfd_link_callbacks link_callbacks =
   ldlang_ctf_acquire_strings,
   NULL,
   ldlang_ctf_new_dynsym,
-  ldlang_write_ctf_late
+  ldlang_write_ctf_late,
+  time_trace_phase
 };
 
 static bfd_assert_handler_type default_bfd_assert_handler;
@@ -208,9 +217,163 @@ write_dependency_file (void)
   fclose (out);
 }
 
+/* The --time-trace file is written in the Chrome trace event format,
+   as a "B" event at the start of each phase of the link and an "E"
+   event at the end, which also records the CPU time and the peak
+   memory use so far.  Phases may nest.  */
+
+static FILE *time_trace_file;
+static bool time_trace_first;
+static double time_trace_base;
+
+/* The phases that have begun but not yet ended, innermost last, so
+   that a link which fails part way through can still end them.  */
+static const char **time_trace_open;
+static unsigned int time_trace_depth;
+static unsigned int time_trace_alloc;
+
+/* Return the wall clock time in microseconds.  */
+
+static double
+time_trace_now (void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec * 1e6 + tv.tv_usec;
+#else
+  return get_run_time ();
+#endif
+}
+
+static void
+time_trace_event (const char *phase, bfd *abfd, char type)
+{
+  FILE *f = time_trace_file;
+
+  fprintf (f, "%s\n{\"name\": ", time_trace_first ? "" : ",");
+  time_trace_first = false;
+  print_json_string (f, phase);
+  fprintf (f, ", \"cat\": \"ld\", \"ph\": \"%c\", \"pid\": 1, \"tid\": 1,"
+	   " \"ts\": %.0f", type, time_trace_now () - time_trace_base);
+  if (type == 'B')
+    {
+      if (abfd != NULL)
+	{
+	  fputs (", \"args\": {\"file\": ", f);
+	  if (abfd->my_archive != NULL
+	      && !bfd_is_thin_archive (abfd->my_archive))
+	    {
+	      char *name = concat (bfd_get_filename (abfd->my_archive), "(",
+				   bfd_get_filename (abfd), ")", NULL);
+	      print_json_string (f, name);
+	      free (name);
+	    }
+	  else
+	    print_json_string (f, bfd_get_filename (abfd));
+	  putc ('}', f);
+	}
+    }
+  else
+    {
+      fprintf (f, ", \"args\": {\"cpu_us\": %ld", get_run_time ());
+#ifdef HAVE_GETRUSAGE
+      struct rusage usage;
+
+      /* ru_maxrss is in kilobytes on GNU/Linux and the BSDs.  */
+      if (getrusage (RUSAGE_SELF, &usage) == 0)
+	fprintf (f, ", \"max_rss_kb\": %ld", (long) usage.ru_maxrss);
+#endif
+      putc ('}', f);
+    }
+  putc ('}', f);
+}
+
+/* Note the start of phase PHASE of the link, working on ABFD if not
+   NULL.  */
+
+void
+time_trace_begin (const char *phase, bfd *abfd)
+{
+  if (time_trace_file != NULL)
+    {
+      if (time_trace_depth == time_trace_alloc)
+	{
+	  time_trace_alloc = time_trace_alloc * 2 + 8;
+	  time_trace_open = xrealloc (time_trace_open,
+				      time_trace_alloc * sizeof (char *));
+	}
+      time_trace_open[time_trace_depth++] = phase;
+      time_trace_event (phase, abfd, 'B');
+    }
+}
+
+/* Note the end of phase PHASE of the link.  */
+
+void
+time_trace_end (const char *phase)
+{
+  if (time_trace_file != NULL && time_trace_depth != 0)
+    {
+      time_trace_depth--;
+      time_trace_event (phase, NULL, 'E');
+    }
+}
+
+/* The trace_phase callback, for the phases of the link run by BFD.  */
+
+static void
+time_trace_phase (const char *phase, bfd *abfd, bool start)
+{
+  if (start)
+    time_trace_begin (phase, abfd);
+  else
+    time_trace_end (phase);
+}
+
+static void
+time_trace_start (void)
+{
+  time_trace_file = fopen (config.time_trace_filename, FOPEN_WT);
+  if (time_trace_file == NULL)
+    {
+      bfd_set_error (bfd_error_system_call);
+      einfo (_("%F%P: cannot open time trace file %s: %E\n"),
+	     config.time_trace_filename);
+    }
+  time_trace_first = true;
+  time_trace_base = time_trace_now ();
+  fputs ("{\"traceEvents\": [", time_trace_file);
+  time_trace_begin ("link", NULL);
+}
+
+/* Finish the trace file, ending any phases still open.  This is
+   called from ld_cleanup, so that a failed link still leaves a valid
+   trace of the phases that ran.  */
+
+static void
+time_trace_finish (void)
+{
+  FILE *f = time_trace_file;
+
+  if (f == NULL)
+    return;
+  while (time_trace_depth != 0)
+    time_trace_end (time_trace_open[time_trace_depth - 1]);
+  free (time_trace_open);
+  time_trace_open = NULL;
+  time_trace_file = NULL;
+  fputs ("\n]}\n", f);
+  if (fclose (f) != 0)
+    einfo (_("%P: error closing file `%s'\n"), config.time_trace_filename);
+}
+
 static void
 ld_cleanup (void)
 {
+  time_trace_finish ();
+
   bfd *ibfd, *inext;
   if (link_info.output_bfd)
     bfd_close_all_done (link_info.output_bfd);
@@ -374,16 +537,25 @@ main (int argc, char **argv)
   lang_has_input_file = false;
   parse_args (argc, argv);
 
+  if (config.time_trace_filename != NULL)
+    time_trace_start ();
+
   if (config.hash_table_size != 0)
     bfd_hash_set_default_size (config.hash_table_size);
 
+  bfd_set_compression_threads (link_info.threads > 1 ? link_info.threads : 1);
+
 #if BFD_SUPPORTS_PLUGINS
   /* Now all the plugin arguments have been gathered, we can load them.  */
+  time_trace_begin ("load plugins", NULL);
   plugin_load_plugins ();
+  time_trace_end ("load plugins");
 #endif /* BFD_SUPPORTS_PLUGINS */
 
   ldemul_set_symbols ();
 
+  time_trace_begin ("parse scripts", NULL);
+
   /* If we have not already opened and parsed a linker script,
      try the default script from command line first.  */
   if (saved_script_handle == NULL
@@ -412,6 +584,7 @@ main (int argc, char **argv)
       yyparse ();
       lex_string = NULL;
     }
+  time_trace_end ("parse scripts");
 
   if (verbose)
     {
@@ -494,6 +667,7 @@ main (int argc, char **argv)
 	      einfo (_("%F%P: cannot open map file %s: %E\n"),
 		     config.map_filename);
 	    }
+	  setvbuf (config.map_file, NULL, _IOFBF, MAP_FILE_BUFFER_SIZE);
 	}
       link_info.has_map_file = true;
     }
@@ -525,12 +699,20 @@ main (int argc, char **argv)
   link_info.output_bfd->flags
     |= flags & bfd_applicable_file_flags (link_info.output_bfd);
 
+  time_trace_begin ("write", NULL);
   ldwrite ();
+  time_trace_end ("write");
 
+  time_trace_begin ("write map", NULL);
+  if (config.map_json_filename != NULL)
+    lang_map_json_start ();
   if (config.map_file != NULL)
     lang_map ();
   if (command_line.cref)
     output_cref (config.map_file != NULL ? config.map_file : stdout);
+  if (config.map_json_filename != NULL)
+    lang_map_json_finish ();
+  time_trace_end ("write map");
   if (nocrossref_list != NULL)
     check_nocrossrefs ();
   if (command_line.print_memory_usage)
@@ -565,8 +747,10 @@ main (int argc, char **argv)
     {
       bfd *obfd = link_info.output_bfd;
       link_info.output_bfd = NULL;
+      time_trace_begin ("close output", NULL);
       if (!bfd_close (obfd))
 	einfo (_("%F%P: %s: final close failed: %E\n"), output_filename);
+      time_trace_end ("close output");
 
       /* If the --force-exe-suffix is enabled, and we're making an
 	 executable file and it doesn't end in .exe, copy it to one
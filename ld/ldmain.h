@@ -62,5 +62,7 @@ extern void add_wrap (const char *);
 extern void add_ignoresym (struct bfd_link_info *, const char *);
 extern void add_keepsyms_file (const char *);
 extern void track_dependency_files (const char *);
+extern void time_trace_begin (const char *, bfd *);
+extern void time_trace_end (const char *);
 
 #endif
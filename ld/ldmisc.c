@@ -680,6 +680,31 @@ print_nl (void)
   fprintf (config.map_file, "\n");
 }
 
+/* Write S to F as a JSON string.  */
+
+void
+print_json_string (FILE *f, const char *s)
+{
+  const char *p;
+
+  putc ('"', f);
+  for (p = s; *p != 0; p++)
+    {
+      unsigned char c = *p;
+
+      if (c == '"' || c == '\\')
+	{
+	  putc ('\\', f);
+	  putc (c, f);
+	}
+      else if (c < 0x20)
+	fprintf (f, "\\u%04x", c);
+      else
+	putc (c, f);
+    }
+  putc ('"', f);
+}
+
 /* A more or less friendly abort message.  In ld.h abort is defined to
    call this function.  */
 
@@ -37,5 +37,6 @@ do { info_assert(__FILE__,__LINE__); } while (0)
 extern void print_spaces (int);
 #define print_space() print_spaces (1)
 extern void print_nl (void);
+extern void print_json_string (FILE *, const char *);
 
 #endif
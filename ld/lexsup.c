@@ -453,6 +453,11 @@ static const struct ld_option ld_options[] =
     OPTION_MAX_CACHE_SIZE},
     '\0', NULL, N_("Set the maximum cache size to SIZE bytes"),
     TWO_DASHES },
+  { {"threads", optional_argument, NULL, OPTION_THREADS},
+    '\0', N_("[=COUNT]"),
+    N_("Use up to COUNT threads [one per processor]"), TWO_DASHES },
+  { {"no-threads", no_argument, NULL, OPTION_NO_THREADS},
+    '\0', NULL, N_("Do not use threads (default)"), TWO_DASHES },
   { {"relax", no_argument, NULL, OPTION_RELAX},
     '\0', NULL, N_("Reduce code size by using target specific optimizations"), TWO_DASHES },
   { {"no-relax", no_argument, NULL, OPTION_NO_RELAX},
@@ -495,6 +500,9 @@ static const struct ld_option ld_options[] =
     TWO_DASHES },
   { {"stats", no_argument, NULL, OPTION_STATS},
     '\0', NULL, N_("Print memory usage statistics"), TWO_DASHES },
+  { {"time-trace", required_argument, NULL, OPTION_TIME_TRACE},
+    '\0', N_("FILE"), N_("Write the time and memory use of each link phase"
+			  " to FILE"), TWO_DASHES },
   { {"target-help", no_argument, NULL, OPTION_TARGET_HELP},
     '\0', NULL, N_("Display target specific options"), TWO_DASHES },
   { {"task-link", required_argument, NULL, OPTION_TASK_LINK},
@@ -617,6 +625,9 @@ static const struct ld_option ld_options[] =
   { {"no-print-map-locals", no_argument, NULL, OPTION_NO_PRINT_MAP_LOCALS},
     '\0', NULL, N_("Do not show local symbols in map file output (default)"),
     TWO_DASHES },
+  { {"map-json", required_argument, NULL, OPTION_MAP_JSON},
+    '\0', N_("FILE"), N_("Write a linker map in JSON format to FILE"),
+    TWO_DASHES },
   { {"ctf-variables", no_argument, NULL, OPTION_CTF_VARIABLES},
     '\0', NULL, N_("Emit names and types of static variables in CTF"),
     TWO_DASHES },
@@ -1366,6 +1377,9 @@ parse_args (unsigned argc, char **argv)
 	case OPTION_STATS:
 	  config.stats = true;
 	  break;
+	case OPTION_TIME_TRACE:
+	  config.time_trace_filename = optarg;
+	  break;
 	case OPTION_NO_SYMBOLIC:
 	  opt_symbolic = symbolic_unset;
 	  break;
@@ -1726,6 +1740,29 @@ parse_args (unsigned argc, char **argv)
 	  }
 	  break;
 
+	case OPTION_THREADS:
+	  if (optarg != NULL)
+	    {
+	      char *end;
+	      unsigned long count = strtoul (optarg, &end, 0);
+	      if (*end != '\0' || count == 0 || count != (unsigned int) count)
+		einfo (_("%F%P: invalid thread count: %s\n"), optarg);
+	      link_info.threads = count;
+	    }
+	  else
+	    {
+	      long count = 0;
+#ifdef _SC_NPROCESSORS_ONLN
+	      count = sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+	      link_info.threads = count > 1 ? count : 1;
+	    }
+	  break;
+
+	case OPTION_NO_THREADS:
+	  link_info.threads = 1;
+	  break;
+
 	case OPTION_HASH_SIZE:
 	  {
 	    bfd_size_type new_size;
@@ -1789,6 +1826,10 @@ parse_args (unsigned argc, char **argv)
 	  config.print_map_locals = true;
 	  break;
 
+	case OPTION_MAP_JSON:
+	  config.map_json_filename = optarg;
+	  break;
+
 	case OPTION_DEPENDENCY_FILE:
 	  config.dependency_file = optarg;
 	  break;
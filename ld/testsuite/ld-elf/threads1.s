@@ -0,0 +1,14 @@
+	.text
+	.global _start
+_start:
+	.nop
+	.align 4
+	.dc.a func2
+	.dc.a func3
+
+	.data
+	.global data1
+data1:
+	.dc.a data2
+	.dc.a data3
+	.dc.a _start
@@ -0,0 +1,14 @@
+	.text
+	.global func2
+func2:
+	.nop
+	.align 4
+	.dc.a func3
+	.dc.a data1
+
+	.data
+	.global data2
+data2:
+	.dc.a data3
+	.dc.a func2
+	.byte 2
@@ -0,0 +1,14 @@
+	.text
+	.global func3
+func3:
+	.nop
+	.align 4
+	.dc.a func2
+	.dc.a data1
+
+	.data
+	.global data3
+data3:
+	.dc.a data2
+	.dc.a func3
+	.byte 3
@@ -0,0 +1,18 @@
+	.text
+	.globl	text_start
+text_start:
+	.space	16
+local_text:
+	.globl	text_end
+text_end:
+	.space	4
+
+	.data
+	.globl	data_sym
+data_sym:
+	.space	8
+
+	.section .discard_me,"a"
+	.globl	discarded_sym
+discarded_sym:
+	.space	4
@@ -0,0 +1,8 @@
+SECTIONS
+{
+  . = 0x10000;
+  .text : { *(.text) }
+  . = 0x20000;
+  .data : { *(.data) }
+  /DISCARD/ : { *(.discard_me) }
+}
@@ -0,0 +1,15 @@
+	.text
+first_local:
+	.space	4
+	.globl	second_global
+second_global:
+second_local:
+third_local:
+	.space	4
+fourth_local:
+	.space	4
+
+	.data
+	.space	4
+data_local:
+	.space	4
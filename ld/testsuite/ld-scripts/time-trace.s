@@ -0,0 +1,9 @@
+	.text
+	.globl	_start
+_start:
+	.space	16
+
+	.data
+	.globl	data_sym
+data_sym:
+	.space	8